@@ -0,0 +1,104 @@
+/*
+ * Substring search benchmark.
+ *
+ * Compares mrbc_string_search() used by String#index, include? and
+ * split, with the byte-by-byte memcmp() loop that was used before.
+ * The pattern is placed at the end of the text, so both scan the whole
+ * text. The results of both are checked to be the same.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mrubyc.h"
+
+#define MIN_BYTES (64 * 1024 * 1024)	// bytes scanned per measurement
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+// the former String#index.
+static int search_bytewise(const uint8_t *s, int len, const uint8_t *p, int plen)
+{
+  int try_cnt = len - plen;
+  const uint8_t *p1 = s;
+
+  while( try_cnt >= 0 ) {
+    if( memcmp( p1, p, plen ) == 0 ) return p1 - s;
+    try_cnt--;
+    p1++;
+  }
+  return -1;
+}
+
+
+// English-like text of lowercase words.
+static void make_text(uint8_t *s, int len, unsigned int seed)
+{
+  for( int i = 0; i < len; i++ ) {
+    seed = seed * 1103515245 + 12345;
+    int r = (seed >> 16) % 32;
+    s[i] = (r < 5) ? ' ' : 'a' + r % 26;
+  }
+}
+
+
+static double measure(int (*func)(const uint8_t *, int, const uint8_t *, int),
+                      const uint8_t *s, int len, const uint8_t *p, int plen,
+                      int *result)
+{
+  int repeat = MIN_BYTES / len + 1;
+  double t0 = now_sec();
+  for( int i = 0; i < repeat; i++ ) {
+    *result = func( s, len, p, plen );
+  }
+  double elapsed = now_sec() - t0;
+
+  return (double)len * repeat / elapsed / 1e6;
+}
+
+
+static int search_kernel(const uint8_t *s, int len, const uint8_t *p, int plen)
+{
+  return mrbc_string_search( s, len, p, plen );
+}
+
+
+int main(void)
+{
+  static const int text_sizes[] = { 1024, 16*1024, 256*1024, 1024*1024 };
+  static const int pattern_sizes[] = { 1, 4, 16, 64 };
+  int ret = 0;
+
+  printf("%8s %8s %14s %14s\n", "text", "pattern", "bytewise MB/s", "search MB/s");
+
+  for( int i = 0; i < sizeof(text_sizes)/sizeof(int); i++ ) {
+    int len = text_sizes[i];
+    uint8_t *s = malloc( len );
+    make_text( s, len, len );
+
+    for( int j = 0; j < sizeof(pattern_sizes)/sizeof(int); j++ ) {
+      int plen = pattern_sizes[j];
+      uint8_t *p = s + len - plen;
+      make_text( p, plen, plen );
+      p[plen-1] = 'A';			// unique at the end of the text.
+
+      int r1 = -1, r2 = -1;
+      double mb1 = measure( search_bytewise, s, len, p, plen, &r1 );
+      double mb2 = measure( search_kernel, s, len, p, plen, &r2 );
+
+      printf("%8d %8d %14.0f %14.0f%s\n", len, plen, mb1, mb2,
+             (r1 == r2) ? "" : "  MISMATCH");
+      if( r1 != r2 ) ret = 1;
+    }
+    free( s );
+  }
+
+  return ret;
+}
@@ -0,0 +1,93 @@
+/*
+ * VM benchmark runner.
+ *
+ * Executes ONE mruby/c program with rrt0 scheduler and reports the
+ * elapsed time. If libmrubyc was built with MRBC_COUNT_INSTRUCTIONS,
+ * the number of executed instructions and instructions per second are
+ * reported too.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mrubyc.h"
+
+#if !defined(MRBC_MEMORY_SIZE)
+#define MRBC_MEMORY_SIZE (1024*256)
+#endif
+static uint8_t memory_pool[MRBC_MEMORY_SIZE];
+
+uint8_t * load_mrb_file(const char *filename)
+{
+  FILE *fp = fopen(filename, "rb");
+
+  if( fp == NULL ) {
+    fprintf(stderr, "File not found (%s)\n", filename);
+    return NULL;
+  }
+
+  // get filesize
+  fseek(fp, 0, SEEK_END);
+  size_t size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+
+  // allocate memory
+  uint8_t *p = malloc(size);
+  if( p != NULL ) {
+    if( fread(p, sizeof(uint8_t), size, fp) != size ) {
+      fprintf(stderr, "File read error (%s)\n", filename);
+      free(p);
+      p = NULL;
+    }
+  } else {
+    fprintf(stderr, "Memory allocate error.\n");
+  }
+  fclose(fp);
+
+  return p;
+}
+
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+int main(int argc, char *argv[])
+{
+  if( argc != 2 ) {
+    printf("Usage: %s <xxxx.mrb>\n", argv[0]);
+    return 1;
+  }
+
+  uint8_t *mrbbuf = load_mrb_file( argv[1] );
+  if( mrbbuf == 0 ) return 1;
+
+  mrbc_init(memory_pool, MRBC_MEMORY_SIZE);
+  mrbc_tcb *tcb = mrbc_create_task(mrbbuf, NULL);
+  if( !tcb ) {
+    free(mrbbuf);
+    return 1;
+  }
+
+  double t0 = now_sec();
+  int ret = mrbc_run();
+  double elapsed = now_sec() - t0;
+
+  printf("%-24s %8.3f sec", argv[1], elapsed);
+#if defined(MRBC_COUNT_INSTRUCTIONS)
+  uint64_t n = tcb->vm.inst_count;
+  printf("  %12llu insts  %8.2f M insts/sec",
+         (unsigned long long)n, n / elapsed / 1e6);
+#endif
+#if MRBC_USE_PREDECODE
+  printf("  %6lu bytes pre-decoded", (unsigned long)tcb->vm.predecode_size);
+#endif
+  printf("\n");
+
+  free(mrbbuf);
+  return ret == 1 ? 0 : ret;
+}
@@ -0,0 +1,21 @@
+#
+# Constant references from a nested class.
+#
+module Config
+  SCALE = 3
+  class Point
+    OFFSET = 1
+    def calc(v)
+      v * SCALE + OFFSET + Config::SCALE
+    end
+  end
+end
+
+pt = Config::Point.new
+i = 0
+sum = 0
+while i < 1_000_000
+  sum += pt.calc(i & 7)
+  i += 1
+end
+puts sum
@@ -0,0 +1,20 @@
+#
+# Iterators with a block. (Array, Range, Hash and String)
+#
+a = []
+i = 0
+while i < 1000
+  a << i
+  i += 1
+end
+
+h = {}
+100.times { |k| h[k] = k }
+str = "abcdefghij" * 10
+
+sum = 0
+1000.times { a.each { |x| sum += x } }
+(1..200000).each { |x| sum += x }
+3000.times { h.each { |k, v| sum += v } }
+2000.times { str.each_char { |c| sum += 1 } }
+puts sum
@@ -0,0 +1,20 @@
+#
+# Array methods with a block. (select, map, inject and others)
+#
+a = []
+i = 0
+while i < 1000
+  a << i
+  i += 1
+end
+
+sum = 0
+300.times {
+  sum += a.select { |x| x % 3 == 0 }.size
+  sum += a.map { |x| x * 2 }.size
+  sum += a.inject { |s, x| s + x }
+  sum += a.count { |x| x > 500 }
+  sum += 1 if a.all? { |x| x >= 0 }
+  sum += a.index { |x| x == 999 }
+}
+puts sum
@@ -0,0 +1,12 @@
+#
+# Recursive method calls.
+#
+def fib(n)
+  if n < 2
+    n
+  else
+    fib(n - 1) + fib(n - 2)
+  end
+end
+
+puts fib(30)
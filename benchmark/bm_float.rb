@@ -0,0 +1,16 @@
+#
+# Float arithmetic and comparison. (complementary filter)
+#
+angle = 0.0
+gyro = 0.5
+acc = 10.0
+dt = 0.01
+k = 0.98
+i = 0
+n = 0
+while i < 1_000_000
+  angle = k * (angle + gyro * dt) + (1.0 - k) * acc
+  n += 1 if angle > 5.0
+  i += 1
+end
+puts n
@@ -0,0 +1,31 @@
+#
+# Hash lookup in a table with hundreds of keys. (Integer, Symbol and String)
+#
+h = {}
+syms = [:alpha, :beta, :gamma, :delta, :epsilon, :zeta, :eta, :theta]
+i = 0
+while i < 200
+  h[i] = i
+  h["key#{i}"] = i
+  i += 1
+end
+syms.each { |s| h[s] = s }
+
+keys = []
+i = 0
+while i < 200
+  keys << "key#{i}"
+  i += 1
+end
+
+sum = 0
+200.times {
+  i = 0
+  while i < 200
+    sum += h[i]
+    sum += h[keys[i]]
+    i += 1
+  end
+  sum += 1 if h[:theta]
+}
+puts sum
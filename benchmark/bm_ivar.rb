@@ -0,0 +1,37 @@
+#
+# Instance variable reads and writes on an object with many variables.
+#
+class Particle
+  def initialize(x, y)
+    @x = x
+    @y = y
+    @vx = 1
+    @vy = 2
+    @ax = 0
+    @ay = 0
+    @mass = 1
+    @age = 0
+  end
+
+  def step
+    @vx += @ax
+    @vy += @ay
+    @x += @vx * @mass
+    @y += @vy * @mass
+    @age += 1
+  end
+
+  def pos
+    @x + @y
+  end
+end
+
+pt = Particle.new(0, 0)
+i = 0
+n = 0
+while i < 300_000
+  pt.step
+  n += Particle.new(i, i).pos & 1
+  i += 1
+end
+puts pt.pos + n
@@ -0,0 +1,28 @@
+#
+# Method calls on objects of a user defined class hierarchy.
+#
+class Base
+  def initialize(v)
+    @v = v
+  end
+
+  def value
+    @v
+  end
+end
+
+class Point < Base
+  def add(other)
+    value + other.value
+  end
+end
+
+a = Point.new(1)
+b = Point.new(2)
+i = 0
+sum = 0
+while i < 1_000_000
+  sum += a.add(b)
+  i += 1
+end
+puts sum
@@ -0,0 +1,17 @@
+#
+# Array#sort, sort with a block and sort_by. (native)
+#
+data = []
+x = 1
+500.times do
+  x = (x * 1103515245 + 12345) % 65536
+  data << x
+end
+
+sum = 0
+5.times do
+  sum += data.sort[0]
+  sum += data.sort { |a, b| b <=> a }[0]
+  sum += data.sort_by { |v| -v }[0]
+end
+puts sum
@@ -0,0 +1,46 @@
+#
+# The same as bm_sort.rb, with the exchange sort that was Array#sort!
+# in mrblib/array.rb.
+#
+class Array
+  def mrblib_sort!( &block )
+    n = length - 1
+    i = 0
+    while i < n
+      j = i
+      while j < n
+        j += 1
+        v_i = self[i]
+        v_j = self[j]
+        if block
+          next if block.call(v_i, v_j) <= 0
+        else
+          next if v_i <= v_j
+        end
+        self[i] = v_j
+        self[j] = v_i
+      end
+      i += 1
+    end
+    return self
+  end
+
+  def mrblib_sort( &block )
+    return self.dup.mrblib_sort!( &block )
+  end
+end
+
+data = []
+x = 1
+500.times do
+  x = (x * 1103515245 + 12345) % 65536
+  data << x
+end
+
+sum = 0
+5.times do
+  sum += data.mrblib_sort[0]
+  sum += data.mrblib_sort { |a, b| b <=> a }[0]
+  sum += data.map { |v| [-v, v] }.mrblib_sort { |a, b| a[0] <=> b[0] }[0][1]
+end
+puts sum
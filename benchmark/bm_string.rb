@@ -0,0 +1,39 @@
+#
+# String building: append in a loop, interpolation, join and sprintf.
+# Tokenizing: split, slice and strip.
+#
+record = "  sensor_temperature=23.5,sensor_humidity=45.2,sensor_pressure=1013.25  "
+n = 0
+100.times {
+  s = ""
+  i = 0
+  while i < 1000
+    s << "x"
+    i += 1
+  end
+  n += s.size
+
+  line = ""
+  i = 0
+  while i < 50
+    line = "#{line}[#{i}] "
+    i += 1
+  end
+  n += line.size
+
+  a = []
+  i = 0
+  while i < 50
+    a << "item#{i}"
+    i += 1
+  end
+  n += a.join(", ").size
+  n += sprintf("%s: %d %s", a.join, i, line).size
+
+  i = 0
+  while i < 10
+    record.strip.split(",").each { |kv| n += kv[0, kv.index("=")].size }
+    i += 1
+  end
+}
+puts n
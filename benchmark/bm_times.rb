@@ -0,0 +1,8 @@
+#
+# Integer#times loop with a block.
+#
+sum = 0
+3_000_000.times do |i|
+  sum += i
+end
+puts sum
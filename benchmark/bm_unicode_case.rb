@@ -0,0 +1,16 @@
+#
+# Unicode case mapping: upcase and downcase of Cyrillic, Greek and
+# Latin text. (MRBC_USE_STRING_UTF8 and MRBC_USE_UNICODE_CASE)
+#
+text = "Съешь же ещё этих мягких французских булок, да выпей чаю. " +
+       "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. " +
+       "The quick brown fox jumps over the lazy dog. " +
+       "Zwölf Boxkämpfer jagen Viktor quer über den großen Sylter Deich. "
+s = text * 4
+n = 0
+1000.times {
+  u = s.upcase
+  d = u.downcase
+  n += d.bytesize
+}
+puts n
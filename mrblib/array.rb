@@ -11,108 +11,6 @@
 class Array
   include Enumerable
 
-  #
-  # all?
-  #
-  def all?( *pattern, &block )
-    i = 0
-
-    # case of all? {|item| ... } -> bool
-    if block
-      while i < length
-        return false  if ! yield self[i]
-        i += 1
-      end
-
-    # case of all?(pattern) -> bool
-    elsif !pattern.empty?
-      while i < length
-        return false  if !(pattern[0] === self[i])
-        i += 1
-      end
-
-    # case of all? -> bool
-    else
-      while i < length
-        return false  if !self[i]
-        i += 1
-      end
-    end
-
-    return true
-  end
-
-  #
-  # any?
-  #
-  def any?( *pattern, &block )
-    i = 0
-
-    # case of any? {|item| ... } -> bool
-    if block
-      while i < length
-        return true  if yield self[i]
-        i += 1
-      end
-
-    # case of any?(pattern) -> bool
-    elsif !pattern.empty?
-      while i < length
-        return true  if pattern[0] === self[i]
-        i += 1
-      end
-
-    # case of any? -> bool
-    else
-      while i < length
-        return true  if self[i]
-        i += 1
-      end
-    end
-
-    return false
-  end
-
-  #
-  # collect!
-  #
-  def collect!
-    i = 0
-    while i < length
-      self[i] = yield self[i]
-      i += 1
-    end
-    return self
-  end
-  alias map! collect!
-
-  #
-  # delete_if
-  #
-  def delete_if
-    i = 0
-    while i < length
-      if yield self[i]
-        delete_at(i)
-      else
-        i += 1
-      end
-    end
-    return self
-  end
-
-  #
-  # each
-  #
-  def each
-    i = 0
-    while i < length
-      yield self[i]
-      i += 1
-    end
-    return self
-  end
-
   #
   # each index
   #
@@ -125,57 +23,6 @@ class Array
     return self
   end
 
-  #
-  # index
-  #
-  def index( *val, &block )
-    i = 0
-
-    # case of index {|item| ...} -> Integer | nil
-    if block
-      while i < length
-        return i  if yield self[i]
-        i += 1
-      end
-      return nil
-    end
-
-    # case of index(val) -> Integer | nil
-    if !val.empty?
-      while i < length
-        return i  if self[i] == val[0]
-        i += 1
-      end
-      return nil
-    end
-
-    raise ArgumentError
-  end
-  alias find_index index
-
-  #
-  # none?
-  #
-  def none?(...)
-    ! any?(...)
-  end
-
-  #
-  # reject!
-  #
-  def reject!( &block )
-    n = length
-    delete_if( &block )
-    return n == length ? nil : self
-  end
-
-  #
-  # reject
-  #
-  def reject( &block )
-    return self.dup.delete_if( &block )
-  end
-
   #
   # reverse_each
   #
@@ -188,74 +35,4 @@ class Array
     return self
   end
 
-  #
-  # select
-  #
-  def select()
-    ret = []
-    len = length()
-    i = 0
-
-    while i < len
-      if yield( self[i] )
-        ret << self[i]
-      end
-      i += 1
-    end
-
-    return ret
-  end
-  alias filter select
-
-  #
-  # select!
-  #
-  def select!
-    len = length()
-    i = 0
-
-    while i < length()
-      if yield( self[i] )
-        i += 1
-      else
-        delete_at(i)
-      end
-    end
-
-    return length == len ? nil : self
-  end
-  alias filter! select!
-
-  #
-  # sort!
-  #
-  def sort!( &block )
-    n = length - 1
-    i = 0
-    while i < n
-      j = i
-      while j < n
-        j += 1
-        v_i = self[i]
-        v_j = self[j]
-        if block
-          next if block.call(v_i, v_j) <= 0
-        else
-          next if v_i <= v_j
-        end
-        self[i] = v_j
-        self[j] = v_i
-      end
-      i += 1
-    end
-    return self
-  end
-
-  #
-  # sort
-  #
-  def sort( &block )
-    return self.dup.sort!( &block )
-  end
-
 end
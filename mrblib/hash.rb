@@ -10,20 +10,4 @@
 
 class Hash
   include Enumerable
-
-  #
-  # each
-  #
-  def each(&block)
-    keys = self.keys
-    len = length
-    i = 0
-    while i < len
-      key = keys[i]
-      block.call([key, self[key]])
-      i += 1
-    end
-
-    return self
-  end
 end
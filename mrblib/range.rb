@@ -1,25 +0,0 @@
-#
-# Range, mrubyc class library
-#
-#  Copyright (C) 2015-      Kyushu Institute of Technology.
-#  Copyright (C) 2015-2026  Shimane IT Open-Innovation Center.
-#  Copyright (C) 2026-      Shimane Institute for Industrial Technology.
-#
-#  This file is distributed under BSD 3-Clause License.
-#
-
-class Range
-
-  # each
-  def each
-    lim = self.last
-    lim += 1 unless exclude_end?
-    i = self.first
-    while i < lim do
-      yield i
-      i += 1
-    end
-    return self
-  end
-
-end
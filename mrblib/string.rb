@@ -22,18 +22,6 @@ class String
     self
   end
 
-  ##
-  # Passes each character in str to the given block.
-  #
-  def each_char
-    idx = 0
-    while idx < length
-      yield self[idx]
-      idx += 1
-    end
-    self
-  end
-
   #
   # ljust
   #
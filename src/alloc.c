@@ -520,9 +520,11 @@ void * mrbc_raw_alloc(unsigned int size)
 
   // else out of memory
 #if defined(MRBC_OUT_OF_MEMORY)
+  mrbc_flush();
   MRBC_OUT_OF_MEMORY();
 #else
   static const char msg[] = "Fatal error: Out of memory.\n";
+  mrbc_flush();
   mrbc_hal_write(2, msg, sizeof(msg)-1);
   mrbc_hal_abort(0);
 #endif
@@ -66,11 +66,125 @@
 /***** Constat values *******************************************************/
 /***** Macros ***************************************************************/
 /***** Typedefs *************************************************************/
+//================================================================
+/*! bottom-up merge sort, that can be suspended at each comparison.
+*/
+typedef struct ARRAY_SORT {
+  mrbc_value *data;	//!< data to sort.
+  mrbc_value *buf;	//!< work buffer. (not owns the values)
+  int n;		//!< num of data.
+  int width;		//!< width of runs to merge.
+  int lo;		//!< start index of the left run.
+  int i;		//!< index of the left run.
+  int j;		//!< index of the right run.
+  int k;		//!< index of buf.
+} mrbc_array_sort;
+
 /***** Function prototypes **************************************************/
 /***** Local variables ******************************************************/
 /***** Global variables *****************************************************/
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
+//================================================================
+/*! initialize the merge sort.
+*/
+static void array_sort_init( mrbc_array_sort *s, mrbc_value *data, mrbc_value *buf, int n )
+{
+  *s = (mrbc_array_sort){ .data = data, .buf = buf, .n = n,
+                          .width = 1, .lo = 0, .i = 0, .j = 1, .k = 0 };
+}
+
+
+//================================================================
+/*! proceed the merge sort until the next comparison.
+
+  @param  s	pointer to the sort state.
+  @retval 1	compare data[s->i] with data[s->j], and call array_sort_merge().
+  @retval 0	finished.
+*/
+static int array_sort_next( mrbc_array_sort *s )
+{
+  while( s->width < s->n ) {
+    int mid = s->lo + s->width;
+    if( mid > s->n ) mid = s->n;
+    int hi = mid + s->width;
+    if( hi > s->n ) hi = s->n;
+
+    if( s->i < mid && s->j < hi ) return 1;
+
+    // copy the rest of the runs.
+    while( s->i < mid ) s->buf[s->k++] = s->data[s->i++];
+    while( s->j < hi )  s->buf[s->k++] = s->data[s->j++];
+
+    // to the next runs, or the next pass.
+    s->lo = hi;
+    if( s->lo >= s->n ) {
+      memcpy( s->data, s->buf, sizeof(mrbc_value) * s->n );
+      s->width *= 2;
+      s->lo = 0;
+    }
+    s->i = s->k = s->lo;
+    s->j = s->lo + s->width;
+  }
+
+  return 0;
+}
+
+
+//================================================================
+/*! merge one value by the result of comparison.
+
+  @param  s	pointer to the sort state.
+  @param  cmp	result of comparison data[s->i] <=> data[s->j]
+*/
+static inline void array_sort_merge( mrbc_array_sort *s, int cmp )
+{
+  // (take the left one if equal, to keep stable)
+  if( cmp <= 0 ) {
+    s->buf[s->k++] = s->data[s->i++];
+  } else {
+    s->buf[s->k++] = s->data[s->j++];
+  }
+}
+
+
+//================================================================
+/*! compare for sort, with fast path for Integer.
+*/
+static inline int array_sort_compare( const mrbc_value *v1, const mrbc_value *v2 )
+{
+  if( mrbc_type(*v1) == MRBC_TT_INTEGER && mrbc_type(*v2) == MRBC_TT_INTEGER ) {
+    return (mrbc_integer(*v1) > mrbc_integer(*v2)) - (mrbc_integer(*v1) < mrbc_integer(*v2));
+  }
+  return mrbc_compare( v1, v2 );
+}
+
+
+//================================================================
+/*! sort values by mrbc_compare.
+
+  @param  data	values to sort.
+  @param  buf	work buffer that has the same size as data.
+  @param  n	num of values.
+  @param  keys	sort keys, when the values are indexes of keys. (or NULL)
+*/
+static void array_sort_values( mrbc_value *data, mrbc_value *buf, int n, const mrbc_value *keys )
+{
+  mrbc_array_sort s;
+  array_sort_init( &s, data, buf, n );
+
+  while( array_sort_next( &s ) ) {
+    const mrbc_value *v1 = &data[s.i];
+    const mrbc_value *v2 = &data[s.j];
+    if( keys ) {
+      v1 = &keys[ mrbc_integer(*v1) ];
+      v2 = &keys[ mrbc_integer(*v2) ];
+    }
+    array_sort_merge( &s, array_sort_compare( v1, v2 ));
+  }
+}
+
+
 /***** Global functions *****************************************************/
 
 //================================================================
@@ -521,7 +635,7 @@ int mrbc_array_index(const mrbc_value *ary, const mrbc_value *val)
 {
   int n = ary->array->n_stored;
   for( int i = 0; i < n; i++ ) {
-    if( mrbc_compare(&ary->array->data[i], val) == 0 ) return i;
+    if( mrbc_equal(&ary->array->data[i], val) ) return i;
   }
   return -1;
 }
@@ -556,7 +670,7 @@ int mrbc_array_uniq_self(mrbc_value *ary)
 
   for( int i = 0; i < size-1; i++ ) {
     for( int j = i+1; j < size; j++ ) {
-      if( mrbc_compare( &ah->data[i], &ah->data[j] ) != 0 ) continue;
+      if( !mrbc_equal( &ah->data[i], &ah->data[j] ) ) continue;
 
       mrbc_decref( &ah->data[j] );
       int rest = --size - j;
@@ -1258,79 +1372,1484 @@ static void c_array_reverse_self(mrbc_vm *vm, mrbc_value v[], int argc)
 }
 
 //================================================================
-/*! (method) deconstruct
+/*! (method) each
+
+  registers
+    v[0] self, v[1] block, v[2] index, v[3] block frame.
 */
-static void c_array_deconstruct(struct VM *vm, mrbc_value v[], int argc)
+static int array_each_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
 {
-  // Check argument count (must have no arguments)
-  if (argc != 0) {
-    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "wrong number of arguments");
+  int i = mrbc_integer(v[2]) + 1;
+  if( i >= mrbc_array_size(&v[0]) ) return -1;	// finished, and returns self.
+
+  mrbc_set_integer( &v[2], i );
+  v[4] = v[0].array->data[i];
+  mrbc_incref( &v[4] );
+  return 1;
+}
+
+static void c_array_each(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
     return;
   }
-  // For pattern matching - return self (not a copy)
-  // (already an array, no conversion needed)
+  if( mrbc_array_size(&v[0]) == 0 ) return;
+
+  mrbc_value arg = v[0].array->data[0];
+  mrbc_incref( &arg );
+  v = mrbc_yield( vm, v, 3, &v[1], 1, &arg, array_each_resume );
+  if( !v ) return;
+
+  mrbc_decref_empty( &v[2] );
+  mrbc_set_integer( &v[2], 0 );
 }
 
 
-#if MRBC_USE_STRING
 //================================================================
-/*! (method) inspect, to_s
+/*! call the block for the iterator methods below.
+
+  registers
+    v[0] self, v[1] argument or block, v[2] block (if argument given),
+    v[3] index, v[4] result, v[5] block frame.
+
+  @param  vm		pointer to VM.
+  @param  v		registers of the method.
+  @param  argc		num of arguments of the method.
+  @param  i		index of the element.
+  @param  result	initial value of v[4]. (moved)
+  @param  n_args	num of arguments of the block.
+  @param  args		arguments of the block. (moved)
+  @param  resume	resume function.
 */
-static void c_array_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
+static void array_iter_yield(mrbc_vm *vm, mrbc_value v[], int argc, int i, mrbc_value result, int n_args, mrbc_value *args, mrbc_resume_func resume)
 {
-  if( mrbc_type(v[0]) == MRBC_TT_CLASS ) {
-    mrbc_object_inspect(vm, v, argc);
+  v = mrbc_yield( vm, v, 5, &v[argc+1], n_args, args, resume );
+  if( !v ) {
+    mrbc_decref( &result );
     return;
   }
 
-  mrbc_value ret = mrbc_string_new_cstr(vm, "[");
+  mrbc_decref_empty( &v[3] );
+  mrbc_decref_empty( &v[4] );
+  mrbc_set_integer( &v[3], i );
+  v[4] = result;
+}
 
-  for( int i = 0; i < mrbc_array_size(v); i++ ) {
-    if( i != 0 ) mrbc_string_append_cstr( &ret, ", " );
 
-    mrbc_value v1 = mrbc_array_get(v, i);
-    mrbc_value s1 = mrbc_send( vm, v, argc, &v1, "inspect", 0 );
-    mrbc_string_append( &ret, &s1 );
-    mrbc_string_delete( &s1 );
+//================================================================
+/*! call the block with the first element (and index 0).
+*/
+static void array_iter_start(mrbc_vm *vm, mrbc_value v[], int argc, mrbc_value result, int with_index, mrbc_resume_func resume)
+{
+  mrbc_value args[2] = { v[0].array->data[0], mrbc_integer_value(0) };
+  mrbc_incref( &args[0] );
+
+  array_iter_yield( vm, v, argc, 0, result, 1 + with_index, args, resume );
+}
+
+
+//================================================================
+/*! set the next element (and index) to the arguments of the block.
+
+  @param  v		registers of the method.
+  @param  with_index	also pass the index to the block.
+  @return		num of arguments of the block, or -1 if finished.
+*/
+static int array_iter_next(mrbc_value v[], int with_index)
+{
+  int i = mrbc_integer(v[3]) + 1;
+  if( i >= mrbc_array_size(&v[0]) ) return -1;
+
+  mrbc_set_integer( &v[3], i );
+  v[6] = v[0].array->data[i];
+  mrbc_incref( &v[6] );
+  if( !with_index ) return 1;
+
+  mrbc_set_integer( &v[7], i );
+  return 2;
+}
+
+
+//================================================================
+/*! finish the iteration, and returns v[4].
+*/
+static int array_iter_return(mrbc_value v[])
+{
+  SET_RETURN( v[4] );
+  mrbc_set_tt( &v[4], MRBC_TT_EMPTY );
+  return -1;
+}
+
+
+//================================================================
+/*! check that the block is given.
+*/
+static int array_block_given(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( mrbc_c_block_given(vm, v, argc) ) return 1;
+
+  mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+  return 0;
+}
+
+
+//================================================================
+/*! apply the binary operator to acc and val, as acc = acc op val.
+
+  Integer and Float operands of + - * are calculated here, and the
+  operator written in C is called by mrbc_send. The operator written
+  in Ruby is returned to be called by VM. (see array_operate_next)
+
+  @param  vm	pointer to VM.
+  @param  v	registers of the method. (mrbc_send uses v[argc+2]..)
+  @param  argc	num of arguments of the method.
+  @param  acc	accumulator.
+  @param  op	operator (method name).
+  @param  val	operand.
+  @param  method returns the operator written in Ruby.
+  @return	0 if calculated, 1 if the method is returned, or -1 if error.
+*/
+static int array_operate(mrbc_vm *vm, mrbc_value v[], int argc, mrbc_value *acc, mrbc_sym op, mrbc_value *val, mrbc_method *method)
+{
+  if( op == MRBC_SYM(PLUS) || op == MRBC_SYM(MINUS) || op == MRBC_SYM(MUL) ) {
+    if( mrbc_type(*acc) == MRBC_TT_INTEGER && mrbc_type(*val) == MRBC_TT_INTEGER ) {
+      mrbc_int_t a = mrbc_integer(*acc);
+      mrbc_int_t b = mrbc_integer(*val);
+      mrbc_set_integer( acc, (op == MRBC_SYM(PLUS)) ? a + b :
+                             (op == MRBC_SYM(MINUS)) ? a - b : a * b );
+      return 0;
+    }
+
+#if MRBC_USE_FLOAT
+    if( (mrbc_type(*acc) == MRBC_TT_FLOAT || mrbc_type(*val) == MRBC_TT_FLOAT) &&
+        (mrbc_type(*acc) == MRBC_TT_FLOAT || mrbc_type(*acc) == MRBC_TT_INTEGER) &&
+        (mrbc_type(*val) == MRBC_TT_FLOAT || mrbc_type(*val) == MRBC_TT_INTEGER) ) {
+      mrbc_float_t a = (mrbc_type(*acc) == MRBC_TT_FLOAT) ? mrbc_float(*acc) : mrbc_integer(*acc);
+      mrbc_float_t b = (mrbc_type(*val) == MRBC_TT_FLOAT) ? mrbc_float(*val) : mrbc_integer(*val);
+      mrbc_set_float( acc, (op == MRBC_SYM(PLUS)) ? a + b :
+                           (op == MRBC_SYM(MINUS)) ? a - b : a * b );
+      return 0;
+    }
+#endif
   }
 
-  mrbc_string_append_cstr( &ret, "]" );
+  mrbc_class *cls = mrbc_find_class_by_object( acc );
+  if( mrbc_find_method( method, cls, op ) == 0 ) {
+    mrbc_raisef( vm, MRBC_CLASS(NoMethodError), "undefined method '%s' for %s",
+                 mrbc_symid_to_str(op), mrbc_symid_to_str(cls->sym_id) );
+    return -1;
+  }
+  if( !method->c_func ) return 1;
 
-  SET_RETURN(ret);
+  mrbc_value ret = mrbc_send( vm, v, argc, acc, mrbc_symid_to_str(op), 1, val );
+  if( mrbc_israised(vm) ) return -1;
+
+  mrbc_decref( acc );
+  *acc = ret;
+  return 0;
 }
 
 
 //================================================================
-/*! (method) join
+/*! apply the operator to the accumulator and the elements,
+    for inject(sym) and sum.
+
+  registers
+    v[0] self, v[1] v[2] arguments or block, v[3] index of the next element,
+    v[4] accumulator, v[5] operator (Symbol), v[6] block of sum or nil,
+    v[7] frame of the block or the operator written in Ruby.
+
+  The block and the operator written in Ruby are called by VM, and
+  the calculation continues in array_operate_resume.
+
+  @param  vm	pointer to VM.
+  @param  v	registers of the method.
+  @param  val	the result of the block, or NULL. (moved)
+  @param  flag_resume	called by the resume function.
+  @return	same as mrbc_resume_func.
 */
-static void c_array_join_1(mrbc_vm *vm, mrbc_value v[], int argc,
-                           mrbc_value *src, mrbc_value *ret, mrbc_value *separator)
+static int array_operate_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret);
+
+static int array_operate_next(mrbc_vm *vm, mrbc_value v[], mrbc_value *val, int flag_resume)
 {
-  if( mrbc_array_size(src) == 0 ) return;
+  int ofs = v - vm->regs;
+  mrbc_method method;
+
+  while( 1 ) {
+    mrbc_value item;
+
+    if( val ) {
+      item = *val;
+      val = NULL;
 
-  int i = 0;
-  int flag_error = 0;
-  while( !flag_error ) {
-    if( mrbc_type(src->array->data[i]) == MRBC_TT_ARRAY ) {
-      c_array_join_1(vm, v, argc, &src->array->data[i], ret, separator);
     } else {
-      mrbc_value v1 = mrbc_send( vm, v, argc, &src->array->data[i], "to_s", 0 );
-      flag_error |= mrbc_string_append( ret, &v1 );
-      mrbc_decref(&v1);
+      int i = mrbc_integer(v[3]);
+      if( i >= mrbc_array_size(&v[0]) ) break;
+
+      mrbc_set_integer( &v[3], i + 1 );
+      item = v[0].array->data[i];
+      mrbc_incref( &item );
+
+      // call the block of sum, and add the result.
+      if( mrbc_type(v[6]) == MRBC_TT_PROC ) {
+        if( flag_resume && vm->callinfo_tail->is_called_block ) {
+          v[8] = item;		// call the block again in the same frame.
+          return 1;
+        }
+        if( !mrbc_yield( vm, v, 7, &v[6], 1, &item, array_operate_resume ) ) {
+          goto ERROR;
+        }
+        return 0;
+      }
     }
-    if( ++i >= mrbc_array_size(src) ) break;	// normal return.
-    flag_error |= mrbc_string_append( ret, separator );
+
+    // use the registers after the frame for mrbc_send.
+    int r = array_operate( vm, v, 6, &v[4], mrbc_symbol(v[5]), &item, &method );
+    if( r <= 0 ) {
+      mrbc_decref( &item );
+      if( r < 0 ) goto ERROR;
+      continue;
+    }
+
+    // call the operator written in Ruby.
+    mrbc_value acc = v[4];
+    mrbc_set_tt( &v[4], MRBC_TT_EMPTY );
+    if( !mrbc_call_method( vm, v, 7, &acc, &method, 1, &item, array_operate_resume ) ) {
+      goto ERROR;
+    }
+    return 0;
   }
+
+  // finished.
+  SET_RETURN( v[4] );
+  mrbc_set_tt( &v[4], MRBC_TT_EMPTY );
+  mrbc_decref_empty( &v[6] );
+  return -1;
+
+ ERROR:
+  v = vm->regs + ofs;		// may be relocated by mrbc_yield.
+  for( int i = 3; i <= 6; i++ ) {
+    mrbc_decref_empty( &v[i] );
+  }
+  return -1;
 }
 
-static void c_array_join(mrbc_vm *vm, mrbc_value v[], int argc)
+
+//================================================================
+/*! resume inject(sym) and sum, when the block or the operator returns.
+*/
+static int array_operate_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
 {
-  mrbc_value ret = mrbc_string_new(vm, NULL, 0);
-  mrbc_value separator = (argc == 0) ? mrbc_string_new_cstr(vm, "") :
-    mrbc_send( vm, v, argc, &v[1], "to_s", 0 );
+  mrbc_incref( ret );
 
-  c_array_join_1(vm, v, argc, &v[0], &ret, &separator );
-  mrbc_decref(&separator);
+  // the block returns the operand.
+  if( vm->callinfo_tail->is_called_block ) {
+    return array_operate_next( vm, v, ret, 1 );
+  }
+
+  // the operator returns the accumulator.
+  mrbc_decref( &v[4] );
+  v[4] = *ret;
+  return array_operate_next( vm, v, NULL, 1 );
+}
+
+
+//================================================================
+/*! start to apply the operator, from the i'th element.
+
+  @param  vm	pointer to VM.
+  @param  v	registers of the method.
+  @param  i	index of the first element.
+  @param  acc	initial value of the accumulator. (moved)
+  @param  op	operator (method name).
+  @param  blk	block of sum, or NULL.
+*/
+static void array_operate_start(mrbc_vm *vm, mrbc_value v[], int i, mrbc_value acc, mrbc_sym op, const mrbc_value *blk)
+{
+  mrbc_value block = blk ? *blk : mrbc_nil_value();
+  mrbc_incref( &block );
+
+  for( int j = 3; j <= 6; j++ ) {
+    mrbc_decref_empty( &v[j] );
+  }
+  mrbc_set_integer( &v[3], i );
+  v[4] = acc;
+  mrbc_set_symbol( &v[5], op );
+  v[6] = block;
+
+  array_operate_next( vm, v, NULL, 0 );
+}
+
+
+//================================================================
+/*! make a new array from a part of the array.
+*/
+static mrbc_value array_subarray(mrbc_vm *vm, const mrbc_value *ary, int start, int len)
+{
+  int n = mrbc_array_size(ary) - start;
+  if( len > n ) len = n;
+
+  mrbc_value ret = mrbc_array_new( vm, len );
+  for( int i = 0; i < len; i++ ) {
+    mrbc_value *item = &ary->array->data[start + i];
+    mrbc_incref( item );
+    mrbc_array_push( &ret, item );
+  }
+
+  return ret;
+}
+
+
+//================================================================
+/*! (method) each_with_index
+*/
+static int array_each_with_index_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_iter_next( v, 1 );	// returns self when finished.
+}
+
+static void c_array_each_with_index(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+  if( mrbc_array_size(&v[0]) == 0 ) return;
+
+  array_iter_start( vm, v, argc, mrbc_nil_value(), 1, array_each_with_index_resume );
+}
+
+
+//================================================================
+/*! (method) collect, map
+*/
+static int array_collect_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  mrbc_incref( ret );
+  mrbc_array_push( &v[4], ret );
+
+  int n = array_iter_next( v, 0 );
+  return (n < 0) ? array_iter_return( v ) : n;
+}
+
+static void c_array_collect(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+
+  int n = mrbc_array_size(&v[0]);
+  mrbc_value ret = mrbc_array_new( vm, n );
+  if( n == 0 ) {
+    SET_RETURN( ret );
+    return;
+  }
+
+  array_iter_start( vm, v, argc, ret, 0, array_collect_resume );
+}
+
+
+//================================================================
+/*! (method) collect!, map!
+*/
+static int array_collect_self_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  int i = mrbc_integer(v[3]);
+  if( i < mrbc_array_size(&v[0]) ) {
+    mrbc_incref( ret );
+    mrbc_value old = v[0].array->data[i];
+    v[0].array->data[i] = *ret;
+    mrbc_decref( &old );
+  }
+
+  return array_iter_next( v, 0 );	// returns self when finished.
+}
+
+static void c_array_collect_self(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+  if( mrbc_array_size(&v[0]) == 0 ) return;
+
+  array_iter_start( vm, v, argc, mrbc_nil_value(), 0, array_collect_self_resume );
+}
+
+
+//================================================================
+/*! (method) flat_map, collect_concat
+*/
+static int array_flat_map_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  if( mrbc_type(*ret) == MRBC_TT_ARRAY ) {
+    for( int i = 0; i < mrbc_array_size(ret); i++ ) {
+      mrbc_value *item = &ret->array->data[i];
+      mrbc_incref( item );
+      mrbc_array_push( &v[4], item );
+    }
+  } else {
+    mrbc_incref( ret );
+    mrbc_array_push( &v[4], ret );
+  }
+
+  int n = array_iter_next( v, 0 );
+  return (n < 0) ? array_iter_return( v ) : n;
+}
+
+static void c_array_flat_map(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+
+  int n = mrbc_array_size(&v[0]);
+  mrbc_value ret = mrbc_array_new( vm, n );
+  if( n == 0 ) {
+    SET_RETURN( ret );
+    return;
+  }
+
+  array_iter_start( vm, v, argc, ret, 0, array_flat_map_resume );
+}
+
+
+//================================================================
+/*! (method) select, filter, reject
+*/
+static int array_select_resume_1(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret, int flag_select)
+{
+  if( (mrbc_type(*ret) > MRBC_TT_FALSE) == flag_select ) {
+    mrbc_value item = mrbc_array_get( &v[0], mrbc_integer(v[3]) );
+    mrbc_incref( &item );
+    mrbc_array_push( &v[4], &item );
+  }
+
+  int n = array_iter_next( v, 0 );
+  return (n < 0) ? array_iter_return( v ) : n;
+}
+
+static int array_select_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_select_resume_1( vm, v, ret, 1 );
+}
+
+static int array_reject_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_select_resume_1( vm, v, ret, 0 );
+}
+
+static void array_select(mrbc_vm *vm, mrbc_value v[], int argc, mrbc_resume_func resume)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+
+  int n = mrbc_array_size(&v[0]);
+  mrbc_value ret = mrbc_array_new( vm, n );
+  if( n == 0 ) {
+    SET_RETURN( ret );
+    return;
+  }
+
+  array_iter_start( vm, v, argc, ret, 0, resume );
+}
+
+static void c_array_select(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_select( vm, v, argc, array_select_resume );
+}
+
+static void c_array_reject(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_select( vm, v, argc, array_reject_resume );
+}
+
+
+//================================================================
+/*! (method) delete_if, reject!, select!, filter!
+
+  v[4] is the num of deleted elements.
+*/
+static int array_delete_if_resume_1(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret, int flag_delete)
+{
+  int i = mrbc_integer(v[3]);
+  if( (mrbc_type(*ret) > MRBC_TT_FALSE) == flag_delete &&
+      i < mrbc_array_size(&v[0]) ) {
+    mrbc_value item = mrbc_array_remove( &v[0], i );
+    mrbc_decref( &item );
+    mrbc_set_integer( &v[3], i - 1 );
+    mrbc_set_integer( &v[4], mrbc_integer(v[4]) + 1 );
+  }
+
+  return array_iter_next( v, 0 );
+}
+
+static int array_delete_if_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_delete_if_resume_1( vm, v, ret, 1 );	// returns self.
+}
+
+static int array_reject_self_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  int n = array_delete_if_resume_1( vm, v, ret, 1 );
+  if( n < 0 && mrbc_integer(v[4]) == 0 ) SET_NIL_RETURN();
+  return n;
+}
+
+static int array_select_self_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  int n = array_delete_if_resume_1( vm, v, ret, 0 );
+  if( n < 0 && mrbc_integer(v[4]) == 0 ) SET_NIL_RETURN();
+  return n;
+}
+
+static void array_delete_if(mrbc_vm *vm, mrbc_value v[], int argc, mrbc_resume_func resume)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+  if( mrbc_array_size(&v[0]) == 0 ) {
+    if( resume != array_delete_if_resume ) SET_NIL_RETURN();
+    return;
+  }
+
+  array_iter_start( vm, v, argc, mrbc_integer_value(0), 0, resume );
+}
+
+static void c_array_delete_if(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_delete_if( vm, v, argc, array_delete_if_resume );
+}
+
+static void c_array_reject_self(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_delete_if( vm, v, argc, array_reject_self_resume );
+}
+
+static void c_array_select_self(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_delete_if( vm, v, argc, array_select_self_resume );
+}
+
+
+//================================================================
+/*! (method) index, find_index
+*/
+static int array_index_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  if( mrbc_type(*ret) > MRBC_TT_FALSE ) {
+    SET_INT_RETURN( mrbc_integer(v[3]) );
+    return -1;
+  }
+
+  int n = array_iter_next( v, 0 );
+  if( n < 0 ) SET_NIL_RETURN();
+  return n;
+}
+
+static void c_array_index(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  // case of index(val) -> Integer | nil
+  if( argc == 1 ) {
+    int i = mrbc_array_index( &v[0], &v[1] );
+    if( i < 0 ) {
+      SET_NIL_RETURN();
+    } else {
+      SET_INT_RETURN( i );
+    }
+    return;
+  }
+
+  // case of index {|item| ... } -> Integer | nil
+  if( !array_block_given(vm, v, argc) ) return;
+  if( mrbc_array_size(&v[0]) == 0 ) {
+    SET_NIL_RETURN();
+    return;
+  }
+
+  array_iter_start( vm, v, argc, mrbc_nil_value(), 0, array_index_resume );
+}
+
+
+//================================================================
+/*! (method) find, detect
+*/
+static int array_find_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  if( mrbc_type(*ret) > MRBC_TT_FALSE ) {
+    mrbc_value item = mrbc_array_get( &v[0], mrbc_integer(v[3]) );
+    mrbc_incref( &item );
+    SET_RETURN( item );
+    return -1;
+  }
+
+  int n = array_iter_next( v, 0 );
+  if( n < 0 ) SET_NIL_RETURN();
+  return n;
+}
+
+static void c_array_find(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !array_block_given(vm, v, argc) ) return;
+  if( mrbc_array_size(&v[0]) == 0 ) {
+    SET_NIL_RETURN();
+    return;
+  }
+
+  array_iter_start( vm, v, argc, mrbc_nil_value(), 0, array_find_resume );
+}
+
+
+//================================================================
+/*! (method) all?, any?, none?
+
+  @param  flag_any	1: stop at the element that matches. (any?, none?)
+			0: stop at the element that does not match. (all?)
+  @param  flag_not	negate the result. (none?)
+*/
+static int array_all_resume_1(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret, int flag_any, int flag_not)
+{
+  if( (mrbc_type(*ret) > MRBC_TT_FALSE) == flag_any ) {
+    SET_BOOL_RETURN( flag_any ^ flag_not );
+    return -1;
+  }
+
+  int n = array_iter_next( v, 0 );
+  if( n < 0 ) SET_BOOL_RETURN( !flag_any ^ flag_not );
+  return n;
+}
+
+static int array_all_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_all_resume_1( vm, v, ret, 0, 0 );
+}
+
+static int array_any_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_all_resume_1( vm, v, ret, 1, 0 );
+}
+
+static int array_none_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_all_resume_1( vm, v, ret, 1, 1 );
+}
+
+static void array_all(mrbc_vm *vm, mrbc_value v[], int argc, int flag_any, int flag_not, mrbc_resume_func resume)
+{
+  int n = mrbc_array_size(&v[0]);
+
+  // case of all? {|item| ... } -> bool
+  if( argc == 0 && mrbc_c_block_given(vm, v, argc) && n != 0 ) {
+    array_iter_start( vm, v, argc, mrbc_nil_value(), 0, resume );
+    return;
+  }
+
+  // case of all?(pattern) -> bool, and all? -> bool
+  for( int i = 0; i < n && i < mrbc_array_size(&v[0]); i++ ) {
+    mrbc_value *item = &v[0].array->data[i];
+    int match;
+    if( argc == 0 ) {
+      match = (mrbc_type(*item) > MRBC_TT_FALSE);
+    } else {
+      mrbc_value ret = mrbc_send( vm, v, argc, &v[1], "===", 1, item );
+      if( mrbc_israised(vm) ) return;
+      match = (mrbc_type(ret) > MRBC_TT_FALSE);
+      mrbc_decref( &ret );
+    }
+
+    if( match == flag_any ) {
+      SET_BOOL_RETURN( flag_any ^ flag_not );
+      return;
+    }
+  }
+
+  SET_BOOL_RETURN( !flag_any ^ flag_not );
+}
+
+static void c_array_all(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_all( vm, v, argc, 0, 0, array_all_resume );
+}
+
+static void c_array_any(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_all( vm, v, argc, 1, 0, array_any_resume );
+}
+
+static void c_array_none(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_all( vm, v, argc, 1, 1, array_none_resume );
+}
+
+
+//================================================================
+/*! (method) count
+*/
+static int array_count_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  if( mrbc_type(*ret) > MRBC_TT_FALSE ) {
+    mrbc_set_integer( &v[4], mrbc_integer(v[4]) + 1 );
+  }
+
+  int n = array_iter_next( v, 0 );
+  return (n < 0) ? array_iter_return( v ) : n;
+}
+
+static void c_array_count(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  int n = mrbc_array_size(&v[0]);
+
+  // case of count(val) -> Integer
+  if( argc == 1 ) {
+    int count = 0;
+    for( int i = 0; i < n; i++ ) {
+      count += mrbc_equal( &v[0].array->data[i], &v[1] );
+    }
+    SET_INT_RETURN( count );
+    return;
+  }
+
+  // case of count -> Integer
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    SET_INT_RETURN( n );
+    return;
+  }
+
+  // case of count {|item| ... } -> Integer
+  if( n == 0 ) {
+    SET_INT_RETURN( 0 );
+    return;
+  }
+
+  array_iter_start( vm, v, argc, mrbc_integer_value(0), 0, array_count_resume );
+}
+
+
+//================================================================
+/*! (method) inject, reduce
+
+  v[4] is the accumulator.
+*/
+static int array_inject_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  mrbc_decref( &v[4] );
+  v[4] = *ret;
+  mrbc_incref( &v[4] );
+
+  int i = mrbc_integer(v[3]) + 1;
+  if( i >= mrbc_array_size(&v[0]) ) return array_iter_return( v );
+
+  mrbc_set_integer( &v[3], i );
+  v[6] = v[4];
+  v[7] = v[0].array->data[i];
+  mrbc_incref( &v[6] );
+  mrbc_incref( &v[7] );
+  return 2;
+}
+
+static void c_array_inject(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  int n = mrbc_array_size(&v[0]);
+  int i = 0;
+  mrbc_value acc;
+
+  // the initial value.
+  if( argc == 2 || (argc == 1 && mrbc_c_block_given(vm, v, argc)) ) {
+    acc = v[1];
+    mrbc_incref( &acc );
+  } else if( n != 0 ) {
+    acc = v[0].array->data[i++];
+    mrbc_incref( &acc );
+  } else {
+    SET_NIL_RETURN();
+    return;
+  }
+
+  // case of inject(init) {|memo, item| ... }, and inject {|memo, item| ... }
+  if( argc == 0 || (argc == 1 && mrbc_c_block_given(vm, v, argc)) ) {
+    if( !array_block_given(vm, v, argc) ) goto ERROR;
+    if( i >= n ) goto RETURN;
+
+    mrbc_value args[2] = { acc, v[0].array->data[i] };
+    mrbc_incref( &args[0] );
+    mrbc_incref( &args[1] );
+    array_iter_yield( vm, v, argc, i, acc, 2, args, array_inject_resume );
+    return;
+  }
+
+  // case of inject(init, sym), and inject(sym)
+  if( mrbc_type(v[argc]) != MRBC_TT_SYMBOL ) {
+    mrbc_value s = mrbc_send( vm, v, argc, &v[argc], "inspect", 0 );
+    if( !mrbc_israised(vm) ) {
+      mrbc_raisef( vm, MRBC_CLASS(TypeError), "%s is not a symbol",
+                   mrbc_string_cstr(&s) );
+    }
+    mrbc_decref( &s );
+    goto ERROR;
+  }
+  array_operate_start( vm, v, i, acc, mrbc_symbol(v[argc]), NULL );
+  return;
+
+ RETURN:
+  SET_RETURN( acc );
+  return;
+
+ ERROR:
+  mrbc_decref( &acc );
+}
+
+
+//================================================================
+/*! (method) sum
+
+  see array_operate_next.
+*/
+static void c_array_sum(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  mrbc_value acc = (argc == 0) ? mrbc_integer_value(0) : v[1];
+  mrbc_incref( &acc );
+
+  // case of sum(init = 0) {|item| ... }, and sum(init = 0)
+  const mrbc_value *blk = mrbc_c_block_given(vm, v, argc) ? &v[argc+1] : NULL;
+  array_operate_start( vm, v, 0, acc, MRBC_SYM(PLUS), blk );
+}
+
+
+//================================================================
+/*! (method) each_slice, each_cons
+
+  v[1] is the size of slice.
+*/
+static int array_each_slice_next(mrbc_vm *vm, mrbc_value v[], int i, int flag_cons)
+{
+  int len = mrbc_integer(v[1]);
+  int n = mrbc_array_size(&v[0]);
+  if( flag_cons ? (i + len > n) : (i >= n) ) return -1;	// returns self.
+
+  mrbc_set_integer( &v[3], i );
+  v[6] = array_subarray( vm, &v[0], i, len );
+  return 1;
+}
+
+static int array_each_slice_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_each_slice_next( vm, v, mrbc_integer(v[3]) + mrbc_integer(v[1]), 0 );
+}
+
+static int array_each_cons_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  return array_each_slice_next( vm, v, mrbc_integer(v[3]) + 1, 1 );
+}
+
+static void array_each_slice(mrbc_vm *vm, mrbc_value v[], int argc, int flag_cons)
+{
+  if( argc != 1 || mrbc_type(v[1]) != MRBC_TT_INTEGER ) {
+    mrbc_raise( vm, MRBC_CLASS(ArgumentError), 0 );
+    return;
+  }
+  if( mrbc_integer(v[1]) <= 0 ) {
+    mrbc_raise( vm, MRBC_CLASS(ArgumentError),
+                flag_cons ? "invalid size" : "invalid slice size" );
+    return;
+  }
+  if( !array_block_given(vm, v, argc) ) return;
+
+  int len = mrbc_integer(v[1]);
+  int n = mrbc_array_size(&v[0]);
+  if( n == 0 || (flag_cons && len > n) ) return;
+
+  mrbc_value arg = array_subarray( vm, &v[0], 0, len );
+  array_iter_yield( vm, v, argc, 0, mrbc_nil_value(), 1, &arg,
+                    flag_cons ? array_each_cons_resume : array_each_slice_resume );
+}
+
+static void c_array_each_slice(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_each_slice( vm, v, argc, 0 );
+}
+
+static void c_array_each_cons(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_each_slice( vm, v, argc, 1 );
+}
+
+
+//================================================================
+/*! (method) zip
+*/
+static int array_zip_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  int n = array_iter_next( v, 0 );
+  if( n < 0 ) SET_NIL_RETURN();
+  return n;
+}
+
+static void c_array_zip(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  for( int i = 1; i <= argc; i++ ) {
+    if( mrbc_type(v[i]) != MRBC_TT_ARRAY ) {
+      mrbc_raisef( vm, MRBC_CLASS(TypeError), "no implicit conversion into %s", "Array");
+      return;
+    }
+  }
+
+  int n = mrbc_array_size(&v[0]);
+  mrbc_value ret = mrbc_array_new( vm, n );
+  for( int i = 0; i < n; i++ ) {
+    mrbc_value tuple = mrbc_array_new( vm, argc + 1 );
+    for( int j = 0; j <= argc; j++ ) {
+      mrbc_value item = mrbc_array_get( &v[j], i );
+      mrbc_incref( &item );
+      mrbc_array_push( &tuple, &item );
+    }
+    mrbc_array_push( &ret, &tuple );
+  }
+
+  // case of zip(*arrays) -> Array
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    SET_RETURN( ret );
+    return;
+  }
+
+  // case of zip(*arrays) {|item| ... } -> nil
+  //  iterates the tuples as self, and the block is moved to v[1].
+  SET_RETURN( ret );
+  mrbc_value blk = v[argc+1];
+  mrbc_set_tt( &v[argc+1], MRBC_TT_EMPTY );
+  for( int i = 1; i <= argc; i++ ) {
+    mrbc_decref_empty( &v[i] );
+  }
+  v[1] = blk;
+
+  if( n == 0 ) {
+    SET_NIL_RETURN();
+    return;
+  }
+  array_iter_start( vm, v, 0, mrbc_nil_value(), 0, array_zip_resume );
+}
+
+
+//================================================================
+/*! (method) sort!, sort  (for block)
+
+  registers
+    v[0] self, v[1] block, v[2] data (dup of self), v[3] work buffer,
+    v[4]..v[8] state of mrbc_array_sort, v[9] block frame.
+*/
+static void array_sort_save( mrbc_value v[], const mrbc_array_sort *s )
+{
+  mrbc_set_integer( &v[4], s->width );
+  mrbc_set_integer( &v[5], s->lo );
+  mrbc_set_integer( &v[6], s->i );
+  mrbc_set_integer( &v[7], s->j );
+  mrbc_set_integer( &v[8], s->k );
+}
+
+static void array_sort_set_args( mrbc_value v[], const mrbc_array_sort *s )
+{
+  v[10] = s->data[s->i];
+  v[11] = s->data[s->j];
+  mrbc_incref( &v[10] );
+  mrbc_incref( &v[11] );
+}
+
+static int array_sort_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  int cmp;
+  switch( mrbc_type(*ret) ) {
+  case MRBC_TT_INTEGER:
+    cmp = (mrbc_integer(*ret) > 0) - (mrbc_integer(*ret) < 0);
+    break;
+#if MRBC_USE_FLOAT
+  case MRBC_TT_FLOAT:
+    cmp = (mrbc_float(*ret) > 0) - (mrbc_float(*ret) < 0);
+    break;
+#endif
+  default:
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "comparison failed");
+    return -1;
+  }
+
+  mrbc_array_sort s = {
+    .data = v[2].array->data, .buf = v[3].array->data,
+    .n = v[2].array->n_stored, .width = mrbc_integer(v[4]),
+    .lo = mrbc_integer(v[5]), .i = mrbc_integer(v[6]),
+    .j = mrbc_integer(v[7]), .k = mrbc_integer(v[8]),
+  };
+  array_sort_merge( &s, cmp );
+
+  if( array_sort_next( &s ) ) {
+    array_sort_save( v, &s );
+    array_sort_set_args( v, &s );
+    return 2;
+  }
+
+  return -1;	// finished.
+}
+
+static int array_sort_self_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  if( array_sort_resume( vm, v, ret ) >= 0 ) return 2;
+  if( mrbc_israised(vm) ) return -1;
+
+  // swap the contents of self and sorted data.
+  mrbc_array tmp = *v[0].array;
+  v[0].array->data_size = v[2].array->data_size;
+  v[0].array->n_stored = v[2].array->n_stored;
+  v[0].array->data = v[2].array->data;
+  v[2].array->data_size = tmp.data_size;
+  v[2].array->n_stored = tmp.n_stored;
+  v[2].array->data = tmp.data;
+  return -1;
+}
+
+static int array_sort_dup_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  if( array_sort_resume( vm, v, ret ) >= 0 ) return 2;
+  if( mrbc_israised(vm) ) return -1;
+
+  SET_RETURN( v[2] );
+  mrbc_set_tt( &v[2], MRBC_TT_EMPTY );
+  return -1;
+}
+
+static void array_sort_by_block( mrbc_vm *vm, mrbc_value v[], int argc, mrbc_resume_func resume )
+{
+  mrbc_value data = mrbc_array_dup( vm, &v[0] );
+  int n = data.array->n_stored;
+  mrbc_array_sort s;
+
+  array_sort_init( &s, data.array->data, 0, n );
+  if( !array_sort_next( &s ) ) {
+    // (no need to compare)
+    if( resume == array_sort_dup_resume ) {
+      SET_RETURN( data );
+    } else {
+      mrbc_decref( &data );
+    }
+    return;
+  }
+
+  mrbc_value buf = mrbc_array_new( vm, n );
+  mrbc_value args[2] = { s.data[s.i], s.data[s.j] };
+  mrbc_incref( &args[0] );
+  mrbc_incref( &args[1] );
+
+  mrbc_value *regs = mrbc_yield( vm, v, 9, &v[1], 2, args, resume );
+  if( !regs ) {
+    mrbc_decref( &data );
+    mrbc_decref( &buf );
+    return;
+  }
+  for( int i = 2; i < 9; i++ ) {
+    mrbc_decref_empty( &regs[i] );
+  }
+  regs[2] = data;
+  regs[3] = buf;
+  array_sort_save( regs, &s );
+}
+
+
+//================================================================
+/*! (method) sort!
+*/
+static void c_array_sort_self(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( argc != 0 ) {
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "wrong number of arguments");
+    return;
+  }
+  if( mrbc_c_block_given(vm, v, argc) ) {
+    array_sort_by_block( vm, v, argc, array_sort_self_resume );
+    return;
+  }
+
+  mrbc_array *h = v[0].array;
+  if( h->n_stored < 2 ) return;
+
+  mrbc_value *buf = mrbc_alloc( vm, sizeof(mrbc_value) * h->n_stored );
+  if( !buf ) return;
+  array_sort_values( h->data, buf, h->n_stored, 0 );
+  mrbc_free( vm, buf );
+}
+
+
+//================================================================
+/*! (method) sort
+*/
+static void c_array_sort(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( argc != 0 ) {
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "wrong number of arguments");
+    return;
+  }
+  if( mrbc_c_block_given(vm, v, argc) ) {
+    array_sort_by_block( vm, v, argc, array_sort_dup_resume );
+    return;
+  }
+
+  mrbc_value ret = mrbc_array_dup( vm, &v[0] );
+  int n = ret.array->n_stored;
+  if( n >= 2 ) {
+    mrbc_value *buf = mrbc_alloc( vm, sizeof(mrbc_value) * n );
+    if( buf ) {
+      array_sort_values( ret.array->data, buf, n, 0 );
+      mrbc_free( vm, buf );
+    }
+  }
+
+  SET_RETURN( ret );
+}
+
+
+//================================================================
+/*! (method) sort_by
+
+  registers
+    v[0] self, v[1] block, v[2] snapshot of self, v[3] keys, v[4] block frame.
+*/
+static int array_sort_by_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  mrbc_incref( ret );
+  mrbc_array_push( &v[3], ret );
+
+  int i = mrbc_array_size( &v[3] );
+  int n = mrbc_array_size( &v[2] );
+  if( i < n ) {
+    v[5] = mrbc_array_get( &v[2], i );
+    mrbc_incref( &v[5] );
+    return 1;
+  }
+
+  // sort the indexes by keys, and make the result.
+  mrbc_value ret_ary = mrbc_array_new( vm, n );
+  mrbc_value *buf = mrbc_alloc( vm, sizeof(mrbc_value) * n );
+  if( !buf ) {
+    mrbc_decref( &ret_ary );
+    return -1;
+  }
+  mrbc_value *idx = ret_ary.array->data;
+  for( i = 0; i < n; i++ ) {
+    mrbc_set_integer( &idx[i], i );
+  }
+  array_sort_values( idx, buf, n, v[3].array->data );
+  mrbc_free( vm, buf );
+
+  for( i = 0; i < n; i++ ) {
+    idx[i] = v[2].array->data[ mrbc_integer(idx[i]) ];
+    mrbc_incref( &idx[i] );
+  }
+  ret_ary.array->n_stored = n;
+
+  SET_RETURN( ret_ary );
+  return -1;
+}
+
+static void c_array_sort_by(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+
+  mrbc_value snapshot = mrbc_array_dup( vm, &v[0] );
+  int n = snapshot.array->n_stored;
+  if( n == 0 ) {
+    SET_RETURN( snapshot );
+    return;
+  }
+
+  mrbc_value arg = snapshot.array->data[0];
+  mrbc_incref( &arg );
+  mrbc_value *regs = mrbc_yield( vm, v, 4, &v[1], 1, &arg, array_sort_by_resume );
+  if( !regs ) {
+    mrbc_decref( &snapshot );
+    return;
+  }
+  mrbc_decref_empty( &regs[2] );
+  mrbc_decref_empty( &regs[3] );
+  regs[2] = snapshot;
+  regs[3] = mrbc_array_new( vm, n );
+}
+
+
+//================================================================
+/*! (method) min_by, max_by
+
+  registers
+    v[0] self, v[1] block, v[2] index, v[3] best key, v[4] best value,
+    v[5] block frame.
+*/
+static int array_minmax_by_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret, int sign )
+{
+  int i = mrbc_integer(v[2]);
+  if( i >= mrbc_array_size( &v[0] )) return -1;		// (modified by block)
+
+  if( i == 0 || mrbc_compare( ret, &v[3] ) * sign > 0 ) {
+    mrbc_decref( &v[3] );
+    mrbc_decref( &v[4] );
+    v[3] = *ret;
+    v[4] = mrbc_array_get( &v[0], i );
+    mrbc_incref( &v[3] );
+    mrbc_incref( &v[4] );
+  }
+
+  if( ++i < mrbc_array_size( &v[0] )) {
+    mrbc_set_integer( &v[2], i );
+    v[6] = mrbc_array_get( &v[0], i );
+    mrbc_incref( &v[6] );
+    return 1;
+  }
+
+  SET_RETURN( v[4] );
+  mrbc_set_tt( &v[4], MRBC_TT_EMPTY );
+  return -1;
+}
+
+static int array_min_by_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  return array_minmax_by_resume( vm, v, ret, -1 );
+}
+
+static int array_max_by_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  return array_minmax_by_resume( vm, v, ret, 1 );
+}
+
+static void array_minmax_by( mrbc_vm *vm, mrbc_value v[], int argc, mrbc_resume_func resume )
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+  if( mrbc_array_size( &v[0] ) == 0 ) {
+    SET_NIL_RETURN();
+    return;
+  }
+
+  mrbc_value arg = mrbc_array_get( &v[0], 0 );
+  mrbc_incref( &arg );
+  v = mrbc_yield( vm, v, 5, &v[1], 1, &arg, resume );
+  if( !v ) return;
+  for( int i = 2; i < 5; i++ ) {
+    mrbc_decref( &v[i] );
+    mrbc_set_nil( &v[i] );
+  }
+  mrbc_set_integer( &v[2], 0 );
+}
+
+
+//================================================================
+/*! (method) min_by
+*/
+static void c_array_min_by(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_minmax_by( vm, v, argc, array_min_by_resume );
+}
+
+
+//================================================================
+/*! (method) max_by
+*/
+static void c_array_max_by(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  array_minmax_by( vm, v, argc, array_max_by_resume );
+}
+
+
+//================================================================
+/*! (method) bsearch
+
+  registers
+    v[0] self, v[1] block, v[2] low, v[3] high, v[4] found index,
+    v[5] block frame.
+*/
+static int array_bsearch_resume( mrbc_vm *vm, mrbc_value v[], mrbc_value *ret )
+{
+  int lo = mrbc_integer(v[2]);
+  int hi = mrbc_integer(v[3]);
+  int mid = lo + (hi - lo) / 2;
+  int smaller;
+
+  switch( mrbc_type(*ret) ) {
+  case MRBC_TT_TRUE:
+    mrbc_set_integer( &v[4], mid );
+    smaller = 1;
+    break;
+
+  case MRBC_TT_FALSE:
+  case MRBC_TT_NIL:
+    smaller = 0;
+    break;
+
+  case MRBC_TT_INTEGER:
+    if( mrbc_integer(*ret) == 0 ) goto FOUND;
+    smaller = mrbc_integer(*ret) < 0;
+    break;
+
+#if MRBC_USE_FLOAT
+  case MRBC_TT_FLOAT:
+    if( mrbc_float(*ret) == 0 ) goto FOUND;
+    smaller = mrbc_float(*ret) < 0;
+    break;
+#endif
+
+  default:
+    mrbc_raise(vm, MRBC_CLASS(TypeError), "wrong argument type (must be numeric, true, false or nil)");
+    return -1;
+  }
+
+  if( smaller ) hi = mid; else lo = mid + 1;
+  if( hi > mrbc_array_size( &v[0] )) hi = mrbc_array_size( &v[0] );
+
+  if( lo < hi ) {
+    mrbc_set_integer( &v[2], lo );
+    mrbc_set_integer( &v[3], hi );
+    v[6] = mrbc_array_get( &v[0], lo + (hi - lo) / 2 );
+    mrbc_incref( &v[6] );
+    return 1;
+  }
+
+  mid = mrbc_integer(v[4]);
+  if( mid < 0 || mid >= mrbc_array_size( &v[0] )) {
+    SET_NIL_RETURN();
+    return -1;
+  }
+
+ FOUND:
+  SET_RETURN( mrbc_array_get( &v[0], mid ));
+  mrbc_incref( &v[0] );
+  return -1;
+}
+
+static void c_array_bsearch(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+
+  int n = mrbc_array_size( &v[0] );
+  if( n == 0 ) {
+    SET_NIL_RETURN();
+    return;
+  }
+
+  mrbc_value arg = mrbc_array_get( &v[0], n / 2 );
+  mrbc_incref( &arg );
+  v = mrbc_yield( vm, v, 5, &v[1], 1, &arg, array_bsearch_resume );
+  if( !v ) return;
+  for( int i = 2; i < 5; i++ ) {
+    mrbc_decref_empty( &v[i] );
+  }
+  mrbc_set_integer( &v[2], 0 );
+  mrbc_set_integer( &v[3], n );
+  mrbc_set_integer( &v[4], -1 );
+}
+
+
+//================================================================
+/*! (method) deconstruct
+*/
+static void c_array_deconstruct(struct VM *vm, mrbc_value v[], int argc)
+{
+  // Check argument count (must have no arguments)
+  if (argc != 0) {
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "wrong number of arguments");
+    return;
+  }
+  // For pattern matching - return self (not a copy)
+  // (already an array, no conversion needed)
+}
+
+
+#if MRBC_USE_STRING
+//================================================================
+/*! estimate the length of joined string, to presize the result.
+
+  @param  src		pointer to target array.
+  @param  sep_len	length of separator.
+  @return		estimated length.
+*/
+static int array_join_size(const mrbc_value *src, int sep_len)
+{
+  int n = mrbc_array_size(src);
+  int size = (n > 1) ? sep_len * (n - 1) : 0;
+
+  for( int i = 0; i < n; i++ ) {
+    const mrbc_value *v1 = &src->array->data[i];
+    switch( mrbc_type(*v1) ) {
+    case MRBC_TT_STRING: size += mrbc_string_size(v1);		break;
+    case MRBC_TT_ARRAY:  size += array_join_size(v1, sep_len);	break;
+    default:		 size += 4;	// e.g. small numbers.
+    }
+  }
+
+  return size;
+}
+
+
+//================================================================
+/*! (method) inspect, to_s
+*/
+static void c_array_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( mrbc_type(v[0]) == MRBC_TT_CLASS ) {
+    mrbc_object_inspect(vm, v, argc);
+    return;
+  }
+
+  mrbc_value ret = mrbc_string_new_cstr(vm, "[");
+  mrbc_string_reserve( &ret, array_join_size(v, 2) + 2 );
+
+  for( int i = 0; i < mrbc_array_size(v); i++ ) {
+    if( i != 0 ) mrbc_string_append_cstr( &ret, ", " );
+
+    mrbc_value v1 = mrbc_array_get(v, i);
+    mrbc_value s1 = mrbc_send( vm, v, argc, &v1, "inspect", 0 );
+    if( mrbc_israised(vm) ) {
+      mrbc_string_delete( &ret );
+      return;
+    }
+    mrbc_string_append( &ret, &s1 );
+    mrbc_string_delete( &s1 );
+  }
+
+  mrbc_string_append_cstr( &ret, "]" );
+
+  SET_RETURN(ret);
+}
+
+
+//================================================================
+/*! (method) join
+*/
+static void c_array_join_1(mrbc_vm *vm, mrbc_value v[], int argc,
+                           mrbc_value *src, mrbc_value *ret, mrbc_value *separator)
+{
+  if( mrbc_array_size(src) == 0 ) return;
+
+  int i = 0;
+  int flag_error = 0;
+  while( !flag_error ) {
+    if( mrbc_type(src->array->data[i]) == MRBC_TT_ARRAY ) {
+      c_array_join_1(vm, v, argc, &src->array->data[i], ret, separator);
+    } else {
+      mrbc_value v1 = mrbc_send( vm, v, argc, &src->array->data[i], "to_s", 0 );
+      flag_error |= mrbc_string_append( ret, &v1 );
+      mrbc_decref(&v1);
+    }
+    if( mrbc_israised(vm) ) break;
+    if( ++i >= mrbc_array_size(src) ) break;	// normal return.
+    flag_error |= mrbc_string_append( ret, separator );
+  }
+}
+
+static void c_array_join(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  mrbc_value ret = mrbc_string_new(vm, NULL, 0);
+  mrbc_value separator = (argc == 0) ? mrbc_string_new_cstr(vm, "") :
+    mrbc_send( vm, v, argc, &v[1], "to_s", 0 );
+
+  if( mrbc_type(separator) == MRBC_TT_STRING ) {
+    mrbc_string_reserve( &ret,
+		array_join_size(&v[0], mrbc_string_size(&separator)) );
+  }
+
+  c_array_join_1(vm, v, argc, &v[0], &ret, &separator );
+  mrbc_decref(&separator);
+  if( mrbc_israised(vm) ) {
+    mrbc_string_delete( &ret );
+    return;
+  }
 
   SET_RETURN(ret);
 }
@@ -1357,7 +2876,6 @@ static void c_array_join(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD( "empty?",	c_array_empty )
   METHOD( "size",	c_array_size )
   METHOD( "length",	c_array_size )
-  METHOD( "count",	c_array_size )
   METHOD( "include?",	c_array_include )
   METHOD( "&",		c_array_and )
   METHOD( "|",		c_array_or )
@@ -1375,6 +2893,41 @@ static void c_array_join(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD( "uniq!",	c_array_uniq_self )
   METHOD( "reverse",	c_array_reverse )
   METHOD( "reverse!",	c_array_reverse_self )
+  METHOD( "each",	c_array_each )
+  METHOD( "each_with_index", c_array_each_with_index )
+  METHOD( "collect",	c_array_collect )
+  METHOD( "map",	c_array_collect )
+  METHOD( "collect!",	c_array_collect_self )
+  METHOD( "map!",	c_array_collect_self )
+  METHOD( "flat_map",	c_array_flat_map )
+  METHOD( "collect_concat", c_array_flat_map )
+  METHOD( "select",	c_array_select )
+  METHOD( "filter",	c_array_select )
+  METHOD( "reject",	c_array_reject )
+  METHOD( "delete_if",	c_array_delete_if )
+  METHOD( "reject!",	c_array_reject_self )
+  METHOD( "select!",	c_array_select_self )
+  METHOD( "filter!",	c_array_select_self )
+  METHOD( "index",	c_array_index )
+  METHOD( "find_index",	c_array_index )
+  METHOD( "find",	c_array_find )
+  METHOD( "detect",	c_array_find )
+  METHOD( "all?",	c_array_all )
+  METHOD( "any?",	c_array_any )
+  METHOD( "none?",	c_array_none )
+  METHOD( "count",	c_array_count )
+  METHOD( "inject",	c_array_inject )
+  METHOD( "reduce",	c_array_inject )
+  METHOD( "sum",	c_array_sum )
+  METHOD( "each_slice",	c_array_each_slice )
+  METHOD( "each_cons",	c_array_each_cons )
+  METHOD( "zip",	c_array_zip )
+  METHOD( "sort!",	c_array_sort_self )
+  METHOD( "sort",	c_array_sort )
+  METHOD( "sort_by",	c_array_sort_by )
+  METHOD( "min_by",	c_array_min_by )
+  METHOD( "max_by",	c_array_max_by )
+  METHOD( "bsearch",	c_array_bsearch )
 
 #if MRBC_USE_STRING
   METHOD( "inspect",	c_array_inspect )
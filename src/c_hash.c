@@ -41,6 +41,7 @@
     mrbc_hash_size()
     mrbc_hash_resize()
     mrbc_hash_clear()
+    mrbc_hash_reindex()
     mrbc_hash_compare()
     mrbc_hash_dup()
 
@@ -66,6 +67,174 @@
 /***** Global variables *****************************************************/
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+//================================================================
+/*! mix the bits of the integer.
+*/
+static inline uint32_t hash_mix(uint32_t x)
+{
+  x ^= x >> 16;
+  x *= 0x45d9f3b;
+  x ^= x >> 16;
+  return x;
+}
+
+
+//================================================================
+/*! hash function for the key.
+
+  The keys that mrbc_compare() regards as equal have the same hash value.
+
+  @param  key	pointer to key value.
+  @return	hash value.
+*/
+static uint32_t hash_key_hash(const mrbc_value *key)
+{
+  switch( mrbc_type(*key) ) {
+  case MRBC_TT_INTEGER: {
+    uint64_t i = (uint64_t)mrbc_integer(*key);
+    return hash_mix( (uint32_t)i ^ (uint32_t)(i >> 32) );
+  }
+
+  case MRBC_TT_SYMBOL:
+    return hash_mix( mrbc_symbol(*key) );
+
+#if MRBC_USE_FLOAT
+  case MRBC_TT_FLOAT: {
+    mrbc_float_t d = mrbc_float(*key);
+    const mrbc_float_t limit = (mrbc_float_t)((mrbc_int_t)1 << (sizeof(mrbc_int_t) * 8 - 2)) * 2;
+
+    // same as Integer, if it has an integer value. (1 == 1.0)
+    if( -limit <= d && d < limit && d == (mrbc_int_t)d ) {
+      mrbc_value v = mrbc_integer_value( (mrbc_int_t)d );
+      return hash_key_hash( &v );
+    }
+
+    uint32_t w[(sizeof(d) + 3) / 4] = {0};
+    memcpy( w, &d, sizeof(d) );
+    uint32_t h = 0;
+    for( int i = 0; i < sizeof(w) / 4; i++ ) h ^= w[i];
+    return hash_mix( h );
+  }
+#endif
+
+#if MRBC_USE_STRING
+  case MRBC_TT_STRING:
+    return mrbc_string_hash(key);	// cached in the string.
+#endif
+
+  case MRBC_TT_CLASS:
+  case MRBC_TT_MODULE:
+  case MRBC_TT_OBJECT:
+  case MRBC_TT_PROC:
+    return hash_mix( (uint32_t)((uintptr_t)key->cls >> 2) );
+
+  case MRBC_TT_EMPTY:
+    return MRBC_TT_NIL;
+
+  default:
+    return mrbc_type(*key);	// compared by contents.
+  }
+}
+
+
+//================================================================
+/*! add the pair to the index.
+
+  @param  h	pointer to hash.
+  @param  n	pair number. (index of data / 2)
+*/
+static void hash_index_add(mrbc_hash *h, int n)
+{
+  int i = hash_key_hash( &h->data[n * 2] ) & h->index_mask;
+
+  while( h->index[i] ) {
+    i = (i + 1) & h->index_mask;
+  }
+  h->index[i] = n + 1;
+}
+
+
+//================================================================
+/*! (re)build the index.
+
+  @param  h	pointer to hash.
+  @note	  The index stays NULL, if it can not be allocated.
+*/
+static void hash_index_build(mrbc_hash *h)
+{
+  int n = h->n_stored / 2;
+  int size = 16;
+  while( size < n * 2 ) size *= 2;
+
+  if( h->index ) mrbc_raw_free( h->index );
+  h->index = mrbc_raw_calloc( size, sizeof(uint16_t) );
+  if( !h->index ) return;
+
+  h->index_mask = size - 1;
+  for( int i = 0; i < n; i++ ) {
+    hash_index_add( h, i );
+  }
+}
+
+
+//================================================================
+/*! find the slot of the key.
+
+  @param  h	pointer to hash.
+  @param  key	pointer to key value.
+  @return	pointer to found key or NULL(not found).
+*/
+static mrbc_value * hash_index_search(const mrbc_hash *h, const mrbc_value *key)
+{
+  int i = hash_key_hash( key ) & h->index_mask;
+
+  while( h->index[i] ) {
+    mrbc_value *p = &h->data[(h->index[i] - 1) * 2];
+    if( mrbc_equal(p, key) ) return p;
+    i = (i + 1) & h->index_mask;
+  }
+
+  return NULL;
+}
+
+
+//================================================================
+/*! remove the pair from the index, before removing it from data.
+
+  @param  h	pointer to hash.
+  @param  n	pair number. (index of data / 2)
+*/
+static void hash_index_remove(mrbc_hash *h, int n)
+{
+  int mask = h->index_mask;
+  int i = hash_key_hash( &h->data[n * 2] ) & mask;
+
+  while( h->index[i] != n + 1 ) {
+    i = (i + 1) & mask;
+  }
+
+  // move back the following slots in the same chain. (backward shift)
+  h->index[i] = 0;
+  for( int j = (i + 1) & mask; h->index[j]; j = (j + 1) & mask ) {
+    int k = hash_key_hash( &h->data[(h->index[j] - 1) * 2] ) & mask;
+
+    // stays, if its home slot k is cyclically in (i, j].
+    if( (i <= j) ? (i < k && k <= j) : (i < k || k <= j) ) continue;
+
+    h->index[i] = h->index[j];
+    h->index[j] = 0;
+    i = j;
+  }
+
+  // the following pairs will be moved forward by one.
+  for( i = 0; i <= mask; i++ ) {
+    if( h->index[i] > n + 1 ) h->index[i]--;
+  }
+}
+#endif
+
+
 /***** Global functions *****************************************************/
 
 //================================================================
@@ -99,8 +268,7 @@ mrbc_value mrbc_hash_new(mrbc_vm *vm, int size)
 */
 void mrbc_hash_delete(mrbc_value *hash)
 {
-  // TODO: delete other members (for search).
-
+  mrbc_hash_reindex(hash);
   mrbc_array_delete(hash);
 }
 
@@ -114,11 +282,19 @@ void mrbc_hash_delete(mrbc_value *hash)
 */
 mrbc_value * mrbc_hash_search(const mrbc_value *hash, const mrbc_value *key)
 {
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+  mrbc_hash *h = hash->hash;
+  if( !h->index && h->n_stored > MRBC_HASH_INDEX_THRESHOLD * 2 ) {
+    hash_index_build( h );
+  }
+  if( h->index ) return hash_index_search( h, key );
+#endif
+
   mrbc_value *p1 = hash->hash->data;
   const mrbc_value *p2 = p1 + hash->hash->n_stored;
 
   while( p1 < p2 ) {
-    if( mrbc_compare(p1, key) == 0 ) return p1;
+    if( mrbc_equal(p1, key) ) return p1;
     p1 += 2;
   }
 
@@ -136,6 +312,13 @@ mrbc_value * mrbc_hash_search(const mrbc_value *hash, const mrbc_value *key)
 */
 mrbc_value * mrbc_hash_search_by_id(const mrbc_value *hash, mrbc_sym sym_id)
 {
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+  if( hash->hash->index ) {
+    mrbc_value key = mrbc_symbol_value(sym_id);
+    return hash_index_search( hash->hash, &key );
+  }
+#endif
+
   mrbc_value *p1 = hash->hash->data;
   const mrbc_value *p2 = p1 + hash->hash->n_stored;
 
@@ -153,8 +336,8 @@ mrbc_value * mrbc_hash_search_by_id(const mrbc_value *hash, mrbc_sym sym_id)
 /*! setter
 
   @param  hash	pointer to target hash
-  @param  key	pointer to key value
-  @param  val	pointer to value
+  @param  key	pointer to key value (moved)
+  @param  val	pointer to value (moved)
   @return	mrbc_error_code
 */
 int mrbc_hash_set(mrbc_value *hash, mrbc_value *key, mrbc_value *val)
@@ -162,14 +345,33 @@ int mrbc_hash_set(mrbc_value *hash, mrbc_value *key, mrbc_value *val)
   mrbc_value *v = mrbc_hash_search(hash, key);
   int ret = 0;
   if( v == NULL ) {
+    // copy the String key that is referred from others, so that
+    // modifying it does not change the key. (CRuby also copies it)
+    mrbc_value k = *key;
+    if( mrbc_type(k) == MRBC_TT_STRING && k.string->ref_count > 1 ) {
+      k = mrbc_string_dup( 0, key );
+      if( mrbc_type(k) != MRBC_TT_STRING ) return E_NOMEMORY_ERROR;
+      mrbc_decref( key );
+    }
+
     // set a new value
-    if( (ret = mrbc_array_push(hash, key)) != 0 ) goto RETURN;
+    if( (ret = mrbc_array_push(hash, &k)) != 0 ) goto RETURN;
     ret = mrbc_array_push(hash, val);
 
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+    mrbc_hash *h = hash->hash;
+    if( h->index ) {
+      if( h->n_stored > h->index_mask + 1 ) {
+        hash_index_build( h );		// keep the load factor <= 1/2.
+      } else {
+        hash_index_add( h, h->n_stored / 2 - 1 );
+      }
+    }
+#endif
+
   } else {
-    // replace a value
-    mrbc_decref(v);
-    *v = *key;
+    // replace a value, and keep the key.
+    mrbc_decref(key);
     mrbc_decref(++v);
     *v = *val;
   }
@@ -219,16 +421,18 @@ mrbc_value mrbc_hash_remove(mrbc_value *hash, const mrbc_value *key)
   mrbc_value *v = mrbc_hash_search(hash, key);
   if( v == NULL ) return mrbc_nil_value();
 
+  mrbc_hash *h = hash->hash;
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+  if( h->index ) hash_index_remove( h, (v - h->data) / 2 );
+#endif
+
   mrbc_decref(v);		// key
   mrbc_value val = v[1];	// value
 
-  mrbc_hash *h = hash->hash;
   h->n_stored -= 2;
 
   memmove(v, v+2, (char*)(h->data + h->n_stored) - (char*)v);
 
-  // TODO: re-index hash table if need.
-
   return val;
 }
 
@@ -250,12 +454,14 @@ mrbc_value mrbc_hash_remove_by_id(mrbc_value *hash, mrbc_sym sym_id)
   mrbc_value val = v[1];	// value
 
   mrbc_hash *h = hash->hash;
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+  if( h->index ) hash_index_remove( h, (v - h->data) / 2 );
+#endif
+
   h->n_stored -= 2;
 
   memmove(v, v+2, (char*)(h->data + h->n_stored) - (char*)v);
 
-  // TODO: re-index hash table if need.
-
   return val;
 }
 
@@ -268,8 +474,25 @@ mrbc_value mrbc_hash_remove_by_id(mrbc_value *hash, mrbc_sym sym_id)
 void mrbc_hash_clear(mrbc_value *hash)
 {
   mrbc_array_clear(hash);
+  mrbc_hash_reindex(hash);
+}
+
 
-  // TODO: re-index hash table if need.
+//================================================================
+/*! discard the index, after the pairs are stored directly.
+
+  The index will be rebuilt by the next search, if needed.
+
+  @param  hash	pointer to target hash
+*/
+void mrbc_hash_reindex(mrbc_value *hash)
+{
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+  if( !hash->hash->index ) return;
+
+  mrbc_raw_free( hash->hash->index );
+  hash->hash->index = NULL;
+#endif
 }
 
 
@@ -316,8 +539,6 @@ mrbc_value mrbc_hash_dup( mrbc_vm *vm, mrbc_value *src )
     mrbc_incref(p1++);
   }
 
-  // TODO: dup other members.
-
   return ret;
 }
 
@@ -452,9 +673,9 @@ static void c_hash_except_keys(mrbc_vm *vm, mrbc_value v[], int argc)
       }
     }
     if( !found ) {
-      mrbc_hash_set(&result, &kv[0], &kv[1]);
       mrbc_incref(&kv[0]);
       mrbc_incref(&kv[1]);
+      mrbc_hash_set(&result, &kv[0], &kv[1]);
     }
   }
 
@@ -482,12 +703,56 @@ static void c_hash_delete(mrbc_vm *vm, mrbc_value v[], int argc)
 
   mrbc_value ret = mrbc_hash_remove(v, v+1);
 
-  // TODO: re-index hash table if need.
-
   SET_RETURN(ret);
 }
 
 
+//================================================================
+/*! (method) each
+
+  registers
+    v[0] self, v[1] block, v[2] index, v[3] block frame.
+*/
+static mrbc_value hash_each_pair(mrbc_vm *vm, mrbc_value *hash, int i)
+{
+  mrbc_value pair = mrbc_array_new( vm, 2 );
+  mrbc_value *kv = hash->hash->data + i * 2;
+
+  mrbc_incref( &kv[0] );
+  mrbc_incref( &kv[1] );
+  mrbc_array_push( &pair, &kv[0] );
+  mrbc_array_push( &pair, &kv[1] );
+
+  return pair;
+}
+
+static int hash_each_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  int i = mrbc_integer(v[2]) + 1;
+  if( i >= mrbc_hash_size(&v[0]) ) return -1;	// finished, and returns self.
+
+  mrbc_set_integer( &v[2], i );
+  v[4] = hash_each_pair( vm, &v[0], i );
+  return 1;
+}
+
+static void c_hash_each(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+  if( mrbc_hash_size(&v[0]) == 0 ) return;
+
+  mrbc_value arg = hash_each_pair( vm, &v[0], 0 );
+  v = mrbc_yield( vm, v, 3, &v[1], 1, &arg, hash_each_resume );
+  if( !v ) return;
+
+  mrbc_decref_empty( &v[2] );
+  mrbc_set_integer( &v[2], 0 );
+}
+
+
 //================================================================
 /*! (method) empty?
 */
@@ -594,9 +859,9 @@ static void c_hash_merge(mrbc_vm *vm, mrbc_value v[], int argc)
 
   while( mrbc_hash_i_has_next(&ite) ) {
     mrbc_value *kv = mrbc_hash_i_next(&ite);
-    mrbc_hash_set( &ret, &kv[0], &kv[1] );
     mrbc_incref( &kv[0] );
     mrbc_incref( &kv[1] );
+    mrbc_hash_set( &ret, &kv[0], &kv[1] );
   }
 
   SET_RETURN(ret);
@@ -612,9 +877,9 @@ static void c_hash_merge_self(mrbc_vm *vm, mrbc_value v[], int argc)
 
   while( mrbc_hash_i_has_next(&ite) ) {
     mrbc_value *kv = mrbc_hash_i_next(&ite);
-    mrbc_hash_set( v, &kv[0], &kv[1] );
     mrbc_incref( &kv[0] );
     mrbc_incref( &kv[1] );
+    mrbc_hash_set( v, &kv[0], &kv[1] );
   }
 }
 
@@ -679,6 +944,7 @@ static void c_hash_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
   }
 
   mrbc_value ret = mrbc_string_new_cstr(vm, "{");
+  mrbc_string_reserve( &ret, mrbc_hash_size(v) * 12 + 2 );	// estimate.
   mrbc_hash_iterator ite = mrbc_hash_iterator_new(v);
   int flag_first = 1;
 
@@ -694,16 +960,22 @@ static void c_hash_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
       mrbc_string_append_cstr( &ret, ": " );
     } else {
       s1 = mrbc_send( vm, v, argc, &kv[0], "inspect", 0 );
+      if( mrbc_israised(vm) ) break;
       mrbc_string_append( &ret, &s1 );
       mrbc_string_delete( &s1 );
       mrbc_string_append_cstr( &ret, " => " );
     }
 
     s1 = mrbc_send( vm, v, argc, &kv[1], "inspect", 0 );
+    if( mrbc_israised(vm) ) break;
     mrbc_string_append( &ret, &s1 );
     mrbc_string_delete( &s1 );
   }
 
+  if( mrbc_israised(vm) ) {
+    mrbc_string_delete( &ret );
+    return;
+  }
   mrbc_string_append_cstr( &ret, "}" );
 
   SET_RETURN(ret);
@@ -726,6 +998,7 @@ static void c_hash_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD( "deconstruct_keys", c_hash_deconstruct_keys )
   METHOD( "dup",	c_hash_dup )
   METHOD( "delete",	c_hash_delete )
+  METHOD( "each",	c_hash_each )
   METHOD( "empty?",	c_hash_empty )
   METHOD( "fetch",	c_hash_fetch )
   METHOD( "has_key?",	c_hash_has_key )
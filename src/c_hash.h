@@ -48,7 +48,10 @@ typedef struct RHash {
   uint16_t n_stored;	//!< num of stored.
   mrbc_value *data;	//!< pointer to allocated memory.
 
-  // TODO: and other member for search.
+#if MRBC_HASH_INDEX_THRESHOLD > 0
+  uint16_t *index;	//!< slots of pair number + 1 (0: empty) or NULL.
+  uint16_t index_mask;	//!< num of slots - 1.
+#endif
 
 } mrbc_hash;
 
@@ -77,6 +80,7 @@ mrbc_value *mrbc_hash_get_p(const mrbc_value *hash, const mrbc_value *key);
 mrbc_value mrbc_hash_remove(mrbc_value *hash, const mrbc_value *key);
 mrbc_value mrbc_hash_remove_by_id(mrbc_value *hash, mrbc_sym sym_id);
 void mrbc_hash_clear(mrbc_value *hash);
+void mrbc_hash_reindex(mrbc_value *hash);
 int mrbc_hash_compare(const mrbc_value *v1, const mrbc_value *v2);
 mrbc_value mrbc_hash_dup(mrbc_vm *vm, mrbc_value *src);
 //@endcond
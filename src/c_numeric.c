@@ -290,6 +290,127 @@ static void c_numeric_clamp(mrbc_vm *vm, mrbc_value v[], int argc)
 }
 
 
+//================================================================
+/*! (method) times, upto, downto
+
+  registers
+    v[0] self, v[1] limit (upto, downto), v[argc+1] block,
+    v[3] counter, v[4] limit, v[5] step, v[6] block frame.
+*/
+static int integer_each_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  mrbc_int_t i = mrbc_integer(v[3]);
+  if( i == mrbc_integer(v[4]) ) return -1;	// finished, and returns self.
+
+  i += mrbc_integer(v[5]);
+  mrbc_set_integer( &v[3], i );
+  mrbc_set_integer( &v[7], i );
+  return 1;
+}
+
+static void integer_each(mrbc_vm *vm, mrbc_value v[], int argc, mrbc_int_t i, mrbc_int_t lim, int step)
+{
+  if( step > 0 ? i > lim : i < lim ) return;
+
+  mrbc_value arg = mrbc_integer_value(i);
+  v = mrbc_yield( vm, v, 6, &v[argc+1], 1, &arg, integer_each_resume );
+  if( !v ) return;
+
+  for( int j = 3; j < 6; j++ ) {
+    mrbc_decref_empty( &v[j] );
+  }
+  mrbc_set_integer( &v[3], i );
+  mrbc_set_integer( &v[4], lim );
+  mrbc_set_integer( &v[5], step );
+}
+
+
+//================================================================
+/*! get the limit of upto and downto.
+
+  @param  vm	pointer to VM.
+  @param  v	limit value.
+  @param  dir	1: upto, -1: downto.
+  @param  lim	returns the limit.
+  @return	0 if success.
+*/
+static int integer_each_limit(mrbc_vm *vm, const mrbc_value *v, int dir, mrbc_int_t *lim)
+{
+  switch( mrbc_type(*v) ) {
+  case MRBC_TT_INTEGER:
+    *lim = mrbc_integer(*v);
+    return 0;
+
+#if MRBC_USE_FLOAT
+  case MRBC_TT_FLOAT: {
+    // (floor or ceil without libm)
+    mrbc_float_t d = mrbc_float(*v);
+    *lim = (mrbc_int_t)d;
+    if( dir > 0 && *lim > d ) (*lim)--;
+    if( dir < 0 && *lim < d ) (*lim)++;
+  } return 0;
+#endif
+
+  default:
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "comparison failed");
+    return -1;
+  }
+}
+
+
+//================================================================
+/*! (method) times
+*/
+static void c_integer_times(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+  integer_each( vm, v, argc, 0, mrbc_integer(v[0]) - 1, 1 );
+}
+
+
+//================================================================
+/*! (method) upto
+*/
+static void c_integer_upto(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+  if( argc != 1 ) {
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "wrong number of arguments");
+    return;
+  }
+  mrbc_int_t lim;
+  if( integer_each_limit( vm, &v[1], 1, &lim ) != 0 ) return;
+
+  integer_each( vm, v, argc, mrbc_integer(v[0]), lim, 1 );
+}
+
+
+//================================================================
+/*! (method) downto
+*/
+static void c_integer_downto(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+  if( argc != 1 ) {
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "wrong number of arguments");
+    return;
+  }
+  mrbc_int_t lim;
+  if( integer_each_limit( vm, &v[1], -1, &lim ) != 0 ) return;
+
+  integer_each( vm, v, argc, mrbc_integer(v[0]), lim, -1 );
+}
+
+
 #if MRBC_USE_FLOAT
 //================================================================
 /*! (method) to_f
@@ -435,6 +556,9 @@ static void c_integer_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD( "abs",	c_integer_abs )
   METHOD( "to_i",	c_ineffect )
   METHOD( "clamp",	c_numeric_clamp )
+  METHOD( "times",	c_integer_times )
+  METHOD( "upto",	c_integer_upto )
+  METHOD( "downto",	c_integer_downto )
 #if MRBC_USE_FLOAT
   METHOD( "to_f",	c_integer_to_f )
 #endif
@@ -76,6 +76,7 @@ void mrbc_instance_call_initialize( mrbc_vm *vm, mrbc_value v[], int argc )
 
   mrbc_callinfo *callinfo = mrbc_push_callinfo(vm, MRBC_SYM(initialize),
                                                (v - vm->cur_regs), argc);
+  if( !callinfo ) return;
   callinfo->own_class = method.cls;
 
   vm->cur_irep = method.irep;
@@ -137,8 +138,8 @@ static void c_object_not(mrbc_vm *vm, mrbc_value v[], int argc)
  */
 static void c_object_neq(mrbc_vm *vm, mrbc_value v[], int argc)
 {
-  int result = mrbc_compare( &v[0], &v[1] );
-  SET_BOOL_RETURN( result != 0 );
+  int result = mrbc_equal( &v[0], &v[1] );
+  SET_BOOL_RETURN( !result );
 }
 
 
@@ -157,8 +158,8 @@ static void c_object_compare(mrbc_vm *vm, mrbc_value v[], int argc)
  */
 static void c_object_equal2(mrbc_vm *vm, mrbc_value v[], int argc)
 {
-  int result = mrbc_compare( &v[0], &v[1] );
-  SET_BOOL_RETURN( result == 0 );
+  int result = mrbc_equal( &v[0], &v[1] );
+  SET_BOOL_RETURN( result );
 }
 
 
@@ -199,7 +200,7 @@ static void c_object_dup(mrbc_vm *vm, mrbc_value v[], int argc)
 {
   if( mrbc_type(v[0]) == MRBC_TT_OBJECT ) {
     mrbc_value new_obj = mrbc_instance_new(vm, v->instance->cls, 0);
-    mrbc_kv_dup( &v->instance->ivar, &new_obj.instance->ivar );
+    mrbc_instance_dup_ivar( v->instance, new_obj.instance );
 
     mrbc_decref( v );
     *v = new_obj;
@@ -285,6 +286,7 @@ static void c_object_p(mrbc_vm *vm, mrbc_value v[], int argc)
     }
     SET_RETURN(value);
   }
+  mrbc_flush();
 }
 #endif
 
@@ -298,6 +300,7 @@ static void c_object_print(mrbc_vm *vm, mrbc_value v[], int argc)
   for( int i = 1; i <= argc; i++ ) {
     mrbc_print_sub( &v[i] );
   }
+  mrbc_flush();
   SET_NIL_RETURN();
 }
 #endif
@@ -316,11 +319,25 @@ static void c_object_puts(mrbc_vm *vm, mrbc_value v[], int argc)
   } else {
     mrbc_putchar('\n');
   }
+  mrbc_flush();
   SET_NIL_RETURN();
 }
 #endif
 
 
+//================================================================
+/*! (method) flush
+
+  Write out the buffered console output.
+ */
+#if !defined(MRBC_NO_STDIO)
+static void c_object_flush(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  mrbc_flush();
+}
+#endif
+
+
 //================================================================
 /*! (method) raise
 
@@ -446,14 +463,19 @@ static void c_object_instance_variables(mrbc_vm *vm, mrbc_value v[], int argc)
   // temporary code for operation check.
 
   mrbc_value ret = mrbc_array_new( vm, 0 );
-  mrbc_kv_handle *kvh = &v[0].instance->ivar;
-#if 0
-  mrbc_printf("n = %d/%d ", kvh->n_stored, kvh->data_size);
-#endif
 
-  if( mrbc_type(v[0]) == MRBC_TT_OBJECT ) {
-    for( int i = 0; i < kvh->n_stored; i++ ) {
-      mrbc_array_push( &ret, &mrbc_symbol_value(kvh->data[i].sym_id) );
+  if( mrbc_type(v[0]) == MRBC_TT_OBJECT &&
+      v[0].instance->shape == &mrbc_kv_shape ) {
+    mrbc_kv_iterator ite = mrbc_kv_iterator_new( v[0].instance->ivar_kv );
+    while( mrbc_kv_i_has_next( &ite ) ) {
+      mrbc_kv *kv = mrbc_kv_i_next( &ite );
+      mrbc_array_push( &ret, &mrbc_symbol_value(kv->sym_id) );
+    }
+
+  } else if( mrbc_type(v[0]) == MRBC_TT_OBJECT ) {
+    const mrbc_shape *shape = v[0].instance->shape;
+    for( ; shape->num_ivar != 0; shape = shape->parent ) {
+      mrbc_array_set( &ret, shape->num_ivar - 1, &mrbc_symbol_value(shape->sym_id) );
     }
   }
 
@@ -618,6 +640,8 @@ static void c_object_include(mrbc_vm *vm, mrbc_value v[], int argc)
 #endif
     };
     self->super = alias;
+    mrbc_clear_method_cache();
+    mrbc_const_epoch++;		// constants are also searched in modules.
   }
 }
 
@@ -669,7 +693,11 @@ static void c_object_sprintf(mrbc_vm *vm, mrbc_value v[], int argc)
     return;
   }
 
-  int buflen = BUF_INC_STEP;
+  // presize the buffer by the lengths of format and string arguments.
+  int buflen = mrbc_string_size(format) + BUF_INC_STEP;
+  for( int j = 2; j <= argc; j++ ) {
+    if( mrbc_type(v[j]) == MRBC_TT_STRING ) buflen += mrbc_string_size(&v[j]);
+  }
   char *buf = mrbc_alloc(vm, buflen);
   mrbc_printf_t pf;
   mrbc_printf_init( &pf, buf, buflen, mrbc_string_cstr(format) );
@@ -775,7 +803,7 @@ static void c_object_sprintf(mrbc_vm *vm, mrbc_value v[], int argc)
     pf = pf_bak;
 
   INCREASE_BUFFER:
-    buflen += BUF_INC_STEP;
+    buflen += buflen / 2 + BUF_INC_STEP;
     buf = mrbc_realloc(vm, pf.buf, buflen);
     mrbc_printf_replace_buffer(&pf, buf, buflen);
   }
@@ -800,6 +828,7 @@ static void c_object_printf(mrbc_vm *vm, mrbc_value v[], int argc)
 {
   c_object_sprintf(vm, v, argc);
   mrbc_nprint( mrbc_string_cstr(v), mrbc_string_size(v) );
+  mrbc_flush();
   SET_NIL_RETURN();
 }
 #endif
@@ -836,6 +865,7 @@ static void c_object_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD( "p",		c_object_p )
   METHOD( "print",	c_object_print )
   METHOD( "puts",	c_object_puts )
+  METHOD( "flush",	c_object_flush )
 #endif
   METHOD( "raise",	c_object_raise )
   METHOD( "attr_reader",c_object_attr_reader )
@@ -148,6 +148,81 @@ static void c_range_exclude_end(mrbc_vm *vm, mrbc_value v[], int argc)
 
 
 
+//================================================================
+/*! (method) each
+
+  registers
+    v[0] self, v[1] block, v[2] counter, v[3] limit (nil if endless),
+    v[4] block frame.
+*/
+static int range_each_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  mrbc_int_t i = mrbc_integer(v[2]);
+  if( mrbc_type(v[3]) == MRBC_TT_INTEGER && i == mrbc_integer(v[3]) ) {
+    return -1;		// finished, and returns self.
+  }
+
+  mrbc_set_integer( &v[2], ++i );
+  mrbc_set_integer( &v[5], i );
+  return 1;
+}
+
+static void c_range_each(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+
+  const mrbc_range *range = v[0].range;
+  if( mrbc_type(range->first) != MRBC_TT_INTEGER ) {
+    mrbc_raisef(vm, MRBC_CLASS(TypeError), "can't iterate from %s",
+                mrbc_symid_to_str( mrbc_find_class_by_object(&range->first)->sym_id ));
+    return;
+  }
+
+  mrbc_int_t i = mrbc_integer(range->first);
+  mrbc_value lim;
+  switch( mrbc_type(range->last) ) {
+  case MRBC_TT_INTEGER:
+    lim = mrbc_integer_value( mrbc_integer(range->last) - range->flag_exclude );
+    break;
+
+#if MRBC_USE_FLOAT
+  case MRBC_TT_FLOAT: {
+    // (floor or ceil - 1 without libm)
+    mrbc_float_t d = mrbc_float(range->last);
+    mrbc_int_t n = (mrbc_int_t)d;
+    if( range->flag_exclude ) {
+      if( n >= d ) n--;
+    } else {
+      if( n > d ) n--;
+    }
+    lim = mrbc_integer_value( n );
+  } break;
+#endif
+
+  case MRBC_TT_NIL:
+    lim = mrbc_nil_value();
+    break;
+
+  default:
+    mrbc_raise(vm, MRBC_CLASS(ArgumentError), "bad value for range");
+    return;
+  }
+  if( mrbc_type(lim) == MRBC_TT_INTEGER && i > mrbc_integer(lim) ) return;
+
+  mrbc_value arg = mrbc_integer_value(i);
+  v = mrbc_yield( vm, v, 4, &v[1], 1, &arg, range_each_resume );
+  if( !v ) return;
+
+  mrbc_decref_empty( &v[2] );
+  mrbc_decref_empty( &v[3] );
+  mrbc_set_integer( &v[2], i );
+  v[3] = lim;
+}
+
+
 #if MRBC_USE_STRING
 //================================================================
 /*! (method) inspect, to_s
@@ -165,6 +240,10 @@ static void c_range_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
     if( i != 0 ) mrbc_string_append_cstr( &ret, ".." );
     mrbc_value v1 = (i == 0) ? mrbc_range_first(v) : mrbc_range_last(v);
     mrbc_value s1 = mrbc_send( vm, v, argc, &v1, "inspect", 0 );
+    if( mrbc_israised(vm) ) {
+      mrbc_string_delete( &ret );
+      return;
+    }
     mrbc_string_append( &ret, &s1 );
     mrbc_string_delete( &s1 );
   }
@@ -183,6 +262,7 @@ static void c_range_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD("first",	c_range_first )
   METHOD("last",	c_range_last )
   METHOD("exclude_end?", c_range_exclude_end )
+  METHOD("each",	c_range_each )
 #if MRBC_USE_STRING
   METHOD("inspect",	c_range_inspect )
   METHOD("to_s",	c_range_inspect )
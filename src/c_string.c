@@ -27,7 +27,22 @@
 #include "_autogen_unicode_case.h"
 
 /***** Constat values *******************************************************/
+// minimum pattern length searched with a skip table.
+#define STRING_SEARCH_SKIP_MIN	8
+
+// minimum string length that tr translates with a table.
+#define STRING_TR_MAP_MIN	64
+
 /***** Macros ***************************************************************/
+#if MRBC_USE_SHARED_SUBSTRING
+// A String object has room for a pointer after it, to hold the parent of
+// a shared substring.
+# define STRING_SLOT_SIZE	sizeof(mrbc_string *)
+# define STRING_PARENT(h)	(*(mrbc_string **)((h) + 1))
+#else
+# define STRING_SLOT_SIZE	0
+#endif
+
 /***** Typedefs *************************************************************/
 /***** Function prototypes **************************************************/
 /***** Local variables ******************************************************/
@@ -41,14 +56,174 @@
   @param  ch	character code.
   @return	result.
 */
-static int is_space( int ch )
+static inline int is_space( int ch )
+{
+  // " \t\n\v\f\r" and '\0'. ('\t'..'\r' are contiguous)
+  return ch == ' ' || ch == 0 || (unsigned int)(ch - '\t') <= ('\r' - '\t');
+}
+
+
+//================================================================
+/*! convert the case of ASCII letters, 8 bytes at a time
+
+  Stops at the 8 bytes that contain a non-ASCII byte, or at the last
+  less than 8 bytes.
+
+  @param  data	pointer to the buffer.
+  @param  len	length of the buffer.
+  @param  first	'a' to upcase, or 'A' to downcase.
+  @param  count	(out) number of converted letters is added.
+  @return	number of processed bytes.
+*/
+static int ascii_convert_case8( uint8_t *data, int len, int first, int *count )
 {
-  static const char ws[] = " \t\r\n\f\v";	// '\0' on tail
+  static const uint64_t ONES = 0x0101010101010101ULL;
+  int i;
+
+  for( i = 0; i + 8 <= len; i += 8 ) {
+    uint64_t w;
+    memcpy( &w, data + i, 8 );
+    if( w & (ONES * 0x80) ) break;
 
-  for( int i = 0; i < sizeof(ws); i++ ) {
-    if( ch == ws[i] ) return 1;
+    // set the MSB of each byte that is in first .. first+25.
+    uint64_t ge = w + ONES * (0x80 - first);
+    uint64_t gt = w + ONES * (0x80 - first - 26);
+    uint64_t mask = ge & ~gt & (ONES * 0x80);
+    if( mask == 0 ) continue;
+
+    w ^= mask >> 2;		// toggle 0x20
+    memcpy( data + i, &w, 8 );
+    *count += ((mask >> 7) * ONES) >> 56;
   }
+
+  return i;
+}
+
+
+//================================================================
+/*! check whether the buffer is inline.
+
+  @param  h	pointer to string object.
+  @return	1 if the buffer follows the object in the same block.
+*/
+static inline int string_is_inline(const mrbc_string *h)
+{
+#if MRBC_STRING_INLINE_SIZE > 0
+  return h->data == (const uint8_t *)(h + 1);
+#else
   return 0;
+#endif
+}
+
+
+//================================================================
+/*! check whether the buffer is allocated for the string.
+
+  @param  h	pointer to string object.
+  @return	0 if the buffer is inline or shared.
+*/
+static inline int string_owns_buffer(const mrbc_string *h)
+{
+  return !string_is_inline(h) && h->shared == MRBC_STRING_OWNED;
+}
+
+
+#if MRBC_USE_SHARED_SUBSTRING
+//================================================================
+/*! release the parent of a shared substring.
+
+  @param  parent	pointer to parent string object.
+*/
+static void string_release(mrbc_string *parent)
+{
+  mrbc_value v = mrbc_immediate_value(MRBC_TT_STRING, .string = parent);
+  mrbc_decref(&v);
+}
+
+
+//================================================================
+/*! get the parent to share the buffer with.
+
+  An owned buffer is moved to a new hidden string, and both the string
+  and its substrings refer to it.
+
+  @param  vm	pointer to VM.
+  @param  h	pointer to string object. (not inline)
+  @return	pointer to parent string object.
+*/
+static mrbc_string * string_share(mrbc_vm *vm, mrbc_string *h)
+{
+  if( h->shared == MRBC_STRING_SUBSTR ) return STRING_PARENT(h);
+
+  mrbc_value parent = mrbc_string_new_alloc(vm, h->data, h->size);
+  parent.string->capacity = h->capacity;
+
+  h->shared = MRBC_STRING_SUBSTR;
+  h->capacity = h->size;
+  STRING_PARENT(h) = parent.string;
+
+  return parent.string;
+}
+#endif
+
+
+//================================================================
+/*! reallocate the buffer to the given capacity
+
+  The inline buffer is never shrunk. The inline buffer and the literal
+  are replaced by an allocated buffer when expanded or modified.
+
+  @param  h		pointer to string object.
+  @param  capacity	new capacity, excluding '\0'.
+  @return		mrbc_error_code
+*/
+static int string_realloc(mrbc_string *h, int capacity)
+{
+  uint8_t *data;
+
+  if( !string_owns_buffer(h) ) {
+    if( string_is_inline(h) && capacity <= h->capacity ) return 0;
+
+    data = mrbc_raw_alloc(capacity + 1);
+    if( !data ) return E_NOMEMORY_ERROR;
+    int len = (h->size < capacity) ? h->size : capacity;
+    memcpy( data, h->data, len );
+    data[len] = '\0';
+#if MRBC_USE_SHARED_SUBSTRING
+    if( h->shared == MRBC_STRING_SUBSTR ) string_release( STRING_PARENT(h) );
+#endif
+    h->shared = MRBC_STRING_OWNED;
+  } else {
+    data = mrbc_raw_realloc(h->data, capacity + 1);
+    if( !data ) return E_NOMEMORY_ERROR;
+  }
+
+  h->data = data;
+  h->capacity = capacity;
+  return 0;
+}
+
+
+//================================================================
+/*! expand the buffer to hold the given length
+
+  The capacity grows geometrically, so that repeated appends are
+  amortized to a constant number of copies.
+
+  @param  h	pointer to string object.
+  @param  len	required length, excluding '\0'.
+  @return	mrbc_error_code
+*/
+static int string_expand(mrbc_string *h, int len)
+{
+  if( len <= h->capacity && !h->shared ) return 0;
+
+  const int max = (MRBC_STRING_SIZE_T)~0u;
+  int capacity = h->capacity + h->capacity / 2 + 8;
+  if( capacity < len ) capacity = len;
+  if( capacity > max ) capacity = (len > max) ? len : max;
+
+  return string_realloc(h, capacity);
 }
 
 
@@ -56,6 +231,8 @@ static int is_space( int ch )
 //================================================================
 /*! constructor
 
+  A short string is stored inline, in the same block as the object.
+
   @param  vm	pointer to VM.
   @param  src	source string or NULL
   @param  len	source length
@@ -63,7 +240,28 @@ static int is_space( int ch )
 */
 mrbc_value mrbc_string_new(mrbc_vm *vm, const void *src, int len)
 {
-  uint8_t *buf = mrbc_alloc(vm, len+1);
+  uint8_t *buf;
+  mrbc_value value;
+
+#if MRBC_STRING_INLINE_SIZE > 0
+  if( len <= MRBC_STRING_INLINE_SIZE ) {
+    int size = (len + 1 < STRING_SLOT_SIZE) ? STRING_SLOT_SIZE : len + 1;
+    mrbc_string *str = mrbc_alloc(vm, sizeof(mrbc_string) + size);
+    buf = (uint8_t *)(str + 1);
+
+    *str = (mrbc_string){
+      MRBC_INIT_OBJECT_HEADER_DI(ST)
+      .size = len,
+      .capacity = len,
+      .data = buf,
+    };
+    value = mrbc_immediate_value(MRBC_TT_STRING, .string = str);
+  } else
+#endif
+  {
+    buf = mrbc_alloc(vm, len+1);
+    value = mrbc_string_new_alloc(vm, buf, len);
+  }
 
   // Copy a source string.
   if( src == NULL ) {
@@ -73,7 +271,7 @@ mrbc_value mrbc_string_new(mrbc_vm *vm, const void *src, int len)
     buf[len] = '\0';
   }
 
-  return mrbc_string_new_alloc(vm, buf, len);
+  return value;
 }
 
 
@@ -87,11 +285,12 @@ mrbc_value mrbc_string_new(mrbc_vm *vm, const void *src, int len)
 */
 mrbc_value mrbc_string_new_alloc(mrbc_vm *vm, void *buf, int len)
 {
-  mrbc_string *str = mrbc_alloc(vm, sizeof(mrbc_string));
+  mrbc_string *str = mrbc_alloc(vm, sizeof(mrbc_string) + STRING_SLOT_SIZE);
 
   *str = (mrbc_string){
     MRBC_INIT_OBJECT_HEADER_DI(ST)
     .size = len,
+    .capacity = len,
     .data = buf,
   };
 
@@ -99,6 +298,28 @@ mrbc_value mrbc_string_new_alloc(mrbc_vm *vm, void *buf, int len)
 }
 
 
+//================================================================
+/*! constructor by literal
+
+  The string shares the buffer with the literal, until it is modified.
+  (copy-on-write)
+  The literal must be kept while the string is alive, like the bytecode.
+  If it is not terminated by '\0', it is copied by mrbc_string_cstr().
+
+  @param  vm	pointer to VM.
+  @param  src	pointer to literal.
+  @param  len	length
+  @return 	string object
+*/
+mrbc_value mrbc_string_new_literal(mrbc_vm *vm, const void *src, int len)
+{
+  mrbc_value value = mrbc_string_new_alloc(vm, (void *)src, len);
+  value.string->shared = MRBC_STRING_LITERAL;
+
+  return value;
+}
+
+
 //================================================================
 /*! destructor
 
@@ -106,8 +327,16 @@ mrbc_value mrbc_string_new_alloc(mrbc_vm *vm, void *buf, int len)
 */
 void mrbc_string_delete(mrbc_value *str)
 {
-  mrbc_raw_free(str->string->data);
-  mrbc_raw_free(str->string);
+  mrbc_string *h = str->string;
+
+  if( string_owns_buffer(h) ) mrbc_raw_free(h->data);
+#if MRBC_USE_STRING_UTF8
+  if( h->char_index ) mrbc_raw_free(h->char_index);
+#endif
+#if MRBC_USE_SHARED_SUBSTRING
+  if( h->shared == MRBC_STRING_SUBSTR ) string_release( STRING_PARENT(h) );
+#endif
+  mrbc_raw_free(h);
 }
 
 
@@ -118,15 +347,19 @@ void mrbc_string_delete(mrbc_value *str)
 void mrbc_string_clear(mrbc_value *str)
 {
   // shrink suitable size. realloc() may move the block.
-  str->string->data = mrbc_raw_realloc(str->string->data, 1);
+  string_realloc(str->string, 0);
   str->string->data[0] = '\0';
   str->string->size = 0;
+  mrbc_string_reset_cache(str);
 }
 
 
 //================================================================
 /*! duplicate string
 
+  The buffer of new string fits its length, regardless of the capacity
+  of the original. A shared string is shared, not copied.
+
   @param  vm	pointer to VM.
   @param  s1	pointer to target value
   @return	new string as s1 + s2
@@ -134,11 +367,46 @@ void mrbc_string_clear(mrbc_value *str)
 mrbc_value mrbc_string_dup(mrbc_vm *vm, mrbc_value *s1)
 {
   mrbc_string *h1 = s1->string;
-  mrbc_value value = mrbc_string_new(vm, NULL, h1->size);
+  if( h1->shared ) return mrbc_string_substr(vm, s1, 0, h1->size);
 
-  memcpy( value.string->data, h1->data, h1->size + 1 );
+  return mrbc_string_new(vm, h1->data, h1->size);
+}
 
-  return value;
+
+//================================================================
+/*! substring
+
+  A substring longer than MRBC_STRING_INLINE_SIZE shares the buffer
+  with the original string, until either of them is modified.
+
+  @param  vm	pointer to VM.
+  @param  src	pointer to the original string.
+  @param  ofs	byte offset.
+  @param  len	byte length.
+  @return	new string.
+*/
+mrbc_value mrbc_string_substr(mrbc_vm *vm, mrbc_value *src, int ofs, int len)
+{
+  mrbc_string *h = src->string;
+  uint8_t *s = h->data + ofs;
+
+  if( len <= MRBC_STRING_INLINE_SIZE ) return mrbc_string_new(vm, s, len);
+  if( h->shared == MRBC_STRING_LITERAL ) return mrbc_string_new_literal(vm, s, len);
+
+#if MRBC_USE_SHARED_SUBSTRING
+  if( !string_is_inline(h) ) {
+    mrbc_string *parent = string_share(vm, h);
+    mrbc_value value = mrbc_string_new_alloc(vm, s, len);
+
+    value.string->shared = MRBC_STRING_SUBSTR;
+    STRING_PARENT(value.string) = parent;
+    parent->ref_count++;
+
+    return value;
+  }
+#endif
+
+  return mrbc_string_new(vm, s, len);
 }
 
 
@@ -157,7 +425,8 @@ mrbc_value mrbc_string_add(mrbc_vm *vm, const mrbc_value *s1, const mrbc_value *
   mrbc_value value = mrbc_string_new(vm, NULL, h1->size + h2->size);
 
   memcpy( value.string->data,            h1->data, h1->size );
-  memcpy( value.string->data + h1->size, h2->data, h2->size + 1 );
+  memcpy( value.string->data + h1->size, h2->data, h2->size );
+  value.string->data[h1->size + h2->size] = '\0';
 
   return value;
 }
@@ -174,17 +443,19 @@ int mrbc_string_append(mrbc_value *s1, const mrbc_value *s2)
 {
   int len1 = s1->string->size;
   int len2 = (mrbc_type(*s2) == MRBC_TT_STRING) ? s2->string->size : 1;
-  uint8_t *str = mrbc_raw_realloc(s1->string->data, len1+len2+1);
+  if( string_expand(s1->string, len1 + len2) != 0 ) return E_NOMEMORY_ERROR;
+  uint8_t *str = s1->string->data;
 
   if( mrbc_type(*s2) == MRBC_TT_STRING ) {
-    memcpy(str + len1, s2->string->data, len2 + 1);
+    memcpy(str + len1, s2->string->data, len2);
+    str[len1 + len2] = '\0';
   } else if( mrbc_type(*s2) == MRBC_TT_INTEGER ) {
     str[len1] = s2->i;
     str[len1+1] = '\0';
   }
 
   s1->string->size = len1 + len2;
-  s1->string->data = str;
+  mrbc_string_reset_cache(s1);
 
   return 0;
 }
@@ -201,7 +472,8 @@ int mrbc_string_append(mrbc_value *s1, const mrbc_value *s2)
 int mrbc_string_append_cbuf(mrbc_value *s1, const void *s2, int len2)
 {
   int len1 = s1->string->size;
-  uint8_t *str = mrbc_raw_realloc(s1->string->data, len1+len2+1);
+  if( string_expand(s1->string, len1 + len2) != 0 ) return E_NOMEMORY_ERROR;
+  uint8_t *str = s1->string->data;
 
   if( s2 ) {
     memcpy(str + len1, s2, len2);
@@ -211,12 +483,146 @@ int mrbc_string_append_cbuf(mrbc_value *s1, const void *s2, int len2)
   }
 
   s1->string->size = len1 + len2;
-  s1->string->data = str;
+  mrbc_string_reset_cache(s1);
 
   return 0;
 }
 
 
+//================================================================
+/*! reserve the buffer
+
+  Expand the buffer to hold the given length without reallocation.
+  The length of string is not changed.
+
+  @param  str		pointer to target value
+  @param  capacity	length to be reserved, excluding '\0'.
+  @return		mrbc_error_code
+*/
+int mrbc_string_reserve(mrbc_value *str, int capacity)
+{
+  const int max = (MRBC_STRING_SIZE_T)~0u;
+  if( capacity > max ) capacity = max;
+  if( capacity <= str->string->capacity ) return 0;
+
+  return string_realloc(str->string, capacity);
+}
+
+
+//================================================================
+/*! make the buffer writable
+
+  A string made from a literal or a substring shares the buffer with
+  others. Call this before writing to the buffer directly.
+
+  @param  str	pointer to target value
+  @return	mrbc_error_code
+*/
+int mrbc_string_unshare(mrbc_value *str)
+{
+  if( !str->string->shared ) return 0;
+
+  return string_realloc(str->string, str->string->size);
+}
+
+
+//================================================================
+/*! shrink the buffer to fit the string
+
+  @param  str	pointer to target value
+  @return	mrbc_error_code
+*/
+int mrbc_string_shrink(mrbc_value *str)
+{
+  if( str->string->size == str->string->capacity ) return 0;
+
+  return string_realloc(str->string, str->string->size);
+}
+
+
+//================================================================
+/*! hash value (FNV-1a)
+
+  The value is calculated at the first call and cached, until the
+  contents are modified. (see mrbc_string_reset_cache)
+
+  @param  str	pointer to target value
+  @return	hash value. (not 0)
+*/
+uint32_t mrbc_string_hash(const mrbc_value *str)
+{
+  mrbc_string *h = str->string;
+  if( h->hash ) return h->hash;
+
+  uint32_t hash = 2166136261u;
+  for( int i = 0; i < h->size; i++ ) {
+    hash = (hash ^ h->data[i]) * 16777619u;
+  }
+  if( hash == 0 ) hash = 1;
+
+  return h->hash = hash;
+}
+
+
+//================================================================
+/*! search a byte sequence in a buffer
+
+  Finds the first byte with memchr() (usually word-at-a-time or
+  vectorized in libc) and compares the rest with memcmp().
+  A pattern of STRING_SEARCH_SKIP_MIN bytes or more is searched by
+  the Boyer-Moore-Horspool algorithm, that skips the bytes which
+  cannot start a match.
+
+  @param  str		pointer to the buffer
+  @param  len		length of the buffer
+  @param  pattern	pointer to the pattern
+  @param  pattern_len	length of the pattern
+  @return		position index. or minus value if not found.
+*/
+int mrbc_string_search(const void *str, int len, const void *pattern, int pattern_len)
+{
+  const uint8_t *s = str;
+  const uint8_t *p = pattern;
+
+  if( pattern_len == 0 ) return 0;
+  if( pattern_len > len ) return -1;
+
+  const uint8_t *last = s + len - pattern_len;	// last start position.
+
+  if( pattern_len < STRING_SEARCH_SKIP_MIN || len < STRING_SEARCH_SKIP_MIN * 4 ) {
+    const uint8_t *p1 = s;
+    while( 1 ) {
+      p1 = memchr( p1, p[0], last - p1 + 1 );
+      if( p1 == NULL ) return -1;
+      if( memcmp( p1 + 1, p + 1, pattern_len - 1 ) == 0 ) return p1 - s;
+      if( p1 == last ) return -1;
+      p1++;
+    }
+  }
+
+  // Boyer-Moore-Horspool. The skip amounts are limited to 255.
+  uint8_t skip[256];
+  int n = pattern_len - 1;
+  int max_skip = (pattern_len < 255) ? pattern_len : 255;
+  memset( skip, max_skip, sizeof(skip) );
+  for( int i = (pattern_len > 255) ? pattern_len - 255 : 0; i < n; i++ ) {
+    skip[p[i]] = n - i;
+  }
+
+  const uint8_t *p1 = s;
+  uint8_t tail = p[n];
+  while( p1 <= last ) {
+    uint8_t ch = p1[n];
+    if( ch == tail && p1[0] == p[0] && memcmp( p1 + 1, p + 1, n - 1 ) == 0 ) {
+      return p1 - s;
+    }
+    p1 += skip[ch];
+  }
+
+  return -1;
+}
+
+
 //================================================================
 /*! locate a substring in a string
 
@@ -227,33 +633,29 @@ int mrbc_string_append_cbuf(mrbc_value *s1, const void *s2, int len2)
 */
 int mrbc_string_index(const mrbc_value *src, const mrbc_value *pattern, int offset)
 {
-  char *p1 = mrbc_string_cstr(src) + offset;
-  char *p2 = mrbc_string_cstr(pattern);
-  int try_cnt = mrbc_string_size(src) - mrbc_string_size(pattern) - offset;
-
-  while( try_cnt >= 0 ) {
-    if( memcmp( p1, p2, mrbc_string_size(pattern) ) == 0 ) {
-      return p1 - mrbc_string_cstr(src);	// matched.
-    }
-    try_cnt--;
-    p1++;
-  }
+  if( offset < 0 || offset > mrbc_string_size(src) ) return -1;
 
-  return -1;
+  int pos = mrbc_string_search( src->string->data + offset,
+                                mrbc_string_size(src) - offset,
+                                pattern->string->data,
+                                mrbc_string_size(pattern) );
+  return (pos < 0) ? pos : pos + offset;
 }
 
 
 //================================================================
-/*! remove the whitespace in myself
+/*! find the range without the whitespace
 
   @param  src	pointer to target value
   @param  mode	1:left-side, 2:right-side, 3:each
-  @return	0 when not removed.
+  @param  ofs	(out) offset of the range.
+  @return	length of the range.
 */
-int mrbc_string_strip(mrbc_value *src, int mode)
+static int string_strip_range(const mrbc_value *src, int mode, int *ofs)
 {
-  char *p1 = mrbc_string_cstr(src);
-  char *p2 = p1 + mrbc_string_size(src) - 1;
+  const char *p0 = (const char *)src->string->data;
+  const char *p1 = p0;
+  const char *p2 = p1 + mrbc_string_size(src) - 1;
 
   // left-side
   if( mode & 0x01 ) {
@@ -271,21 +673,56 @@ int mrbc_string_strip(mrbc_value *src, int mode)
     }
   }
 
-  int new_size = p2 - p1 + 1;
+  *ofs = p1 - p0;
+  return p2 - p1 + 1;
+}
+
+
+//================================================================
+/*! remove the whitespace in myself
+
+  @param  src	pointer to target value
+  @param  mode	1:left-side, 2:right-side, 3:each
+  @return	0 when not removed.
+*/
+int mrbc_string_strip(mrbc_value *src, int mode)
+{
+  int ofs;
+  int new_size = string_strip_range(src, mode, &ofs);
   if( mrbc_string_size(src) == new_size ) return 0;
 
+  mrbc_string_unshare(src);
   char *buf = mrbc_string_cstr(src);
-  if( p1 != buf ) memmove( buf, p1, new_size );
+  if( ofs != 0 ) memmove( buf, buf + ofs, new_size );
   buf[new_size] = '\0';
 
   // shrink suitable size. realloc() may move the block.
-  src->string->data = mrbc_raw_realloc(buf, new_size+1);
+  string_realloc(src->string, new_size);
   src->string->size = new_size;
+  mrbc_string_reset_cache(src);
 
   return 1;
 }
 
 
+//================================================================
+/*! length without the trailing CR,LF
+
+  @param  src	pointer to target value
+  @return	length.
+*/
+static int string_chomp_size(const mrbc_value *src)
+{
+  const uint8_t *p = src->string->data;
+  int size = mrbc_string_size(src);
+
+  if( size > 0 && p[size-1] == '\n' ) size--;
+  if( size > 0 && p[size-1] == '\r' ) size--;
+
+  return size;
+}
+
+
 //================================================================
 /*! remove the CR,LF in myself
 
@@ -294,22 +731,14 @@ int mrbc_string_strip(mrbc_value *src, int mode)
 */
 int mrbc_string_chomp(mrbc_value *src)
 {
-  char *p1 = mrbc_string_cstr(src);
-  char *p2 = p1 + mrbc_string_size(src) - 1;
-
-  if( *p2 == '\n' ) {
-    p2--;
-  }
-  if( *p2 == '\r' ) {
-    p2--;
-  }
-
-  int new_size = p2 - p1 + 1;
+  int new_size = string_chomp_size(src);
   if( mrbc_string_size(src) == new_size ) return 0;
 
+  mrbc_string_unshare(src);
   char *buf = mrbc_string_cstr(src);
   buf[new_size] = '\0';
   src->string->size = new_size;
+  mrbc_string_reset_cache(src);
 
   return 1;
 }
@@ -324,13 +753,17 @@ int mrbc_string_chomp(mrbc_value *src)
 */
 int mrbc_string_upcase(mrbc_value *str)
 {
+  mrbc_string_unshare(str);
   int len = str->string->size;
   int count = 0;
   uint8_t *data = str->string->data;
-  while (len != 0) {
-    len--;
-    if ('a' <= data[len] && data[len] <= 'z') {
-      data[len] = data[len] - ('a' - 'A');
+  mrbc_string_reset_cache(str);
+
+  for( int i = 0; i < len; i++ ) {
+    i += ascii_convert_case8( data + i, len - i, 'a', &count );
+    if( i == len ) break;
+    if ('a' <= data[i] && data[i] <= 'z') {
+      data[i] = data[i] - ('a' - 'A');
       count++;
     }
   }
@@ -346,13 +779,17 @@ int mrbc_string_upcase(mrbc_value *str)
 */
 int mrbc_string_downcase(mrbc_value *str)
 {
+  mrbc_string_unshare(str);
   int len = str->string->size;
   int count = 0;
   uint8_t *data = str->string->data;
-  while (len != 0) {
-    len--;
-    if ('A' <= data[len] && data[len] <= 'Z') {
-      data[len] = data[len] + ('a' - 'A');
+  mrbc_string_reset_cache(str);
+
+  for( int i = 0; i < len; i++ ) {
+    i += ascii_convert_case8( data + i, len - i, 'A', &count );
+    if( i == len ) break;
+    if ('A' <= data[i] && data[i] <= 'Z') {
+      data[i] = data[i] + ('a' - 'A');
       count++;
     }
   }
@@ -431,6 +868,94 @@ int mrbc_string_char_size(const char *str, int len)
 }
 
 
+//================================================================
+/*! count the characters, and make the character index
+
+  A string that has more than MRBC_STRING_CHAR_INDEX_INTERVAL
+  multibyte characters gets a table of the byte offsets of every
+  MRBC_STRING_CHAR_INDEX_INTERVAL characters. It is discarded when
+  the contents are modified. (see mrbc_string_reset_cache)
+
+  @param  src	pointer to string value
+  @return	pointer to string object.
+*/
+static mrbc_string * string_char_index(const mrbc_value *src)
+{
+  mrbc_string *h = src->string;
+  if( h->char_state != MRBC_STRING_CHARS_UNKNOWN ) return h;
+
+  h->char_size = mrbc_string_char_size((const char *)h->data, h->size);
+  if( h->char_size == h->size ) {
+    h->char_state = MRBC_STRING_CHARS_SINGLE;
+    return h;
+  }
+  h->char_state = MRBC_STRING_CHARS_MULTI;
+
+#if MRBC_STRING_CHAR_INDEX_INTERVAL > 0
+  int n = (h->char_size - 1) / MRBC_STRING_CHAR_INDEX_INTERVAL;
+  if( n == 0 ) return h;
+
+  h->char_index = mrbc_raw_alloc( sizeof(MRBC_STRING_SIZE_T) * n );
+  if( !h->char_index ) return h;
+
+  const char *str = (const char *)h->data;
+  const char *end = str + h->size;
+  const char *p = str;
+  for( int i = 0; i < n; i++ ) {
+    for( int j = 0; j < MRBC_STRING_CHAR_INDEX_INTERVAL; j++ ) {
+      p += utf8_validated_char_len(p, end);
+    }
+    h->char_index[i] = p - str;
+  }
+#endif
+
+  return h;
+}
+
+
+#if MRBC_STRING_CHAR_INDEX_INTERVAL > 0
+//================================================================
+/*! Get byte offset of the character
+
+  @param  h       pointer to string object. (counted)
+  @param  idx     character index
+  @return         byte offset
+*/
+static int string_char_offset(const mrbc_string *h, int idx)
+{
+  if( idx >= h->char_size ) return h->size;
+  if( h->char_state == MRBC_STRING_CHARS_SINGLE ) return idx;
+
+  const char *str = (const char *)h->data;
+  const char *end = str + h->size;
+  const char *p = str;
+
+  int n = idx / MRBC_STRING_CHAR_INDEX_INTERVAL;
+  if( n > 0 && h->char_index ) {
+    p += h->char_index[n-1];
+    idx -= n * MRBC_STRING_CHAR_INDEX_INTERVAL;
+  }
+
+  for( ; idx > 0; idx-- ) {
+    p += utf8_validated_char_len(p, end);
+  }
+  return p - str;
+}
+#endif
+
+
+//================================================================
+/*! Count characters of the string
+
+  @param  src     pointer to string value
+  @return         number of UTF-8 characters
+*/
+int mrbc_string_char_count(const mrbc_value *src)
+{
+  return string_char_index(src)->char_size;
+}
+
+
 //================================================================
 /*! Convert character index to byte offset
 
@@ -441,8 +966,25 @@ int mrbc_string_char_size(const char *str, int len)
 */
 int mrbc_string_chars2bytes(mrbc_value *src, int off, int idx)
 {
-  const char *str = mrbc_string_cstr(src) + off;
-  const char *end = mrbc_string_cstr(src) + src->string->size;
+  const mrbc_string *h = string_char_index(src);
+
+  if( h->char_state == MRBC_STRING_CHARS_SINGLE ) {
+    return (idx < h->size - off) ? idx : h->size - off;
+  }
+
+#if MRBC_STRING_CHAR_INDEX_INTERVAL > 0
+  // use the character index, if it is far.
+  if( idx >= MRBC_STRING_CHAR_INDEX_INTERVAL ) {
+    int n = (off == 0) ? 0 : mrbc_string_bytes2chars(src, off);
+    if( n >= 0 ) {
+      if( idx >= h->char_size - n ) return h->size - off;
+      return string_char_offset(h, n + idx) - off;
+    }
+  }
+#endif
+
+  const char *str = (const char *)h->data + off;
+  const char *end = (const char *)h->data + h->size;
   int bytes = 0;
 
   for( int i = 0; i < idx && str < end; i++ ) {
@@ -463,14 +1005,39 @@ int mrbc_string_chars2bytes(mrbc_value *src, int off, int idx)
 */
 int mrbc_string_bytes2chars(const mrbc_value *src, int byte_index)
 {
-  const char *str = mrbc_string_cstr(src);
+  const mrbc_string *h = string_char_index(src);
+
+  if( byte_index < 0 || byte_index > h->size ) return -1;
+  if( byte_index == h->size ) return h->char_size;
+  if( h->char_state == MRBC_STRING_CHARS_SINGLE ) return byte_index;
+
+  const char *str = (const char *)h->data;
+  const char *end = str + h->size;
   const char *target = str + byte_index;
   int count = 0;
 
+#if MRBC_STRING_CHAR_INDEX_INTERVAL > 0
+  // binary search the last offset in the character index before the target.
+  if( h->char_index ) {
+    int left = 0;
+    int right = (h->char_size - 1) / MRBC_STRING_CHAR_INDEX_INTERVAL;
+    while( left < right ) {
+      int mid = (left + right) / 2;
+      if( h->char_index[mid] <= byte_index ) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    if( left > 0 ) {
+      count = left * MRBC_STRING_CHAR_INDEX_INTERVAL;
+      str += h->char_index[left-1];
+    }
+  }
+#endif
+
   while( str < target ) {
-    int char_len = mrbc_string_utf8_size(str);
-    if( char_len == 0 ) char_len = 1;
-    str += char_len;
+    str += utf8_validated_char_len(str, end);
     count++;
   }
   return (str == target) ? count : -1;
@@ -543,6 +1110,21 @@ static int unicode_encode_utf8(int32_t cp, uint8_t *buf)
 }
 
 
+#if MRBC_USE_UNICODE_CASE == 2
+//================================================================
+/*! Look up case conversion in two-stage table
+
+  @param  cp      codepoint to convert (BMP)
+  @param  index   index table of the blocks
+  @return         converted codepoint, or original if not found
+*/
+static inline int32_t unicode_case_lookup_table(int32_t cp, const uint8_t *index)
+{
+  const uint16_t *block = case_blocks[ index[cp >> CASE_BLOCK_SHIFT] ];
+  return (cp + block[cp & CASE_BLOCK_MASK]) & 0xFFFF;
+}
+
+#else
 //================================================================
 /*! Look up case conversion in range table
 
@@ -591,6 +1173,7 @@ static int32_t unicode_case_lookup_exception(int32_t cp, const case_exception_t
   }
   return cp;  // Not found
 }
+#endif
 
 
 //================================================================
@@ -603,12 +1186,16 @@ static int32_t unicode_upcase_codepoint(int32_t cp)
 {
   if( cp < 0 || cp > 0xFFFF ) return cp;  // BMP only
 
+#if MRBC_USE_UNICODE_CASE == 2
+  return unicode_case_lookup_table(cp, upcase_index);
+#else
   // Try ranges first (more common patterns)
   int32_t result = unicode_case_lookup_range(cp, upcase_ranges, UPCASE_RANGES_COUNT);
   if( result != cp ) return result;
 
   // Fall back to exceptions
   return unicode_case_lookup_exception(cp, upcase_exceptions, UPCASE_EXCEPTIONS_COUNT);
+#endif
 }
 
 
@@ -622,12 +1209,16 @@ static int32_t unicode_downcase_codepoint(int32_t cp)
 {
   if( cp < 0 || cp > 0xFFFF ) return cp;  // BMP only
 
+#if MRBC_USE_UNICODE_CASE == 2
+  return unicode_case_lookup_table(cp, downcase_index);
+#else
   // Try ranges first
   int32_t result = unicode_case_lookup_range(cp, downcase_ranges, DOWNCASE_RANGES_COUNT);
   if( result != cp ) return result;
 
   // Fall back to exceptions
   return unicode_case_lookup_exception(cp, downcase_exceptions, DOWNCASE_EXCEPTIONS_COUNT);
+#endif
 }
 
 
@@ -639,14 +1230,21 @@ static int32_t unicode_downcase_codepoint(int32_t cp)
 */
 int mrbc_string_upcase(mrbc_value *str)
 {
+  mrbc_string_unshare(str);
   int len = str->string->size;
   uint8_t *data = str->string->data;
   int count = 0;
+  mrbc_string_reset_cache(str);
 
   // First pass: check if any conversion changes byte length
   int new_len = 0;
   int needs_realloc = 0;
   for( int i = 0; i < len; ) {
+    if( data[i] < 0x80 ) {	// ASCII letters are not changed in length.
+      new_len++;
+      i++;
+      continue;
+    }
     int char_len;
     int32_t cp = unicode_decode_utf8(data + i, &char_len);
     int32_t upper_cp = unicode_upcase_codepoint(cp);
@@ -676,12 +1274,16 @@ int mrbc_string_upcase(mrbc_value *str)
     }
     new_data[new_len] = '\0';
 
-    mrbc_raw_free(data);
+    if( string_owns_buffer(str->string) ) mrbc_raw_free(data);
     str->string->data = new_data;
     str->string->size = new_len;
+    str->string->capacity = new_len;
   } else {
     // In-place conversion
     for( int i = 0; i < len; ) {
+      i += ascii_convert_case8( data + i, len - i, 'a', &count );
+      if( i == len ) break;
+
       int char_len;
       int32_t cp = unicode_decode_utf8(data + i, &char_len);
       int32_t upper_cp = unicode_upcase_codepoint(cp);
@@ -706,14 +1308,21 @@ int mrbc_string_upcase(mrbc_value *str)
 */
 int mrbc_string_downcase(mrbc_value *str)
 {
+  mrbc_string_unshare(str);
   int len = str->string->size;
   uint8_t *data = str->string->data;
   int count = 0;
+  mrbc_string_reset_cache(str);
 
   // First pass: check if any conversion changes byte length
   int new_len = 0;
   int needs_realloc = 0;
   for( int i = 0; i < len; ) {
+    if( data[i] < 0x80 ) {	// ASCII letters are not changed in length.
+      new_len++;
+      i++;
+      continue;
+    }
     int char_len;
     int32_t cp = unicode_decode_utf8(data + i, &char_len);
     int32_t lower_cp = unicode_downcase_codepoint(cp);
@@ -743,12 +1352,16 @@ int mrbc_string_downcase(mrbc_value *str)
     }
     new_data[new_len] = '\0';
 
-    mrbc_raw_free(data);
+    if( string_owns_buffer(str->string) ) mrbc_raw_free(data);
     str->string->data = new_data;
     str->string->size = new_len;
+    str->string->capacity = new_len;
   } else {
     // In-place conversion
     for( int i = 0; i < len; ) {
+      i += ascii_convert_case8( data + i, len - i, 'A', &count );
+      if( i == len ) break;
+
       int char_len;
       int32_t cp = unicode_decode_utf8(data + i, &char_len);
       int32_t lower_cp = unicode_downcase_codepoint(cp);
@@ -769,10 +1382,25 @@ int mrbc_string_downcase(mrbc_value *str)
 
 //================================================================
 /*! (method) new
+
+  String.new( str = "", capacity: size )
 */
 static void c_string_new(mrbc_vm *vm, mrbc_value v[], int argc)
 {
   mrbc_value value;
+  int capacity = 0;
+
+  // keyword argument capacity:
+  if( mrbc_type(v[argc+1]) == MRBC_TT_HASH ) {
+    mrbc_value *kv = mrbc_hash_search_by_id(&v[argc+1], MRBC_SYM(capacity));
+    if( kv ) {
+      if( mrbc_type(kv[1]) != MRBC_TT_INTEGER ) {
+        mrbc_raisef( vm, MRBC_CLASS(TypeError), "no implicit conversion into %s", "Integer");
+        return;
+      }
+      capacity = mrbc_integer(kv[1]);
+    }
+  }
 
   switch( argc ) {
   case 0:
@@ -792,6 +1420,7 @@ static void c_string_new(mrbc_vm *vm, mrbc_value v[], int argc)
     return;
   }
 
+  if( capacity > 0 ) mrbc_string_reserve(&value, capacity);
   SET_RETURN(value);
 }
 
@@ -847,7 +1476,7 @@ static void c_string_mul(mrbc_vm *vm, mrbc_value v[], int argc)
 static void c_string_size(mrbc_vm *vm, mrbc_value v[], int argc)
 {
 #if MRBC_USE_STRING_UTF8
-  mrbc_int_t size = mrbc_string_char_size(mrbc_string_cstr(&v[0]), mrbc_string_size(&v[0]));
+  mrbc_int_t size = mrbc_string_char_count(&v[0]);
 #else
   mrbc_int_t size = mrbc_string_size(&v[0]);
 #endif
@@ -1022,7 +1651,7 @@ static int string_slice_parse(mrbc_vm *vm, mrbc_value v[], int argc,
 static void c_string_slice(mrbc_vm *vm, mrbc_value v[], int argc)
 {
 #if MRBC_USE_STRING_UTF8
-  int target_len = mrbc_string_char_size(mrbc_string_cstr(&v[0]), mrbc_string_size(&v[0]));
+  int target_len = mrbc_string_char_count(&v[0]);
 #else
   int target_len = mrbc_string_size(v);
 #endif
@@ -1036,9 +1665,9 @@ static void c_string_slice(mrbc_vm *vm, mrbc_value v[], int argc)
 #if MRBC_USE_STRING_UTF8
   int byte_pos = mrbc_string_chars2bytes(&v[0], 0, pos);
   int byte_len = mrbc_string_chars2bytes(&v[0], byte_pos, len);
-  mrbc_value ret = mrbc_string_new(vm, mrbc_string_cstr(v) + byte_pos, byte_len);
+  mrbc_value ret = mrbc_string_substr(vm, v, byte_pos, byte_len);
 #else
-  mrbc_value ret = mrbc_string_new(vm, mrbc_string_cstr(v) + pos, len);
+  mrbc_value ret = mrbc_string_substr(vm, v, pos, len);
 #endif
 
   SET_RETURN(ret);
@@ -1058,7 +1687,7 @@ static void c_string_byteslice(mrbc_vm *vm, mrbc_value v[], int argc)
   case 2: return;
   }
 
-  mrbc_value ret = mrbc_string_new(vm, mrbc_string_cstr(v) + pos, len);
+  mrbc_value ret = mrbc_string_substr(vm, v, pos, len);
 
   SET_RETURN(ret);
 }
@@ -1070,7 +1699,7 @@ static void c_string_byteslice(mrbc_vm *vm, mrbc_value v[], int argc)
 static void c_string_insert(mrbc_vm *vm, mrbc_value v[], int argc)
 {
 #if MRBC_USE_STRING_UTF8
-  int target_len = mrbc_string_char_size(mrbc_string_cstr(&v[0]), mrbc_string_size(&v[0]));
+  int target_len = mrbc_string_char_count(&v[0]);
 #else
   int target_len = mrbc_string_size(v);
 #endif
@@ -1156,36 +1785,32 @@ static void c_string_insert(mrbc_vm *vm, mrbc_value v[], int argc)
   int byte_len1 = mrbc_string_size(&v[0]);  // original byte length
 
   int byte_len3 = byte_len1 + len2 - byte_len;  // final byte length
+  string_expand(v->string, byte_len3);
   uint8_t *str = v->string->data;
-  if( byte_len1 < byte_len3 ) {
-    str = mrbc_realloc(vm, str, byte_len3+1);	// expand
-  }
 
   memmove( str + byte_pos + len2, str + byte_pos + byte_len, byte_len1 - byte_pos - byte_len + 1 );
   memcpy( str + byte_pos, mrbc_string_cstr(val), len2 );
 
   if( byte_len1 > byte_len3 ) {
-    str = mrbc_realloc(vm, str, byte_len3+1);	// shrink
+    string_realloc(v->string, byte_len3);	// shrink
   }
 
   v->string->size = byte_len3;
-  v->string->data = str;
+  mrbc_string_reset_cache(v);
 #else
   int len3 = len1 + len2 - len;			// final length.
+  string_expand(v->string, len3);
   uint8_t *str = v->string->data;
-  if( len1 < len3 ) {
-    str = mrbc_realloc(vm, str, len3+1);	// expand
-  }
 
   memmove( str + pos + len2, str + pos + len, len1 - pos - len + 1 );
   memcpy( str + pos, mrbc_string_cstr(val), len2 );
 
   if( len1 > len3 ) {
-    str = mrbc_realloc(vm, str, len3+1);	// shrink
+    string_realloc(v->string, len3);	// shrink
   }
 
-  v->string->size = len1 + len2 - len;
-  v->string->data = str;
+  v->string->size = len3;
+  mrbc_string_reset_cache(v);
 #endif
 
   // return val
@@ -1206,9 +1831,7 @@ static void c_string_insert(mrbc_vm *vm, mrbc_value v[], int argc)
 */
 static void c_string_chomp(mrbc_vm *vm, mrbc_value v[], int argc)
 {
-  mrbc_value ret = mrbc_string_dup(vm, &v[0]);
-
-  mrbc_string_chomp(&ret);
+  mrbc_value ret = mrbc_string_substr(vm, &v[0], 0, string_chomp_size(&v[0]));
 
   SET_RETURN(ret);
 }
@@ -1245,6 +1868,58 @@ static void c_string_dup(mrbc_vm *vm, mrbc_value v[], int argc)
 }
 
 
+//================================================================
+/*! (method) each_char
+
+  registers
+    v[0] self, v[1] block, v[2] byte offset of the next char,
+    v[3] block frame.
+*/
+static int string_each_char_next(mrbc_vm *vm, const mrbc_value *str, int *ofs, mrbc_value *arg)
+{
+  int size = mrbc_string_size(str);
+  if( *ofs >= size ) return 0;
+
+  const char *s = mrbc_string_cstr(str) + *ofs;
+#if MRBC_USE_STRING_UTF8
+  int len = utf8_validated_char_len(s, s + (size - *ofs));
+#else
+  int len = 1;
+#endif
+
+  *arg = mrbc_string_new(vm, s, len);
+  *ofs += len;
+  return 1;
+}
+
+static int string_each_char_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+{
+  int ofs = mrbc_integer(v[2]);
+  if( !string_each_char_next( vm, &v[0], &ofs, &v[4] )) return -1;
+
+  mrbc_set_integer( &v[2], ofs );
+  return 1;
+}
+
+static void c_string_each_char(mrbc_vm *vm, mrbc_value v[], int argc)
+{
+  if( !mrbc_c_block_given(vm, v, argc) ) {
+    mrbc_raise(vm, MRBC_CLASS(NotImplementedError), "Enumerator is not supported");
+    return;
+  }
+
+  int ofs = 0;
+  mrbc_value arg;
+  if( !string_each_char_next( vm, &v[0], &ofs, &arg )) return;
+
+  v = mrbc_yield( vm, v, 3, &v[1], 1, &arg, string_each_char_resume );
+  if( !v ) return;
+
+  mrbc_decref_empty( &v[2] );
+  mrbc_set_integer( &v[2], ofs );
+}
+
+
 //================================================================
 /*! (method) empty?
 */
@@ -1297,7 +1972,9 @@ static void c_string_setbyte(mrbc_vm *vm, mrbc_value v[], int argc)
     return;
   }
 
+  mrbc_string_unshare(&v[0]);
   mrbc_string_cstr(&v[0])[idx] = dat;
+  mrbc_string_reset_cache(&v[0]);
 
   SET_INT_RETURN( dat );
 }
@@ -1317,7 +1994,7 @@ static void c_string_index(mrbc_vm *vm, mrbc_value v[], int argc)
   } else if( argc == 2 && mrbc_type(v[2]) == MRBC_TT_INTEGER ) {
     offset = v[2].i;
 #if MRBC_USE_STRING_UTF8
-    int char_len = mrbc_string_char_size(mrbc_string_cstr(&v[0]), mrbc_string_size(&v[0]));
+    int char_len = mrbc_string_char_count(&v[0]);
     if( offset < 0 ) offset += char_len;
     if( offset < 0 ) goto NIL_RETURN;
     // Convert character offset to byte offset
@@ -1362,6 +2039,7 @@ static void c_string_inspect(mrbc_vm *vm, mrbc_value v[], int argc)
   mrbc_value ret = mrbc_string_new_cstr(vm, "\"");
   const char *s = mrbc_string_cstr(v);
   int size = mrbc_string_size(v);
+  mrbc_string_reserve(&ret, size + 2);
 
 #if MRBC_USE_STRING_UTF8
   for( int i = 0; i < size; ) {
@@ -1450,7 +2128,7 @@ static void c_string_ord(mrbc_vm *vm, mrbc_value v[], int argc)
 static void c_string_slice_self(mrbc_vm *vm, mrbc_value v[], int argc)
 {
 #if MRBC_USE_STRING_UTF8
-  int target_len = mrbc_string_char_size(mrbc_string_cstr(&v[0]), mrbc_string_size(&v[0]));
+  int target_len = mrbc_string_char_count(&v[0]);
 #else
   int target_len = mrbc_string_size(v);
 #endif
@@ -1487,21 +2165,25 @@ static void c_string_slice_self(mrbc_vm *vm, mrbc_value v[], int argc)
   mrbc_value ret = mrbc_string_new(vm, mrbc_string_cstr(v) + byte_pos, byte_len);
 
   if( byte_len > 0 ) {
+    mrbc_string_unshare(v);
     memmove( mrbc_string_cstr(v) + byte_pos, mrbc_string_cstr(v) + byte_pos + byte_len,
              byte_size - byte_pos - byte_len + 1 );
     v->string->size = byte_size - byte_len;
     // shrink suitable size. realloc() may move the block.
-    v->string->data = mrbc_raw_realloc( mrbc_string_cstr(v), v->string->size+1 );
+    string_realloc( v->string, v->string->size );
+    mrbc_string_reset_cache(v);
   }
 #else
   mrbc_value ret = mrbc_string_new(vm, mrbc_string_cstr(v) + pos, len);
 
   if( len > 0 ) {
+    mrbc_string_unshare(v);
     memmove( mrbc_string_cstr(v) + pos, mrbc_string_cstr(v) + pos + len,
              mrbc_string_size(v) - pos - len + 1 );
     v->string->size = mrbc_string_size(v) - len;
     // shrink suitable size. realloc() may move the block.
-    v->string->data = mrbc_raw_realloc( mrbc_string_cstr(v), v->string->size+1 );
+    string_realloc( v->string, v->string->size );
+    mrbc_string_reset_cache(v);
   }
 #endif
 
@@ -1561,10 +2243,12 @@ static void c_string_split(mrbc_vm *vm, mrbc_value v[], int argc)
     int pos, len = 0;
 
     if( flag_strip ) {
-      for( ; offset < mrbc_string_size(&v[0]); offset++ ) {
-        if( !is_space( mrbc_string_cstr(&v[0])[offset] )) break;
+      const uint8_t *s = v[0].string->data;
+      int size = mrbc_string_size(&v[0]);
+      for( ; offset < size; offset++ ) {
+        if( !is_space( s[offset] )) break;
       }
-      if( offset > mrbc_string_size(&v[0])) break;
+      if( offset > size ) break;
     }
 
     // check limit
@@ -1575,9 +2259,10 @@ static void c_string_split(mrbc_vm *vm, mrbc_value v[], int argc)
 
     // split by space character.
     if( flag_strip ) {
-      pos = offset;
-      for( ; pos < mrbc_string_size(&v[0]); pos++ ) {
-        if( is_space( mrbc_string_cstr(&v[0])[pos] )) break;
+      const uint8_t *s = v[0].string->data;
+      int size = mrbc_string_size(&v[0]);
+      for( pos = offset; pos < size; pos++ ) {
+        if( is_space( s[pos] )) break;
       }
       len = pos - offset;
       goto SPLIT_ITEM;
@@ -1607,7 +2292,7 @@ static void c_string_split(mrbc_vm *vm, mrbc_value v[], int argc)
   SPLIT_ITEM:
     if( pos < 0 ) len = mrbc_string_size(&v[0]) - offset;
 
-    mrbc_value v1 = mrbc_string_new(vm, mrbc_string_cstr(&v[0]) + offset, len);
+    mrbc_value v1 = mrbc_string_substr(vm, &v[0], offset, len);
     mrbc_array_push( &ret, &v1 );
 
     if( pos < 0 ) break;
@@ -1642,9 +2327,9 @@ static void c_string_split(mrbc_vm *vm, mrbc_value v[], int argc)
 */
 static void c_string_lstrip(mrbc_vm *vm, mrbc_value v[], int argc)
 {
-  mrbc_value ret = mrbc_string_dup(vm, &v[0]);
-
-  mrbc_string_strip(&ret, 0x01);	// 1: left side only
+  int ofs;
+  int len = string_strip_range(&v[0], 0x01, &ofs);	// 1: left side only
+  mrbc_value ret = mrbc_string_substr(vm, &v[0], ofs, len);
 
   SET_RETURN(ret);
 }
@@ -1666,9 +2351,9 @@ static void c_string_lstrip_self(mrbc_vm *vm, mrbc_value v[], int argc)
 */
 static void c_string_rstrip(mrbc_vm *vm, mrbc_value v[], int argc)
 {
-  mrbc_value ret = mrbc_string_dup(vm, &v[0]);
-
-  mrbc_string_strip(&ret, 0x02);	// 2: right side only
+  int ofs;
+  int len = string_strip_range(&v[0], 0x02, &ofs);	// 2: right side only
+  mrbc_value ret = mrbc_string_substr(vm, &v[0], ofs, len);
 
   SET_RETURN(ret);
 }
@@ -1690,9 +2375,9 @@ static void c_string_rstrip_self(mrbc_vm *vm, mrbc_value v[], int argc)
 */
 static void c_string_strip(mrbc_vm *vm, mrbc_value v[], int argc)
 {
-  mrbc_value ret = mrbc_string_dup(vm, &v[0]);
-
-  mrbc_string_strip(&ret, 0x03);	// 3: left and right
+  int ofs;
+  int len = string_strip_range(&v[0], 0x03, &ofs);	// 3: left and right
+  mrbc_value ret = mrbc_string_substr(vm, &v[0], ofs, len);
 
   SET_RETURN(ret);
 }
@@ -1966,16 +2651,18 @@ static int tr_main_utf8(mrbc_vm *vm, mrbc_value v[], int argc)
   tr_free_pattern_utf8(rep);
 
   // Replace original string content with result
+  mrbc_string_unshare(&v[0]);
   mrbc_string *orig = v[0].string;
   mrbc_string *res = result.string;
 
   // Swap the data
   if( mrbc_string_size(&v[0]) != mrbc_string_size(&result) ) {
     // Need to reallocate
-    orig->data = mrbc_realloc(vm, orig->data, res->size + 1);
+    string_realloc(orig, res->size);
   }
   memcpy(orig->data, res->data, res->size + 1);
   orig->size = res->size;
+  mrbc_string_reset_cache(&v[0]);
 
   mrbc_decref(&result);
   return flag_changed;
@@ -2115,28 +2802,56 @@ static int tr_main( mrbc_vm *vm, mrbc_value v[], int argc )
   struct tr_pattern *rep = tr_parse_pattern( vm, &v[2], 0 );
 
   int flag_changed = 0;
+  mrbc_string_unshare(&v[0]);
   char *s = mrbc_string_cstr( &v[0] );
   int len = mrbc_string_size( &v[0] );
 
+  // for a long string, make a table of 256 replaced bytes and
+  // a bitmap of the matched bytes, instead of searching the patterns.
+  uint8_t *map = NULL;
+  if( len >= STRING_TR_MAP_MIN ) {
+    map = mrbc_alloc( vm, 256 + 256/8 );
+  }
+  if( map ) {
+    memset( map + 256, 0, 256/8 );
+    for( int ch = 0; ch < 256; ch++ ) {
+      int n = tr_find_character( pat, (char)ch );
+      if( n < 0 ) continue;
+      map[256 + ch/8] |= 1 << (ch % 8);
+      map[ch] = rep ? tr_get_character( rep, n ) : 0;
+    }
+  }
+
+  int j = 0;
   for( int i = 0; i < len; i++ ) {
-    int n = tr_find_character( pat, s[i] );
-    if( n < 0 ) continue;
-
-    flag_changed = 1;
-    if( rep == NULL ) {
-      memmove( s + i, s + i + 1, len - i );
-      len--;
-      i--;
+    int ch = s[i];
+    int flag_found;
+
+    if( map ) {
+      uint8_t b = ch;
+      flag_found = (map[256 + b/8] >> (b % 8)) & 1;
+      if( flag_found ) ch = map[b];
     } else {
-      s[i] = tr_get_character( rep, n );
+      int n = tr_find_character( pat, ch );
+      flag_found = (n >= 0);
+      if( flag_found && rep ) ch = tr_get_character( rep, n );
+    }
+
+    if( flag_found ) {
+      flag_changed = 1;
+      if( rep == NULL ) continue;	// delete the character.
     }
+    s[j++] = ch;
   }
+  len = j;
 
+  if( map ) mrbc_free( vm, map );
   tr_free_pattern( pat );
   tr_free_pattern( rep );
 
   v[0].string->size = len;
   v[0].string->data[len] = 0;
+  mrbc_string_reset_cache(&v[0]);
 
   return flag_changed;
 }
@@ -2185,7 +2900,7 @@ static void c_string_start_with(mrbc_vm *vm, mrbc_value v[], int argc)
   if( mrbc_string_size(&v[0]) < mrbc_string_size(&v[1]) ) {
     ret = 0;
   } else {
-    ret = (memcmp( mrbc_string_cstr(&v[0]), mrbc_string_cstr(&v[1]),
+    ret = (memcmp( v[0].string->data, v[1].string->data,
                    mrbc_string_size(&v[1]) ) == 0);
   }
 
@@ -2208,7 +2923,7 @@ static void c_string_end_with(mrbc_vm *vm, mrbc_value v[], int argc)
   if( offset < 0 ) {
     ret = 0;
   } else {
-    ret = (memcmp( mrbc_string_cstr(&v[0]) + offset, mrbc_string_cstr(&v[1]),
+    ret = (memcmp( v[0].string->data + offset, v[1].string->data,
                    mrbc_string_size(&v[1]) ) == 0);
   }
 
@@ -2469,7 +3184,9 @@ static void c_string_reverse_self(mrbc_vm *vm, mrbc_value v[], int argc)
   }
 
   // Copy back to original
+  mrbc_string_unshare(&v[0]);
   memcpy(v[0].string->data, tmp, len);
+  mrbc_string_reset_cache(&v[0]);
 
   mrbc_raw_free(tmp);
   mrbc_raw_free(offsets);
@@ -2498,6 +3215,7 @@ static void c_string_reverse_self(mrbc_vm *vm, mrbc_value v[], int argc)
   METHOD( "chomp",	c_string_chomp )
   METHOD( "chomp!",	c_string_chomp_self )
   METHOD( "dup",	c_string_dup )
+  METHOD( "each_char",	c_string_each_char )
   METHOD( "empty?",	c_string_empty )
   METHOD( "getbyte",	c_string_getbyte )
   METHOD( "setbyte",	c_string_setbyte )
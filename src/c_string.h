@@ -24,6 +24,7 @@
 //@endcond
 
 /***** Local headers ********************************************************/
+#include "alloc.h"
 #include "value.h"
 #include "vm.h"
 
@@ -40,6 +41,28 @@ extern "C" {
 #define RSTRING_PTR(str)	mrbc_string_cstr(&str)
 
 /***** Typedefs *************************************************************/
+//================================================================
+/*!@brief
+  Owner of the string buffer.
+*/
+enum mrbc_string_shared {
+  MRBC_STRING_OWNED = 0,	//!< allocated or inline buffer.
+  MRBC_STRING_LITERAL,		//!< literal in bytecode. (read only)
+  MRBC_STRING_SUBSTR,		//!< buffer of the parent string. (read only)
+};
+
+
+//================================================================
+/*!@brief
+  Width of the characters, known by counting. (UTF-8)
+*/
+enum mrbc_string_chars {
+  MRBC_STRING_CHARS_UNKNOWN = 0,	//!< not counted yet.
+  MRBC_STRING_CHARS_SINGLE,		//!< every character is one byte.
+  MRBC_STRING_CHARS_MULTI,		//!< has multibyte characters.
+};
+
+
 //================================================================
 /*!@brief
   String object.
@@ -50,7 +73,17 @@ typedef struct RString {
   MRBC_OBJECT_HEADER;
 
   MRBC_STRING_SIZE_T size;	//!< string length.
-  uint8_t *data;		//!< pointer to allocated buffer.
+  MRBC_STRING_SIZE_T capacity;	//!< allocated buffer size, excluding '\0'.
+  uint8_t shared;		//!< owner of the buffer. (mrbc_string_shared)
+#if MRBC_USE_STRING_UTF8
+  uint8_t char_state;		//!< width of the characters. (mrbc_string_chars)
+  MRBC_STRING_SIZE_T char_size;	//!< number of characters, if counted.
+#endif
+  uint32_t hash;		//!< cached hash value. (0: not calculated)
+  uint8_t *data;		//!< pointer to the buffer.
+#if MRBC_USE_STRING_UTF8
+  MRBC_STRING_SIZE_T *char_index; //!< byte offset of every MRBC_STRING_CHAR_INDEX_INTERVAL characters.
+#endif
 
 } mrbc_string;
 
@@ -60,12 +93,19 @@ typedef struct RString {
 //@cond
 mrbc_value mrbc_string_new(mrbc_vm *vm, const void *src, int len);
 mrbc_value mrbc_string_new_alloc(mrbc_vm *vm, void *buf, int len);
+mrbc_value mrbc_string_new_literal(mrbc_vm *vm, const void *src, int len);
 void mrbc_string_delete(mrbc_value *str);
 void mrbc_string_clear(mrbc_value *str);
 mrbc_value mrbc_string_dup(mrbc_vm *vm, mrbc_value *s1);
+mrbc_value mrbc_string_substr(mrbc_vm *vm, mrbc_value *src, int ofs, int len);
 mrbc_value mrbc_string_add(mrbc_vm *vm, const mrbc_value *s1, const mrbc_value *s2);
 int mrbc_string_append(mrbc_value *s1, const mrbc_value *s2);
 int mrbc_string_append_cbuf(mrbc_value *s1, const void *s2, int len2);
+int mrbc_string_reserve(mrbc_value *str, int capacity);
+int mrbc_string_unshare(mrbc_value *str);
+int mrbc_string_shrink(mrbc_value *str);
+uint32_t mrbc_string_hash(const mrbc_value *str);
+int mrbc_string_search(const void *str, int len, const void *pattern, int pattern_len);
 int mrbc_string_index(const mrbc_value *src, const mrbc_value *pattern, int offset);
 int mrbc_string_strip(mrbc_value *src, int mode);
 int mrbc_string_chomp(mrbc_value *src);
@@ -73,6 +113,7 @@ int mrbc_string_upcase(mrbc_value *str);
 int mrbc_string_downcase(mrbc_value *str);
 int mrbc_string_utf8_size(const char *str);
 int mrbc_string_char_size(const char *str, int len);
+int mrbc_string_char_count(const mrbc_value *src);
 int mrbc_string_chars2bytes(mrbc_value *src, int off, int idx);
 int mrbc_string_bytes2chars(const mrbc_value *src, int byte_index);
 //@endcond
@@ -98,6 +139,8 @@ static inline mrbc_value mrbc_string_new_cstr(mrbc_vm *vm, const char *src)
 */
 static inline int mrbc_string_compare(const mrbc_value *v1, const mrbc_value *v2)
 {
+  if( v1->string == v2->string ) return 0;
+
   int len = (v1->string->size < v2->string->size) ?
     v1->string->size : v2->string->size;
 
@@ -107,6 +150,42 @@ static inline int mrbc_string_compare(const mrbc_value *v1, const mrbc_value *v2
   return v1->string->size - v2->string->size;
 }
 
+//================================================================
+/*! check equality
+
+  Strings that differ in size or in calculated hash value are not
+  compared by contents.
+
+  @return	1 if equal.
+*/
+static inline int mrbc_string_equal(const mrbc_value *v1, const mrbc_value *v2)
+{
+  const mrbc_string *s1 = v1->string;
+  const mrbc_string *s2 = v2->string;
+
+  if( s1 == s2 ) return 1;
+  if( s1->size != s2->size ) return 0;
+  if( s1->hash && s2->hash && s1->hash != s2->hash ) return 0;
+
+  return memcmp(s1->data, s2->data, s1->size) == 0;
+}
+
+//================================================================
+/*! discard the cached hash value and the character index,
+  when the contents are modified.
+*/
+static inline void mrbc_string_reset_cache(mrbc_value *str)
+{
+  str->string->hash = 0;
+#if MRBC_USE_STRING_UTF8
+  str->string->char_state = MRBC_STRING_CHARS_UNKNOWN;
+  if( str->string->char_index ) {
+    mrbc_raw_free( str->string->char_index );
+    str->string->char_index = NULL;
+  }
+#endif
+}
+
 //================================================================
 /*! get size
 */
@@ -117,9 +196,14 @@ static inline int mrbc_string_size(const mrbc_value *str)
 
 //================================================================
 /*! get c-language string (char *)
+
+  A shared substring that is not terminated by '\0' is copied here.
 */
 static inline char * mrbc_string_cstr(const mrbc_value *v)
 {
+  if( v->string->shared && v->string->data[v->string->size] != '\0' ) {
+    mrbc_string_unshare( (mrbc_value *)v );
+  }
   return (char*)v->string->data;
 }
 
@@ -25,14 +25,43 @@
 #include "mrubyc.h"
 
 /***** Constant values ******************************************************/
+#if !defined(MRBC_IVAR_SIZE_INCREMENT)
+#define MRBC_IVAR_SIZE_INCREMENT 4
+#endif
+
 /***** Macros ***************************************************************/
 #define IS_CLASS_OR_MODULE(v) \
   (mrbc_type(v) == MRBC_TT_CLASS || mrbc_type(v) == MRBC_TT_MODULE)
 
 
 /***** Typedefs *************************************************************/
+#if MRBC_METHOD_CACHE_SIZE > 0
+//================================================================
+/*!@brief
+  Global method cache entry.
+*/
+typedef struct METHOD_CACHE {
+  struct RClass *cls;		//!< search class. (key)
+  mrbc_sym sym_id;		//!< search symbol id. (key)
+  mrbc_method method;		//!< found method. (type == 0 if not found)
+} mrbc_method_cache;
+#endif
+
+
 /***** Function prototypes **************************************************/
 /***** Local variables ******************************************************/
+#if MRBC_METHOD_CACHE_SIZE > 0
+//! global method cache. (direct mapped by class and symbol id)
+static mrbc_method_cache method_cache[MRBC_METHOD_CACHE_SIZE];
+static uint32_t method_cache_hit;
+static uint32_t method_cache_miss;
+#endif
+
+//! root of the shape tree. (no instance variables)
+static mrbc_shape root_shape;
+static int num_shapes;		//!< number of shapes made.
+
+
 /***** Global variables *****************************************************/
 /*! Builtin class table.
 
@@ -66,6 +95,20 @@ mrbc_class * const mrbc_class_tbl[MRBC_TT_MAXVAL+1] = {
   0,                            // MRBC_TT_EXCEPTION = 15,
 };
 
+/*! Method definition epoch.
+
+  Incremented whenever a method table or a class tree is changed.
+  Method caches that hold an old epoch are invalid.
+*/
+uint32_t mrbc_method_epoch;
+
+/*! Shape of the instances that store variables in a key-value table.
+
+  Given instead of a new shape, when MRBC_MAX_SHAPES shapes are made.
+  It is not in the shape tree, and has no slots.
+*/
+mrbc_shape mrbc_kv_shape;
+
 
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
@@ -115,6 +158,82 @@ mrbc_class * mrbc_traverse_class_tree_skip( mrbc_class *nest_buf[], int *nest_id
 }
 
 
+//================================================================
+/*! find method without the method cache.
+
+  @param  r_method	pointer to mrbc_method to return values.
+  @param  cls		search class or module.
+  @param  sym_id	search symbol id.
+  @return		pointer to class if found, otherwise NULL.
+*/
+static mrbc_class * find_method( mrbc_method *r_method, mrbc_class *cls, mrbc_sym sym_id )
+{
+  mrbc_class *nest_buf[MRBC_TRAVERSE_NEST_LEVEL];
+  int nest_idx = 0;
+  int flag_module = cls->flag_module;
+  mrbc_class *cls_save = cls;
+
+  if( cls->flag_alias ) {
+    if( cls->super ) nest_buf[nest_idx++] = cls;
+    cls = cls->aliased;
+  }
+
+  while( 1 ) {
+    mrbc_method *method;
+
+    assert( !cls->flag_alias );
+    if( cls->flag_nomethod ) goto next_class;
+    for( method = cls->method_link; method != 0; method = method->next ) {
+      if( method->sym_id == sym_id ) {
+        *r_method = *method;
+        r_method->cls = cls_save;
+        return cls_save;
+      }
+    }
+
+    struct RBuiltinClass *c = (struct RBuiltinClass *)cls;
+    int right = c->num_builtin_method;
+    if( right == 0 ) goto next_class;
+    right--;
+    int left = 0;
+
+    while( left < right ) {
+      int mid = (left + right) / 2;
+      if( c->method_symbols[mid] < sym_id ) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+
+    if( c->method_symbols[right] == sym_id ) {
+      *r_method = (mrbc_method){
+        .type = 'm',
+        .c_func = 2,
+        .sym_id = sym_id,
+        .func = c->method_functions[right],
+        .cls = cls_save,
+      };
+      return cls_save;
+    }
+
+  next_class:
+    cls = mrbc_traverse_class_tree( cls, nest_buf, &nest_idx );
+    if( cls == NULL ) {
+      if( !flag_module ) break;
+      cls = MRBC_CLASS(Object);
+      flag_module = 0;
+    }
+    cls_save = cls;
+    if( cls->flag_alias ) {
+      cls = cls->aliased;
+    }
+  }  // loop next.
+
+  return NULL;
+}
+
+
 /***** Global functions *****************************************************/
 
 //----------------------------------------------------------------
@@ -267,6 +386,40 @@ void mrbc_define_method(struct VM *vm, mrbc_class *cls, const char *name, mrbc_f
   method->func = cfunc;
   method->next = cls->method_link;
   cls->method_link = method;
+
+  mrbc_clear_method_cache();
+}
+
+
+//================================================================
+/*! clear method caches.
+
+  Call this function when a method table or a class tree is changed.
+*/
+void mrbc_clear_method_cache(void)
+{
+  mrbc_method_epoch++;
+#if MRBC_METHOD_CACHE_SIZE > 0
+  memset( method_cache, 0, sizeof(method_cache) );
+#endif
+}
+
+
+//================================================================
+/*! statistics of the global method cache.
+
+  @param  hit	returns number of cache hits.
+  @param  miss	returns number of cache misses.
+*/
+void mrbc_method_cache_statistics( unsigned long *hit, unsigned long *miss )
+{
+#if MRBC_METHOD_CACHE_SIZE > 0
+  *hit = method_cache_hit;
+  *miss = method_cache_miss;
+#else
+  *hit = 0;
+  *miss = 0;
+#endif
 }
 
 
@@ -285,7 +438,8 @@ mrbc_value mrbc_instance_new(struct VM *vm, mrbc_class *cls, int size)
   *instance = (mrbc_instance){
     MRBC_INIT_OBJECT_HEADER_DI(IN)
     .cls = cls,
-    .ivar = MRBC_KVH_INITIALIZER(vm),
+    .shape = &root_shape,
+    .ivar = NULL,
   };
 
   return mrbc_immediate_value(MRBC_TT_OBJECT, .instance = instance);
@@ -306,8 +460,16 @@ void mrbc_instance_delete(mrbc_value *v)
   if( !cls->flag_builtin && cls->destructor ) cls->destructor( v );
 #endif
 
-  mrbc_kv_delete_data( &v->instance->ivar );
-  mrbc_raw_free( v->instance );
+  mrbc_instance *instance = v->instance;
+  if( instance->shape == &mrbc_kv_shape ) {
+    mrbc_kv_delete( instance->ivar_kv );
+  } else {
+    for( int i = 0; i < instance->shape->num_ivar; i++ ) {
+      mrbc_decref( &instance->ivar[i] );
+    }
+    if( instance->ivar ) mrbc_raw_free( instance->ivar );
+  }
+  mrbc_raw_free( instance );
 }
 
 
@@ -321,20 +483,42 @@ void mrbc_instance_delete(mrbc_value *v)
 */
 int mrbc_instance_setiv(mrbc_value *target, mrbc_sym sym_id, mrbc_value *v)
 {
-  mrbc_kv_handle *kvh;
-
   assert(mrbc_type(*target) == MRBC_TT_CLASS ||
 	 mrbc_type(*target) == MRBC_TT_OBJECT);
 
   if( mrbc_type(*target) == MRBC_TT_CLASS ) {
     if( target->cls->flag_builtin ) return E_NOTIMP_ERROR;
-    kvh = &target->cls->ivar;
-  } else {
-    kvh = &target->instance->ivar;
+    mrbc_incref(v);
+    mrbc_kv_set( &target->cls->ivar, sym_id, v );
+    return 0;
+  }
+
+  mrbc_instance *instance = target->instance;
+  if( instance->shape == &mrbc_kv_shape ) {
+    mrbc_incref(v);
+    return mrbc_kv_set( instance->ivar_kv, sym_id, v );
   }
 
+  int idx = mrbc_shape_index( instance->shape, sym_id );
+
+  // replace value?
+  if( idx >= 0 ) {
+    mrbc_incref(v);
+    mrbc_decref( &instance->ivar[idx] );
+    instance->ivar[idx] = *v;
+    return 0;
+  }
+
+  // add a new variable.
+  mrbc_shape *shape = mrbc_shape_transition( instance->shape, sym_id );
+  if( !shape ) return E_NOMEMORY_ERROR;
+  if( mrbc_instance_set_shape( instance, shape ) != 0 ) return E_NOMEMORY_ERROR;
+
   mrbc_incref(v);
-  mrbc_kv_set( kvh, sym_id, v );
+  if( shape == &mrbc_kv_shape ) {
+    return mrbc_kv_set( instance->ivar_kv, sym_id, v );
+  }
+  instance->ivar[shape->num_ivar - 1] = *v;
 
   return 0;
 }
@@ -349,19 +533,17 @@ int mrbc_instance_setiv(mrbc_value *target, mrbc_sym sym_id, mrbc_value *v)
 */
 mrbc_value mrbc_instance_getiv(mrbc_value *target, mrbc_sym sym_id)
 {
-  mrbc_kv_handle *kvh;
+  mrbc_value *v;
 
   assert(mrbc_type(*target) == MRBC_TT_CLASS ||
 	 mrbc_type(*target) == MRBC_TT_OBJECT);
 
   if( mrbc_type(*target) == MRBC_TT_CLASS ) {
     if( target->cls->flag_builtin ) return mrbc_nil_value();
-    kvh = &target->cls->ivar;
+    v = mrbc_kv_get( &target->cls->ivar, sym_id );
   } else {
-    kvh = &target->instance->ivar;
+    v = mrbc_instance_getiv_p( target, sym_id );
   }
-
-  mrbc_value *v = mrbc_kv_get( kvh, sym_id );
   if( !v ) return mrbc_nil_value();
 
   mrbc_incref(v);
@@ -369,6 +551,135 @@ mrbc_value mrbc_instance_getiv(mrbc_value *target, mrbc_sym sym_id)
 }
 
 
+//================================================================
+/*! change the shape of instance to the derived one.
+
+  @param  instance	target instance.
+  @param  shape		new shape. (a descendant of current shape, or mrbc_kv_shape)
+  @return		error code.
+  @details
+  Allocates the slots for the added variables, and fill them with nil.
+  To mrbc_kv_shape, the variables are moved to a key-value table.
+*/
+int mrbc_instance_set_shape(mrbc_instance *instance, mrbc_shape *shape)
+{
+  if( shape == &mrbc_kv_shape ) {
+    if( instance->shape == &mrbc_kv_shape ) return 0;
+
+    mrbc_kv_handle *kvh = mrbc_kv_new( 0, instance->shape->num_ivar + 1 );
+    if( !kvh ) return E_NOMEMORY_ERROR;
+
+    const mrbc_shape *s;
+    for( s = instance->shape; s->num_ivar != 0; s = s->parent ) {
+      mrbc_kv_set( kvh, s->sym_id, &instance->ivar[s->num_ivar - 1] );
+    }
+    if( instance->ivar ) mrbc_raw_free( instance->ivar );
+    instance->ivar_kv = kvh;
+    instance->shape = shape;
+    return 0;
+  }
+
+  int old_size = instance->shape->num_ivar;
+  int new_size = shape->num_ivar;
+  int old_capa = (old_size + MRBC_IVAR_SIZE_INCREMENT - 1) / MRBC_IVAR_SIZE_INCREMENT;
+  int new_capa = (new_size + MRBC_IVAR_SIZE_INCREMENT - 1) / MRBC_IVAR_SIZE_INCREMENT;
+
+  if( new_capa != old_capa ) {
+    mrbc_value *ivar = mrbc_raw_realloc( instance->ivar,
+		sizeof(mrbc_value) * new_capa * MRBC_IVAR_SIZE_INCREMENT );
+    if( !ivar ) return E_NOMEMORY_ERROR;
+    instance->ivar = ivar;
+  }
+
+  for( int i = old_size; i < new_size; i++ ) {
+    instance->ivar[i] = mrbc_nil_value();
+  }
+  instance->shape = shape;
+
+  return 0;
+}
+
+
+//================================================================
+/*! copy instance variables.
+
+  @param  src		source instance.
+  @param  dst		destination instance. (must not have variables)
+  @return		error code.
+*/
+int mrbc_instance_dup_ivar(const mrbc_instance *src, mrbc_instance *dst)
+{
+  assert( dst->shape->num_ivar == 0 );
+
+  if( src->shape == &mrbc_kv_shape ) {
+    if( mrbc_instance_set_shape( dst, &mrbc_kv_shape ) != 0 ) return E_NOMEMORY_ERROR;
+    mrbc_kv_dup( src->ivar_kv, dst->ivar_kv );
+    return 0;
+  }
+
+  if( mrbc_instance_set_shape( dst, src->shape ) != 0 ) return E_NOMEMORY_ERROR;
+
+  for( int i = 0; i < src->shape->num_ivar; i++ ) {
+    dst->ivar[i] = src->ivar[i];
+    mrbc_incref( &dst->ivar[i] );
+  }
+
+  return 0;
+}
+
+
+//================================================================
+/*! get the slot index of instance variable.
+
+  @param  shape		target shape.
+  @param  sym_id	variable name.
+  @return		slot index or -1 if not found.
+*/
+int mrbc_shape_index(const mrbc_shape *shape, mrbc_sym sym_id)
+{
+  for( ; shape->num_ivar != 0; shape = shape->parent ) {
+    if( shape->sym_id == sym_id ) return shape->num_ivar - 1;
+  }
+
+  return -1;
+}
+
+
+//================================================================
+/*! get the shape that appends a variable.
+
+  @param  shape		base shape.
+  @param  sym_id	variable name to append.
+  @return		derived shape, mrbc_kv_shape or NULL if no memory.
+*/
+mrbc_shape * mrbc_shape_transition(mrbc_shape *shape, mrbc_sym sym_id)
+{
+  mrbc_shape *child;
+
+  for( child = shape->child; child; child = child->sibling ) {
+    if( child->sym_id == sym_id ) return child;
+  }
+
+  // shapes are shared by all VMs, and never released.
+  // so the number of them is limited.
+  if( num_shapes >= MRBC_MAX_SHAPES ) return &mrbc_kv_shape;
+  child = mrbc_raw_alloc_no_free( sizeof(mrbc_shape) );
+  if( !child ) return NULL;
+  num_shapes++;
+
+  *child = (mrbc_shape){
+    .parent = shape,
+    .child = NULL,
+    .sibling = shape->child,
+    .sym_id = sym_id,
+    .num_ivar = shape->num_ivar + 1,
+  };
+  shape->child = child;
+
+  return child;
+}
+
+
 //================================================================
 /*! Check the class is the class of object.
 
@@ -402,69 +713,31 @@ int mrbc_obj_is_kind_of( const mrbc_value *obj, const mrbc_class *tcls )
 */
 mrbc_class * mrbc_find_method( mrbc_method *r_method, mrbc_class *cls, mrbc_sym sym_id )
 {
-  mrbc_class *nest_buf[MRBC_TRAVERSE_NEST_LEVEL];
-  int nest_idx = 0;
-  int flag_module = cls->flag_module;
-  mrbc_class *cls_save = cls;
-
-  if( cls->flag_alias ) {
-    if( cls->super ) nest_buf[nest_idx++] = cls;
-    cls = cls->aliased;
+#if MRBC_METHOD_CACHE_SIZE > 0
+  mrbc_method_cache *mc = &method_cache[
+    (((uintptr_t)cls >> 3) * 31 + sym_id) & (MRBC_METHOD_CACHE_SIZE - 1) ];
+
+  if( mc->cls == cls && mc->sym_id == sym_id ) {
+    method_cache_hit++;
+    if( mc->method.type == 0 ) return NULL;	// cached "not found".
+    *r_method = mc->method;
+    return r_method->cls;
   }
+  method_cache_miss++;
 
-  while( 1 ) {
-    mrbc_method *method;
-
-    assert( !cls->flag_alias );
-    if( cls->flag_nomethod ) goto next_class;
-    for( method = cls->method_link; method != 0; method = method->next ) {
-      if( method->sym_id == sym_id ) {
-        *r_method = *method;
-        r_method->cls = cls_save;
-        return cls_save;
-      }
-    }
-
-    struct RBuiltinClass *c = (struct RBuiltinClass *)cls;
-    int right = c->num_builtin_method;
-    if( right == 0 ) goto next_class;
-    right--;
-    int left = 0;
-
-    while( left < right ) {
-      int mid = (left + right) / 2;
-      if( c->method_symbols[mid] < sym_id ) {
-        left = mid + 1;
-      } else {
-        right = mid;
-      }
-    }
-
-    if( c->method_symbols[right] == sym_id ) {
-      *r_method = (mrbc_method){
-        .type = 'm',
-        .c_func = 2,
-        .sym_id = sym_id,
-        .func = c->method_functions[right],
-        .cls = cls_save,
-      };
-      return cls_save;
-    }
-
-  next_class:
-    cls = mrbc_traverse_class_tree( cls, nest_buf, &nest_idx );
-    if( cls == NULL ) {
-      if( !flag_module ) break;
-      cls = MRBC_CLASS(Object);
-      flag_module = 0;
-    }
-    cls_save = cls;
-    if( cls->flag_alias ) {
-      cls = cls->aliased;
-    }
-  }  // loop next.
+  mrbc_class *ret = find_method( r_method, cls, sym_id );
+  mc->cls = cls;
+  mc->sym_id = sym_id;
+  if( ret ) {
+    mc->method = *r_method;
+  } else {
+    mc->method.type = 0;
+  }
+  return ret;
 
-  return NULL;
+#else
+  return find_method( r_method, cls, sym_id );
+#endif
 }
 
 
@@ -496,6 +769,8 @@ mrbc_class * mrbc_get_class_by_name( const char *name )
   @param  recv		pointer to receiver.
   @param  method_name	method name.
   @param  n_params	num of params.
+  @note	  The registers after v[argc+1] are used to call the method.
+	  SystemStackError is raised, if there is no room in the register stack.
 
 <b>Examples</b>
 @code
@@ -529,7 +804,12 @@ mrbc_value mrbc_send( struct VM *vm, mrbc_value *v, int argc,
   }
 
   // create call stack.
+  // (the register stack can't grow here, because the caller holds v.)
   mrbc_value *regs = v + argc + 2;
+  if( regs + n_params + 1 >= vm->regs + vm->regs_size ) {
+    mrbc_raise(vm, MRBC_CLASS(SystemStackError), "stack level too deep");
+    goto ERROR;
+  }
   mrbc_decref( &regs[0] );
   regs[0] = *recv;
   mrbc_incref(recv);
@@ -588,7 +868,10 @@ int mrbc_run_mrblib(const void *bytecode)
 
   int ret;
 
-  mrbc_vm_begin(vm);
+  if( mrbc_vm_begin(vm) != 0 ) {
+    mrbc_print_vm_exception(vm);
+    return 2;
+  }
   do {
     ret = mrbc_vm_run(vm);
   } while( ret == 0 );
@@ -608,6 +891,9 @@ int mrbc_run_mrblib(const void *bytecode)
  */
 void mrbc_init_class(void)
 {
+  mrbc_clear_method_cache();
+  root_shape.child = NULL;
+  num_shapes = 0;
   mrbc_init_class_c();
   mrbc_init_class_mrblib();
 }
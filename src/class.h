@@ -171,6 +171,25 @@ struct RBuiltinNoMethodClass {
 };
 
 
+//================================================================
+/*!@brief
+  Instance variable layout. (shape)
+
+  Shapes form a tree. Each shape appends one variable name to its parent.
+  The instances that have the same variables set in the same order
+  share the same shape, and store their values in the same slots.
+  When MRBC_MAX_SHAPES shapes are made, the instances that need a new
+  shape get mrbc_kv_shape, and store their variables in a key-value table.
+*/
+typedef struct RShape {
+  struct RShape *parent;	//!< shape without the last variable.
+  struct RShape *child;		//!< first of the shapes derived from this.
+  struct RShape *sibling;	//!< next shape derived from the same parent.
+  mrbc_sym sym_id;		//!< name of the last variable.
+  uint16_t num_ivar;		//!< number of variables. (= slot index + 1)
+} mrbc_shape;
+
+
 //================================================================
 /*!@brief
   Instance object.
@@ -181,7 +200,11 @@ typedef struct RInstance {
   MRBC_OBJECT_HEADER;
 
   struct RClass *cls;		//!< pointer to class of this object.
-  struct RKeyValueHandle ivar;	//!< instance variable.
+  struct RShape *shape;		//!< instance variable layout.
+  union {
+    mrbc_value *ivar;		//!< instance variable slots.
+    struct RKeyValueHandle *ivar_kv; //!< variables, if shape is mrbc_kv_shape.
+  };
   uint8_t data[];		//!< extended data
 
 } mrbc_instance;
@@ -222,6 +245,8 @@ struct MRBC_DEFINE_METHOD_LIST {
 
 /***** Global variables *****************************************************/
 extern struct RClass * const mrbc_class_tbl[];
+extern uint32_t mrbc_method_epoch;
+extern mrbc_shape mrbc_kv_shape;
 #include "_autogen_builtin_class.h"
 
 // for old version compatibility.
@@ -237,10 +262,16 @@ mrbc_class *mrbc_define_class_under(struct VM *vm, const mrbc_class *outer, cons
 mrbc_class *mrbc_define_module(struct VM *vm, const char *name);
 mrbc_class *mrbc_define_module_under(struct VM *vm, const mrbc_class *outer, const char *name);
 void mrbc_define_method(struct VM *vm, mrbc_class *cls, const char *name, mrbc_func_t cfunc);
+void mrbc_clear_method_cache(void);
+void mrbc_method_cache_statistics(unsigned long *hit, unsigned long *miss);
 mrbc_value mrbc_instance_new(struct VM *vm, mrbc_class *cls, int size);
 void mrbc_instance_delete(mrbc_value *v);
 int mrbc_instance_setiv(mrbc_value *target, mrbc_sym sym_id, mrbc_value *v);
 mrbc_value mrbc_instance_getiv(mrbc_value *target, mrbc_sym sym_id);
+int mrbc_instance_set_shape(mrbc_instance *instance, mrbc_shape *shape);
+int mrbc_instance_dup_ivar(const mrbc_instance *src, mrbc_instance *dst);
+int mrbc_shape_index(const mrbc_shape *shape, mrbc_sym sym_id);
+mrbc_shape *mrbc_shape_transition(mrbc_shape *shape, mrbc_sym sym_id);
 int mrbc_obj_is_kind_of(const mrbc_value *obj, const mrbc_class *tcls);
 mrbc_class *mrbc_find_method(mrbc_method *r_method, mrbc_class *cls, mrbc_sym sym_id);
 mrbc_class *mrbc_get_class_by_name(const char *name);
@@ -319,7 +350,14 @@ static inline void mrbc_define_destructor( mrbc_class *cls, void (*destructor)(m
 */
 static inline mrbc_value * mrbc_instance_getiv_p(mrbc_value *obj, mrbc_sym sym_id)
 {
-  return mrbc_kv_get( &obj->instance->ivar, sym_id );
+  if( obj->instance->shape == &mrbc_kv_shape ) {
+    return mrbc_kv_get( obj->instance->ivar_kv, sym_id );
+  }
+
+  int idx = mrbc_shape_index( obj->instance->shape, sym_id );
+  if( idx < 0 ) return NULL;
+
+  return &obj->instance->ivar[idx];
 }
 
 
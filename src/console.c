@@ -36,9 +36,40 @@
 /***** Typedefs *************************************************************/
 /***** Function prototypes **************************************************/
 /***** Local variables ******************************************************/
+#if MRBC_CONSOLE_BUFFER_SIZE > 0
+static char console_buf_[MRBC_CONSOLE_BUFFER_SIZE];	//!< output buffer.
+static int console_buf_len_;				//!< length in buffer.
+#endif
+
+
 /***** Global variables *****************************************************/
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
+//----------------------------------------------------------------
+/* write to the console through the output buffer.
+   The buffer is flushed when it is full, or when a newline is written.
+*/
+static void console_write( const char *str, int size )
+{
+#if MRBC_CONSOLE_BUFFER_SIZE > 0
+  if( console_buf_len_ + size > MRBC_CONSOLE_BUFFER_SIZE ) {
+    mrbc_flush();
+    if( size >= MRBC_CONSOLE_BUFFER_SIZE ) {	// too long to buffer.
+      mrbc_hal_write(1, str, size);
+      return;
+    }
+  }
+
+  memcpy( console_buf_ + console_buf_len_, str, size );
+  console_buf_len_ += size;
+  if( memchr( str, '\n', size ) ) mrbc_flush();
+
+#else
+  mrbc_hal_write(1, str, size);
+#endif
+}
+
+
 //----------------------------------------------------------------
 /* sub function for mrbc_printf
 */
@@ -133,13 +164,30 @@ void mrbc_putchar(char c)
 #if defined(MRBC_CONVERT_CRLF)
   static const char CRLF[2] = "\r\n";
   if( c == '\n' ) {
-    mrbc_hal_write(1, CRLF, 2);
+    console_write(CRLF, 2);
   } else {
-    mrbc_hal_write(1, &c, 1);
+    console_write(&c, 1);
   }
 
 #else
-    mrbc_hal_write(1, &c, 1);
+    console_write(&c, 1);
+#endif
+}
+
+
+//================================================================
+/*! write the buffered console output.
+
+  Called at the end of print methods, the task switch and the end of
+  VM. Call it to show the output without newline immediately from C code.
+*/
+void mrbc_flush(void)
+{
+#if MRBC_CONSOLE_BUFFER_SIZE > 0
+  if( console_buf_len_ == 0 ) return;
+
+  mrbc_hal_write(1, console_buf_, console_buf_len_);
+  console_buf_len_ = 0;
 #endif
 }
 
@@ -182,17 +230,17 @@ void mrbc_nprint(const char *str, int size)
 
   for( int i = 0; i < size; i++ ) {
     if( *p1++ == '\n' ) {
-      mrbc_hal_write(1, p2, p1 - p2 - 1);
-      mrbc_hal_write(1, CRLF, 2);
+      console_write(p2, p1 - p2 - 1);
+      console_write(CRLF, 2);
       p2 = p1;
     }
   }
   if( p1 != p2 ) {
-    mrbc_hal_write(1, p2, p1 - p2);
+    console_write(p2, p1 - p2);
   }
 
 #else
-  mrbc_hal_write(1, str, size);
+  console_write(str, size);
 #endif
 }
 
@@ -545,12 +593,24 @@ int mrbc_print_sub(const mrbc_value *v)
     mrbc_print_symbol( mrbc_find_class_by_object(v)->sym_id );
     mrbc_printf(":%08x", MRBC_PTR_TO_UINT32(v->instance) );
 
-    mrbc_kv_iterator ite = mrbc_kv_iterator_new( &(v->instance->ivar) );
-    while( mrbc_kv_i_has_next( &ite ) ) {
-      mrbc_printf( mrbc_kv_i_is_first(&ite) ? " " : ", " );
-      const mrbc_kv *kv = mrbc_kv_i_next( &ite );
-      mrbc_printf("@%s=", mrbc_symid_to_str(kv->sym_id));
-      mrbc_p_sub(&kv->value);
+    const mrbc_instance *instance = v->instance;
+    if( instance->shape == &mrbc_kv_shape ) {
+      mrbc_kv_iterator ite = mrbc_kv_iterator_new( instance->ivar_kv );
+      while( mrbc_kv_i_has_next( &ite ) ) {
+        mrbc_printf( mrbc_kv_i_is_first(&ite) ? " " : ", " );
+        const mrbc_kv *kv = mrbc_kv_i_next( &ite );
+        mrbc_printf("@%s=", mrbc_symid_to_str(kv->sym_id));
+        mrbc_p_sub(&kv->value);
+      }
+    }
+    for( int i = 0; i < instance->shape->num_ivar; i++ ) {
+      // find the name of slot i.
+      const mrbc_shape *shape = instance->shape;
+      while( shape->num_ivar != i+1 ) shape = shape->parent;
+
+      mrbc_printf( i == 0 ? " " : ", " );
+      mrbc_printf("@%s=", mrbc_symid_to_str(shape->sym_id));
+      mrbc_p_sub(&instance->ivar[i]);
     }
     mrbc_printf(">");
   } break;
@@ -75,6 +75,7 @@ typedef struct RPrintf {
 /***** Function prototypes **************************************************/
 //@cond
 void mrbc_putchar(char c);
+void mrbc_flush(void);
 void mrbc_print_symbol(mrbc_sym sym_id);
 void mrbc_nprint(const char *str, int size);
 void mrbc_printf(const char *fstr, ...);
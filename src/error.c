@@ -299,6 +299,7 @@ static void c_exception_message(struct VM *vm, mrbc_value v[], int argc)
     Exception
       NoMemoryError
       NotImplementedError
+      SystemStackError
       StandardError
         ArgumentError
         IndexError
@@ -323,6 +324,7 @@ static void c_exception_message(struct VM *vm, mrbc_value v[], int argc)
 
   CLASS("NoMemoryError            < Exception")
   CLASS("NotImplementedError      < Exception")
+  CLASS("SystemStackError         < Exception")
   CLASS("StandardError            < Exception")
   CLASS("  ArgumentError          < StandardError")
   CLASS("  IndexError             < StandardError")
@@ -30,6 +30,9 @@ static mrbc_kv_handle handle_const;	//!< for global(Object) constants.
 static mrbc_kv_handle handle_global;	//!< for global variables.
 
 /***** Global variables *****************************************************/
+//! constant definition epoch. (incremented when any constant is set)
+uint32_t mrbc_const_epoch;
+
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
 /***** Global functions *****************************************************/
@@ -41,6 +44,7 @@ void mrbc_init_global(void)
 {
   mrbc_kv_init_handle( 0, &handle_const, 30 );
   mrbc_kv_init_handle( 0, &handle_global, 0 );
+  mrbc_const_epoch++;
 #if defined(MRBC_DEBUG)
   handle_const.data->obj_mark_[0] = 'C';	// "CV"
 #endif
@@ -62,6 +66,8 @@ int mrbc_set_const( mrbc_sym sym_id, mrbc_value *v )
     mrbc_print("\n");
   }
 
+  // the table may be reallocated, so cached pointers are invalid after this.
+  mrbc_const_epoch++;
   return mrbc_kv_set( &handle_const, sym_id, v );
 }
 
@@ -28,6 +28,8 @@ extern "C" {
 /***** Macros ***************************************************************/
 /***** Typedefs *************************************************************/
 /***** Global variables *****************************************************/
+extern uint32_t mrbc_const_epoch;
+
 /***** Function prototypes **************************************************/
 //@cond
 void mrbc_init_global(void);
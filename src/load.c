@@ -23,6 +23,7 @@
 //@endcond
 
 /***** Local headers ********************************************************/
+#include "opcode.h"
 #include "mrubyc.h"
 
 /***** Constat values *******************************************************/
@@ -50,10 +51,393 @@ enum irep_pool_type {
 /***** Macros ***************************************************************/
 /***** Typedefs *************************************************************/
 /***** Function prototypes **************************************************/
+static mrbc_value pool_value(mrbc_vm *vm, const uint8_t *p);
+
+
 /***** Local variables ******************************************************/
+#if MRBC_USE_INST_FUSION || MRBC_USE_PREDECODE
+//! operand types. (see opcode.h)
+enum operand_type {
+  OPR_Z, OPR_B, OPR_BB, OPR_BBB, OPR_BS, OPR_BSS, OPR_S, OPR_W,
+};
+
+//! operand type of each opcode.
+static const uint8_t operand_type[OP_STOP+1] = {
+  OPR_Z,    OPR_BB,   OPR_BB,   OPR_BB,   OPR_BB,   OPR_B,    OPR_B,    OPR_B,	// 0x00
+  OPR_B,    OPR_B,    OPR_B,    OPR_B,    OPR_B,    OPR_B,    OPR_BS,   OPR_BSS,	// 0x08
+  OPR_BB,   OPR_B,    OPR_B,    OPR_B,    OPR_B,    OPR_BB,   OPR_BB,   OPR_BB,	// 0x10
+  OPR_BB,   OPR_BB,   OPR_BB,   OPR_BB,   OPR_BB,   OPR_BB,   OPR_BB,   OPR_BB,	// 0x18
+  OPR_BB,   OPR_BBB,  OPR_BBB,  OPR_B,    OPR_BB,   OPR_B,    OPR_S,    OPR_BS,	// 0x20
+  OPR_BS,   OPR_BS,   OPR_S,    OPR_B,    OPR_BB,   OPR_B,    OPR_B,    OPR_BBB,	// 0x28
+  OPR_BB,   OPR_BBB,  OPR_BBB,  OPR_BB,   OPR_BBB,  OPR_Z,    OPR_BB,   OPR_BB,	// 0x30
+  OPR_BS,   OPR_W,    OPR_BB,   OPR_Z,    OPR_BB,   OPR_B,    OPR_B,    OPR_Z,	// 0x38
+  OPR_Z,    OPR_Z,    OPR_Z,    OPR_B,    OPR_BS,   OPR_B,    OPR_BB,   OPR_B,	// 0x40
+  OPR_BB,   OPR_BBB,  OPR_BBB,  OPR_B,    OPR_B,    OPR_B,    OPR_B,    OPR_B,	// 0x48
+  OPR_B,    OPR_B,    OPR_BB,   OPR_BBB,  OPR_B,    OPR_BB,   OPR_B,    OPR_BBB,	// 0x50
+  OPR_BBB,  OPR_BBB,  OPR_B,    OPR_BB,   OPR_BB,   OPR_B,    OPR_BB,   OPR_BB,	// 0x58
+  OPR_B,    OPR_BB,   OPR_BB,   OPR_BB,   OPR_B,    OPR_B,    OPR_B,    OPR_BB,	// 0x60
+  OPR_BB,   OPR_BB,   OPR_BB,   OPR_BBB,  OPR_BBB,  OPR_BB,   OPR_B,    OPR_B,	// 0x68
+  OPR_B,    OPR_BBB,  OPR_B,    OPR_Z,    OPR_Z,    OPR_Z,    OPR_Z,	// 0x70
+};
+
+//! operand size of each operand type. (without OP_EXTn prefix)
+static const uint8_t operand_size[] = { 0, 1, 2, 3, 3, 5, 2, 3 };
+#endif
+
 /***** Global variables *****************************************************/
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
+#if MRBC_USE_INST_FUSION
+//================================================================
+/*! get the fused opcode of the instruction pair.
+
+  @param  op1	opcode of 1st instruction.
+  @param  op2	opcode of 2nd instruction.
+  @return	fused opcode or 0 if it can't be fused.
+*/
+static int fused_opcode( int op1, int op2 )
+{
+  switch( op2 ) {
+  case OP_ADD:
+    if( OP_LOADI__1 <= op1 && op1 <= OP_LOADI_7 ) {
+      return op1 - OP_LOADI__1 + OP_LOADI__1_ADD;
+    }
+    break;
+
+  case OP_SEND:
+    if( op1 == OP_MOVE ) return OP_MOVE_SEND;
+    break;
+
+  case OP_SSEND:
+    if( op1 == OP_MOVE ) return OP_MOVE_SSEND;
+    break;
+
+  case OP_SEND0:
+    if( op1 == OP_GETIV ) return OP_GETIV_SEND0;
+    break;
+
+  case OP_JMPNOT:
+    switch( op1 ) {
+    case OP_EQ: return OP_EQ_JMPNOT;
+    case OP_LT: return OP_LT_JMPNOT;
+    case OP_LE: return OP_LE_JMPNOT;
+    case OP_GT: return OP_GT_JMPNOT;
+    case OP_GE: return OP_GE_JMPNOT;
+    }
+    break;
+
+  case OP_JMPIF:
+    switch( op1 ) {
+    case OP_EQ: return OP_EQ_JMPIF;
+    case OP_LT: return OP_LT_JMPIF;
+    case OP_LE: return OP_LE_JMPIF;
+    case OP_GT: return OP_GT_JMPIF;
+    case OP_GE: return OP_GE_JMPIF;
+    }
+    break;
+
+  case OP_RETURN:
+    if( op1 == OP_LOADNIL ) return OP_LOADNIL_RETURN;
+    break;
+  }
+
+  return 0;
+}
+
+
+#if !MRBC_USE_PREDECODE
+//================================================================
+/*! Rewrite common instruction pairs into fused instructions.
+
+  @param  inst	pointer to instructions in RAM.
+  @param  ilen	num of bytes in instructions.
+
+  The opcode of the 1st instruction is replaced, and the 2nd
+  instruction is left as it is. So that the length of code does not
+  change, and jump offsets and catch handlers need not be modified.
+*/
+static void fuse_instructions( uint8_t *inst, int ilen )
+{
+  uint8_t *p = inst;
+  const uint8_t *end = inst + ilen;
+
+  while( p < end ) {
+    int op = *p;
+    int ext = 0;
+
+    if( OP_EXT1 <= op && op <= OP_EXT3 ) {
+      ext = op - OP_EXT1 + 1;
+      op = *++p;
+    }
+    if( op > OP_STOP || (OP_EXT1 <= op && op <= OP_EXT3) ) return;
+
+    int len = 1 + operand_size[operand_type[op]] + (ext & 1) + (ext >> 1);
+    if( ext == 0 && p + len < end ) {
+      int op2 = p[len];
+      int fused = op2 <= OP_STOP ? fused_opcode( op, op2 ) : 0;
+      if( fused ) {
+        *p = fused;
+        len += 1 + operand_size[operand_type[op2]];
+      }
+    }
+    p += len;
+  }
+}
+
+#else
+//================================================================
+/*! Rewrite common instruction pairs into fused instructions.
+
+  @param  inst	pointer to pre-decoded instructions.
+  @param  n	num of instructions.
+*/
+static void fuse_instructions( mrbc_inst *inst, int n )
+{
+  for( int i = 0; i < n-1; i++ ) {
+    int fused = fused_opcode( inst[i].op, inst[i+1].op );
+    if( fused ) {
+      inst[i++].op = fused;	// the 2nd instruction is not fused again.
+    }
+  }
+}
+#endif
+#endif
+
+
+#if MRBC_USE_PREDECODE
+//================================================================
+/*! Make a table to convert byte offset to instruction index.
+
+  @param  inst	pointer to RITE instructions.
+  @param  ilen	num of bytes in instructions.
+  @param  map	table to be made. (ilen+1 entries, or NULL to count only)
+  @return	num of instructions, or -1 if illegal bytecode.
+  @note		The entries in the middle of instructions are 0xffff.
+*/
+static int map_instructions( const uint8_t *inst, int ilen, uint16_t *map )
+{
+  int pos = 0;
+  int n = 0;
+
+  if( map ) memset( map, 0xff, sizeof(uint16_t) * (ilen + 1) );
+  while( pos < ilen ) {
+    int op = inst[pos];
+    int ext = 0;
+
+    if( map ) map[pos] = n;
+    if( OP_EXT1 <= op && op <= OP_EXT3 ) {
+      ext = op - OP_EXT1 + 1;
+      if( ++pos >= ilen ) return -1;
+      if( map ) map[pos] = n;
+      op = inst[pos];
+    }
+    if( op > OP_STOP || (OP_EXT1 <= op && op <= OP_EXT3) ) return -1;
+
+    pos += 1 + operand_size[operand_type[op]] + (ext & 1) + (ext >> 1);
+    n++;
+  }
+  if( pos != ilen ) return -1;
+  if( map ) map[pos] = n;
+
+  return n;
+}
+
+
+//================================================================
+/*! Translate RITE instructions into the pre-decoded instructions.
+
+  @param  irep	pointer to irep. (symbol table is already made)
+  @param  src	pointer to RITE instructions.
+  @param  map	byte offset to instruction index table.
+  @param  dst	pointer to the destination.
+  @return	zero if no error.
+*/
+static int decode_instructions( const mrbc_irep *irep, const uint8_t *src, const uint16_t *map, mrbc_inst *dst )
+{
+  const uint8_t *p = src;
+  const uint8_t *end = src + irep->ilen;
+
+  for( ; p < end; dst++ ) {
+    int ext = 0;
+    int op = *p++;
+    if( OP_EXT1 <= op && op <= OP_EXT3 ) {
+      ext = op - OP_EXT1 + 1;
+      op = *p++;
+    }
+
+    unsigned int a = 0, b = 0, c = 0;
+    switch( operand_type[op] ) {
+    case OPR_B:
+    case OPR_BB:
+    case OPR_BBB:
+      a = *p++;    if( ext & 1 ) a = a << 8 | *p++;
+      if( operand_type[op] == OPR_B ) break;
+      b = *p++;    if( ext & 2 ) b = b << 8 | *p++;
+      if( operand_type[op] == OPR_BB ) break;
+      c = *p++;
+      break;
+
+    case OPR_BS:
+    case OPR_BSS:
+      a = *p++;    if( ext & 1 ) a = a << 8 | *p++;
+      b = bin_to_uint16(p); p += 2;
+      if( operand_type[op] == OPR_BS ) break;
+      c = bin_to_uint16(p); p += 2;
+      break;
+
+    case OPR_S:
+      a = bin_to_uint16(p); p += 2;
+      break;
+
+    case OPR_W:
+      a = *p++;
+      b = bin_to_uint16(p); p += 2;
+      break;
+    }
+
+    // resolve symbol operands, and convert jump offsets.
+    unsigned int *jump = 0;
+    switch( op ) {
+    case OP_LOADSYM:
+    case OP_GETGV: case OP_SETGV: case OP_GETSV: case OP_SETSV:
+    case OP_GETIV: case OP_SETIV: case OP_GETCV: case OP_SETCV:
+    case OP_GETCONST: case OP_SETCONST: case OP_GETMCNST: case OP_SETMCNST:
+    case OP_SSEND: case OP_SSEND0: case OP_SSENDB:
+    case OP_SEND: case OP_SEND0: case OP_SENDB:
+    case OP_KEY_P: case OP_KARG:
+    case OP_CLASS: case OP_MODULE: case OP_DEF: case OP_TDEF: case OP_SDEF:
+      b = mrbc_irep_symbol_id(irep, b);
+      break;
+
+    case OP_ALIAS:
+      a = mrbc_irep_symbol_id(irep, a);
+      b = mrbc_irep_symbol_id(irep, b);
+      break;
+
+    case OP_UNDEF:
+      a = mrbc_irep_symbol_id(irep, a);
+      break;
+
+    case OP_JMP:
+    case OP_JMPUW:
+      jump = &a;
+      break;
+
+    case OP_JMPIF:
+    case OP_JMPNOT:
+    case OP_JMPNIL:
+      jump = &b;
+      break;
+    }
+    if( jump ) {
+      int target = (p - src) + (int16_t)*jump;
+      if( target < 0 || target > irep->ilen ) return -1;
+      if( map[target] == 0xffff ) return -1;
+      *jump = (uint16_t)(map[target] - map[p - src]);
+    }
+
+    dst->op = op;
+    dst->reserved = 0;
+    dst->a = a;
+    dst->b = b;
+    dst->c = c;
+  }
+
+  return 0;
+}
+
+
+//================================================================
+/*! Resolve numeric literals in the pool.
+
+  @param  vm	A pointer to VM.
+  @param  irep	pointer to irep. (pool offset table is already made)
+  @param  dst	pointer to the destination. (plen entries)
+  @note		The others are set to MRBC_TT_EMPTY, and made at run time.
+*/
+static void resolve_pool_values( mrbc_vm *vm, const mrbc_irep *irep, mrbc_value *dst )
+{
+  for( int i = 0; i < irep->plen; i++ ) {
+    const uint8_t *p = mrbc_irep_pool_ptr(irep, i);
+
+    switch( *p ) {
+    case IREP_TT_INT32:
+#if MRBC_USE_FLOAT
+    case IREP_TT_FLOAT:
+#endif
+#if defined(MRBC_INT64)
+    case IREP_TT_INT64:
+    case IREP_TT_BIGINT:
+#endif
+      dst[i] = pool_value( vm, p );
+      break;
+
+    default:
+      dst[i] = (mrbc_value){.tt = MRBC_TT_EMPTY};
+    }
+  }
+}
+#endif
+
+
+//================================================================
+/*! Decode catch handlers, and make the sorted catch ranges.
+
+  @param  irep	pointer to irep. (clen is already set)
+  @param  src	pointer to RITE catch handlers.
+  @param  map	byte offset to instruction index table. (pre-decode only)
+*/
+static void decode_catch_handlers( mrbc_irep *irep, const uint8_t *src, const uint16_t *map )
+{
+  mrbc_irep_catch_handler *handler = mrbc_irep_catch_handlers(irep);
+  mrbc_irep_catch_range *range = mrbc_irep_catch_ranges(irep);
+  int clen = irep->clen;
+  int n = 0;
+
+  for( int i = 0; i < clen; i++, src += SIZE_RITE_CATCH_HANDLER ) {
+    handler[i].type = src[0];
+    handler[i].begin = bin_to_uint32( src + 1 );
+    handler[i].end = bin_to_uint32( src + 5 );
+    handler[i].target = bin_to_uint32( src + 9 );
+#if MRBC_USE_PREDECODE
+    handler[i].begin = map[handler[i].begin] * sizeof(mrbc_inst);
+    handler[i].end = map[handler[i].end] * sizeof(mrbc_inst);
+    handler[i].target = map[handler[i].target] * sizeof(mrbc_inst);
+#endif
+  }
+
+  // split the addresses at the begin and end of each handler.
+  for( int i = 0; i < clen * 2; i++ ) {
+    uint32_t addr = (i & 1) ? handler[i/2].end : handler[i/2].begin;
+    int j = n;
+    while( j > 0 && range[j-1].begin > addr ) j--;
+    if( j > 0 && range[j-1].begin == addr ) continue;	// already exists.
+
+    memmove( range + j + 1, range + j, sizeof(mrbc_irep_catch_range) * (n - j) );
+    range[j].begin = addr;
+    n++;
+  }
+
+  // find the innermost handlers of each range, in the same order as
+  // searching the catch handlers from the end.
+  for( int j = 0; j < n; j++ ) {
+    uint32_t inst = range[j].begin + 1;
+    range[j].handler = -1;
+    range[j].ensure = -1;
+
+    for( int i = clen - 1; i >= 0; i-- ) {
+      if( !(handler[i].begin < inst && inst <= handler[i].end) ) continue;
+      if( range[j].handler < 0 ) range[j].handler = i;
+      if( handler[i].type == 1 ) {	// 1=CATCH_FILTER_ENSURE
+        range[j].ensure = i;
+        break;
+      }
+    }
+  }
+
+  irep->crlen = n;
+}
+
 
 //================================================================
 /*! Parse header section.
@@ -194,16 +578,43 @@ static mrbc_irep * load_irep_1(mrbc_vm *vm, const uint8_t *bin, int *len)
   if( siz > 0xffff ) goto ERROR_TOO_LARGE;
   irep.ofs_ireps = siz;
 
-#if defined(MRBC_DEBUG)
+#if defined(MRBC_DEBUG) || MRBC_USE_PREDECODE
   irep.plen = plen;
+#endif
+#if defined(MRBC_DEBUG)
   irep.slen = slen;
 #endif
 
   // allocate new irep
-  siz = sizeof(mrbc_irep) + siz + sizeof(mrbc_irep*) * irep.rlen;
+  //  catch handlers and ranges (at most 2 per handler) are after tbl_ireps.
+  siz = sizeof(mrbc_irep) + siz + sizeof(mrbc_irep*) * irep.rlen +
+    (sizeof(mrbc_irep_catch_handler) + sizeof(mrbc_irep_catch_range) * 2) * irep.clen;
+#if MRBC_USE_PREDECODE
+  // numeric literals and pre-decoded instructions are placed after the irep.
+  int n_inst = map_instructions( irep.inst, irep.ilen, NULL );
+  if( n_inst < 0 ) goto ERROR_ILLEGAL;
+  uint32_t siz_decoded = (-siz & 7) + sizeof(mrbc_value) * plen +
+    sizeof(mrbc_inst) * n_inst;
+  uint32_t ofs_inst = siz + (-siz & 7) + sizeof(mrbc_value) * plen;
+  siz += siz_decoded;
+
+#elif MRBC_USE_INST_FUSION || MRBC_USE_QUICKENING
+  uint32_t ofs_inst = siz;
+  siz += irep.ilen;
+#endif
   mrbc_irep *p_irep = mrbc_raw_alloc( siz );
   *p_irep = irep;
 
+#if !MRBC_USE_PREDECODE && (MRBC_USE_INST_FUSION || MRBC_USE_QUICKENING)
+  // copy the instructions after the irep, to be rewritten by the optimization.
+  uint8_t *inst = (uint8_t *)p_irep + ofs_inst;
+  memcpy( inst, irep.inst, irep.ilen );
+#if MRBC_USE_INST_FUSION
+  fuse_instructions( inst, irep.ilen );
+#endif
+  p_irep->inst = inst;
+#endif
+
   // make a symbol ID table. (tbl_syms[slen])
   mrbc_sym *tbl_syms = mrbc_irep_tbl_syms(p_irep);
   for( int i = 0; i < slen; i++ ) {
@@ -220,6 +631,7 @@ static mrbc_irep * load_irep_1(mrbc_vm *vm, const uint8_t *bin, int *len)
     mrbc_sym sym = mrbc_str_to_symid( sym_str );
     if( sym < 0 ) {
       mrbc_raise(vm, MRBC_CLASS(Exception), "Overflow MAX_SYMBOLS_COUNT");
+      mrbc_raw_free( p_irep );
       return NULL;
     }
 
@@ -234,6 +646,7 @@ static mrbc_irep * load_irep_1(mrbc_vm *vm, const uint8_t *bin, int *len)
     int siz = 0;
     if( (p - irep.pool) > UINT16_MAX ) {
       mrbc_raise(vm, MRBC_CLASS(Exception), "Overflow IREP data offset table");
+      mrbc_raw_free( p_irep );
       return NULL;
     }
     *ofs_pools++ = (uint16_t)(p - irep.pool);
@@ -248,10 +661,45 @@ static mrbc_irep * load_irep_1(mrbc_vm *vm, const uint8_t *bin, int *len)
     p += siz;
   }
 
+#if MRBC_USE_PREDECODE
+  // translate the instructions.
+  mrbc_inst *inst = (mrbc_inst *)((uint8_t *)p_irep + ofs_inst);
+  uint16_t *map = mrbc_raw_alloc( sizeof(uint16_t) * (irep.ilen + 1) );
+  if( !map ) {
+    mrbc_raw_free( p_irep );
+    mrbc_raise(vm, MRBC_CLASS(NoMemoryError), 0);
+    return NULL;
+  }
+  map_instructions( irep.inst, irep.ilen, map );
+  int ret = decode_instructions( p_irep, irep.inst, map, inst );
+  decode_catch_handlers( p_irep, irep.inst + irep.ilen, map );
+  mrbc_raw_free( map );
+  if( ret != 0 ) {
+    mrbc_raw_free( p_irep );
+    goto ERROR_ILLEGAL;
+  }
+
+  resolve_pool_values( vm, p_irep, (mrbc_value *)inst - plen );
+#if MRBC_USE_INST_FUSION
+  fuse_instructions( inst, n_inst );
+#endif
+  p_irep->inst = (const uint8_t *)inst;
+  p_irep->ilen = sizeof(mrbc_inst) * n_inst;
+  vm->predecode_size += siz_decoded;
+#else
+  decode_catch_handlers( p_irep, irep.inst + irep.ilen, NULL );
+#endif
+
   // return length
   *len = bin_to_uint32(bin);
   return p_irep;
 
+#if MRBC_USE_PREDECODE
+ ERROR_ILLEGAL:
+  mrbc_raise(vm, MRBC_CLASS(Exception), "Illegal bytecode");
+  return NULL;
+#endif
+
 
  ERROR_TOO_LARGE:
   mrbc_raise(vm, MRBC_CLASS(Exception), "Too large IREP size");
@@ -295,6 +743,10 @@ static mrbc_irep *load_irep(mrbc_vm *vm, const uint8_t *bin, int *len)
   @param  vm		Pointer to VM.
   @param  bytecode	Pointer to bytecode.
   @return int		zero if no error.
+  @note	  The bytecode must be kept while the VM is used. And with
+	  MRBC_USE_SHARED_STRING_LITERAL, it must be kept until the end of
+	  the program, because the strings made from the literals can
+	  escape from the VM, to global variables, constants and task queues.
 */
 int mrbc_load_mrb(mrbc_vm *vm, const void *bytecode)
 {
@@ -332,6 +784,9 @@ int mrbc_load_irep(mrbc_vm *vm, const void *bytecode)
 {
   const uint8_t *bin = bytecode;
 
+#if MRBC_USE_PREDECODE
+  vm->predecode_size = 0;
+#endif
   vm->top_irep = load_irep( vm, bin + SIZE_RITE_SECTION_HEADER, 0 );
   if( vm->top_irep == NULL ) return -1;
 
@@ -393,7 +848,13 @@ static mrbc_int_t conv_bigint( const uint8_t *p )
 */
 mrbc_value mrbc_irep_pool_value(mrbc_vm *vm, int n)
 {
-  const uint8_t *p = mrbc_irep_pool_ptr(vm->cur_irep, n);
+  return pool_value( vm, mrbc_irep_pool_ptr(vm->cur_irep, n) );
+}
+
+
+//----------------------------------------------------------------
+static mrbc_value pool_value(mrbc_vm *vm, const uint8_t *p)
+{
   mrbc_value obj;
 
   int tt = *p++;
@@ -402,7 +863,11 @@ mrbc_value mrbc_irep_pool_value(mrbc_vm *vm, int n)
   case IREP_TT_STR:
   case IREP_TT_SSTR: {
     int len = bin_to_uint16(p);
+#if MRBC_USE_SHARED_STRING_LITERAL
+    obj = mrbc_string_new_literal( vm, p+2, len );
+#else
     obj = mrbc_string_new( vm, p+2, len );
+#endif
     break;
   }
 #endif
@@ -3,313 +3,161 @@
 extern
 #endif
 const uint8_t mrblib_bytecode[] = {
-0x52,0x49,0x54,0x45,0x30,0x34,0x30,0x30,0x00,0x00,0x13,0x43,0x48,0x53,0x4d,0x4b,
-0x30,0x30,0x30,0x30,0x49,0x52,0x45,0x50,0x00,0x00,0x13,0x27,0x30,0x34,0x30,0x30,
-0x00,0x00,0x01,0x1d,0x00,0x01,0x00,0x03,0x00,0x08,0x00,0x00,0x00,0x00,0x00,0x69,
+0x52,0x49,0x54,0x45,0x30,0x34,0x30,0x30,0x00,0x00,0x09,0xc1,0x48,0x53,0x4d,0x4b,
+0x30,0x30,0x30,0x30,0x49,0x52,0x45,0x50,0x00,0x00,0x09,0xa5,0x30,0x34,0x30,0x30,
+0x00,0x00,0x00,0xf7,0x00,0x01,0x00,0x03,0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x55,
 0x11,0x01,0x68,0x01,0x00,0x69,0x01,0x00,0x11,0x01,0x11,0x02,0x67,0x01,0x01,0x69,
 0x01,0x01,0x5c,0x01,0x00,0x1e,0x01,0x02,0x5c,0x01,0x01,0x1e,0x01,0x03,0x5c,0x01,
 0x01,0x1e,0x01,0x04,0x5c,0x01,0x02,0x1e,0x01,0x05,0x11,0x01,0x11,0x02,0x67,0x01,
 0x06,0x69,0x01,0x02,0x11,0x01,0x11,0x02,0x67,0x01,0x07,0x69,0x01,0x03,0x11,0x01,
 0x11,0x02,0x67,0x01,0x08,0x69,0x01,0x04,0x11,0x01,0x11,0x02,0x67,0x01,0x09,0x69,
-0x01,0x05,0x11,0x01,0x11,0x02,0x67,0x01,0x0a,0x69,0x01,0x06,0x11,0x01,0x11,0x02,
-0x67,0x01,0x0b,0x69,0x01,0x07,0x3d,0x01,0x76,0x00,0x03,0x00,0x00,0x03,0x34,0x2e,
-0x30,0x00,0x00,0x00,0x05,0x34,0x2e,0x30,0x2e,0x30,0x00,0x00,0x00,0x07,0x6d,0x72,
-0x75,0x62,0x79,0x2f,0x63,0x00,0x00,0x0c,0x00,0x0a,0x45,0x6e,0x75,0x6d,0x65,0x72,
-0x61,0x62,0x6c,0x65,0x00,0x00,0x05,0x41,0x72,0x72,0x61,0x79,0x00,0x00,0x0c,0x52,
-0x55,0x42,0x59,0x5f,0x56,0x45,0x52,0x53,0x49,0x4f,0x4e,0x00,0x00,0x0d,0x4d,0x52,
-0x55,0x42,0x59,0x5f,0x56,0x45,0x52,0x53,0x49,0x4f,0x4e,0x00,0x00,0x0e,0x4d,0x52,
-0x55,0x42,0x59,0x43,0x5f,0x56,0x45,0x52,0x53,0x49,0x4f,0x4e,0x00,0x00,0x0b,0x52,
-0x55,0x42,0x59,0x5f,0x45,0x4e,0x47,0x49,0x4e,0x45,0x00,0x00,0x04,0x48,0x61,0x73,
-0x68,0x00,0x00,0x07,0x49,0x6e,0x74,0x65,0x67,0x65,0x72,0x00,0x00,0x06,0x4f,0x62,
-0x6a,0x65,0x63,0x74,0x00,0x00,0x05,0x52,0x61,0x6e,0x67,0x65,0x00,0x00,0x06,0x53,
-0x74,0x72,0x69,0x6e,0x67,0x00,0x00,0x04,0x54,0x61,0x73,0x6b,0x00,0x00,0x00,0x00,
-0x43,0x00,0x01,0x00,0x02,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x0d,0x6b,0x01,0x00,
-0x00,0x6d,0x01,0x00,0x6b,0x01,0x02,0x01,0x3d,0x01,0x00,0x00,0x00,0x03,0x00,0x07,
-0x63,0x6f,0x6c,0x6c,0x65,0x63,0x74,0x00,0x00,0x03,0x6d,0x61,0x70,0x00,0x00,0x0f,
-0x65,0x61,0x63,0x68,0x5f,0x77,0x69,0x74,0x68,0x5f,0x69,0x6e,0x64,0x65,0x78,0x00,
-0x00,0x00,0x00,0x2b,0x00,0x03,0x00,0x05,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x10,
-0x39,0x00,0x00,0x00,0x52,0x02,0x00,0x62,0x04,0x00,0x31,0x03,0x00,0x00,0x3d,0x02,
-0x00,0x00,0x00,0x01,0x00,0x04,0x65,0x61,0x63,0x68,0x00,0x00,0x00,0x00,0x31,0x00,
-0x03,0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x39,0x04,0x00,0x00,0x21,
-0x03,0x02,0x00,0x01,0x05,0x01,0x44,0x04,0x00,0x01,0x36,0x04,0x01,0x32,0x03,0x00,
-0x01,0x3d,0x03,0x00,0x00,0x00,0x01,0x00,0x02,0x3c,0x3c,0x00,0x00,0x00,0x00,0x29,
-0x00,0x03,0x00,0x05,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x0e,0x39,0x00,0x00,0x00,
-0x06,0x02,0x62,0x04,0x00,0x31,0x03,0x00,0x00,0x3f,0x00,0x00,0x00,0x01,0x00,0x04,
-0x65,0x61,0x63,0x68,0x00,0x00,0x00,0x00,0x33,0x00,0x03,0x00,0x07,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x1f,0x39,0x04,0x00,0x00,0x01,0x04,0x01,0x21,0x05,0x02,0x00,
-0x44,0x03,0x00,0x01,0x36,0x03,0x02,0x21,0x03,0x02,0x00,0x46,0x03,0x01,0x22,0x03,
-0x02,0x00,0x3d,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x30,0x00,0x01,0x00,0x04,
-0x00,0x0f,0x00,0x00,0x00,0x00,0x00,0x51,0x1d,0x02,0x00,0x2f,0x01,0x01,0x01,0x6b,
-0x01,0x02,0x00,0x6b,0x01,0x03,0x01,0x6b,0x01,0x04,0x02,0x6d,0x05,0x04,0x6b,0x01,
-0x06,0x03,0x6b,0x01,0x07,0x04,0x6b,0x01,0x08,0x05,0x6b,0x01,0x09,0x06,0x6d,0x0a,
-0x09,0x6b,0x01,0x0b,0x07,0x6b,0x01,0x0c,0x08,0x6b,0x01,0x0d,0x09,0x6b,0x01,0x0e,
-0x0a,0x6b,0x01,0x0f,0x0b,0x6d,0x10,0x0f,0x6b,0x01,0x11,0x0c,0x6d,0x12,0x11,0x6b,
-0x01,0x13,0x0d,0x6b,0x01,0x14,0x0e,0x3d,0x01,0x00,0x00,0x00,0x15,0x00,0x0a,0x45,
-0x6e,0x75,0x6d,0x65,0x72,0x61,0x62,0x6c,0x65,0x00,0x00,0x07,0x69,0x6e,0x63,0x6c,
-0x75,0x64,0x65,0x00,0x00,0x04,0x61,0x6c,0x6c,0x3f,0x00,0x00,0x04,0x61,0x6e,0x79,
-0x3f,0x00,0x00,0x08,0x63,0x6f,0x6c,0x6c,0x65,0x63,0x74,0x21,0x00,0x00,0x04,0x6d,
-0x61,0x70,0x21,0x00,0x00,0x09,0x64,0x65,0x6c,0x65,0x74,0x65,0x5f,0x69,0x66,0x00,
-0x00,0x04,0x65,0x61,0x63,0x68,0x00,0x00,0x0a,0x65,0x61,0x63,0x68,0x5f,0x69,0x6e,
-0x64,0x65,0x78,0x00,0x00,0x05,0x69,0x6e,0x64,0x65,0x78,0x00,0x00,0x0a,0x66,0x69,
-0x6e,0x64,0x5f,0x69,0x6e,0x64,0x65,0x78,0x00,0x00,0x05,0x6e,0x6f,0x6e,0x65,0x3f,
-0x00,0x00,0x07,0x72,0x65,0x6a,0x65,0x63,0x74,0x21,0x00,0x00,0x06,0x72,0x65,0x6a,
-0x65,0x63,0x74,0x00,0x00,0x0c,0x72,0x65,0x76,0x65,0x72,0x73,0x65,0x5f,0x65,0x61,
-0x63,0x68,0x00,0x00,0x06,0x73,0x65,0x6c,0x65,0x63,0x74,0x00,0x00,0x06,0x66,0x69,
-0x6c,0x74,0x65,0x72,0x00,0x00,0x07,0x73,0x65,0x6c,0x65,0x63,0x74,0x21,0x00,0x00,
-0x07,0x66,0x69,0x6c,0x74,0x65,0x72,0x21,0x00,0x00,0x05,0x73,0x6f,0x72,0x74,0x21,
-0x00,0x00,0x04,0x73,0x6f,0x72,0x74,0x00,0x00,0x00,0x00,0xd9,0x00,0x05,0x00,0x09,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xa4,0x39,0x00,0x10,0x01,0x01,0x03,0x02,0x06,
-0x04,0x01,0x05,0x03,0x28,0x05,0x00,0x30,0x01,0x05,0x04,0x30,0x06,0x00,0x4e,0x05,
-0x28,0x05,0x00,0x21,0x00,0x01,0x07,0x04,0x2f,0x06,0x01,0x01,0x44,0x05,0x04,0x00,
-0x36,0x05,0x01,0x33,0x05,0x02,0x28,0x05,0x00,0x04,0x14,0x05,0x3e,0x05,0x49,0x04,
-0x05,0x01,0x26,0xff,0xd3,0x26,0x00,0x63,0x01,0x05,0x01,0x33,0x05,0x03,0x33,0x05,
-0x02,0x28,0x05,0x00,0x30,0x01,0x05,0x04,0x30,0x06,0x00,0x4e,0x05,0x28,0x05,0x00,
-0x21,0x00,0x24,0x05,0x01,0x01,0x07,0x04,0x2f,0x06,0x01,0x01,0x32,0x05,0x04,0x01,
-0x33,0x05,0x02,0x28,0x05,0x00,0x04,0x14,0x05,0x3e,0x05,0x49,0x04,0x05,0x01,0x26,
-0xff,0xd3,0x26,0x00,0x26,0x01,0x05,0x04,0x30,0x06,0x00,0x4e,0x05,0x28,0x05,0x00,
-0x1a,0x00,0x01,0x06,0x04,0x2f,0x05,0x01,0x01,0x33,0x05,0x02,0x28,0x05,0x00,0x04,
-0x14,0x05,0x3e,0x05,0x49,0x04,0x05,0x01,0x26,0xff,0xda,0x41,0x00,0x00,0x00,0x05,
-0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x01,
-0x21,0x00,0x00,0x06,0x65,0x6d,0x70,0x74,0x79,0x3f,0x00,0x00,0x03,0x3d,0x3d,0x3d,
-0x00,0x00,0x00,0x00,0xd0,0x00,0x05,0x00,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x9b,0x39,0x00,0x10,0x01,0x01,0x03,0x02,0x06,0x04,0x01,0x05,0x03,0x28,0x05,0x00,
-0x2d,0x01,0x05,0x04,0x30,0x06,0x00,0x4e,0x05,0x28,0x05,0x00,0x1e,0x00,0x01,0x07,
-0x04,0x2f,0x06,0x01,0x01,0x44,0x05,0x04,0x00,0x36,0x05,0x01,0x28,0x05,0x00,0x04,
-0x13,0x05,0x3e,0x05,0x49,0x04,0x05,0x01,0x26,0xff,0xd6,0x26,0x00,0x5d,0x01,0x05,
-0x01,0x33,0x05,0x02,0x33,0x05,0x03,0x28,0x05,0x00,0x2d,0x01,0x05,0x04,0x30,0x06,
-0x00,0x4e,0x05,0x28,0x05,0x00,0x1e,0x00,0x24,0x05,0x01,0x01,0x07,0x04,0x2f,0x06,
-0x01,0x01,0x32,0x05,0x04,0x01,0x28,0x05,0x00,0x04,0x13,0x05,0x3e,0x05,0x49,0x04,
-0x05,0x01,0x26,0xff,0xd6,0x26,0x00,0x23,0x01,0x05,0x04,0x30,0x06,0x00,0x4e,0x05,
-0x28,0x05,0x00,0x17,0x00,0x01,0x06,0x04,0x2f,0x05,0x01,0x01,0x28,0x05,0x00,0x04,
-0x13,0x05,0x3e,0x05,0x49,0x04,0x05,0x01,0x26,0xff,0xdd,0x42,0x00,0x00,0x00,0x05,
-0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x06,
-0x65,0x6d,0x70,0x74,0x79,0x3f,0x00,0x00,0x01,0x21,0x00,0x00,0x03,0x3d,0x3d,0x3d,
-0x00,0x00,0x00,0x00,0x58,0x00,0x03,0x00,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x30,0x39,0x00,0x00,0x00,0x06,0x02,0x01,0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,
-0x03,0x00,0x1d,0x00,0x01,0x04,0x02,0x01,0x07,0x02,0x2f,0x06,0x01,0x01,0x44,0x05,
-0x00,0x00,0x36,0x05,0x01,0x2f,0x03,0x02,0x02,0x49,0x02,0x03,0x01,0x26,0xff,0xd7,
-0x3f,0x00,0x00,0x00,0x03,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,
-0x5b,0x5d,0x00,0x00,0x03,0x5b,0x5d,0x3d,0x00,0x00,0x00,0x00,0x65,0x00,0x03,0x00,
-0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x37,0x39,0x00,0x00,0x00,0x06,0x02,0x01,
-0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,0x03,0x00,0x24,0x00,0x01,0x05,0x02,0x2f,
-0x04,0x01,0x01,0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x28,0x03,0x00,0x0a,0x01,0x04,
-0x02,0x2f,0x03,0x02,0x01,0x26,0x00,0x04,0x49,0x02,0x03,0x01,0x26,0xff,0xd0,0x3f,
-0x00,0x00,0x00,0x03,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,0x5b,
-0x5d,0x00,0x00,0x09,0x64,0x65,0x6c,0x65,0x74,0x65,0x5f,0x61,0x74,0x00,0x00,0x00,
-0x00,0x4b,0x00,0x03,0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x29,0x39,0x00,
-0x00,0x00,0x06,0x02,0x01,0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,0x03,0x00,0x16,
-0x00,0x01,0x05,0x02,0x2f,0x04,0x01,0x01,0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x49,
-0x02,0x03,0x01,0x26,0xff,0xde,0x3f,0x00,0x00,0x00,0x02,0x00,0x06,0x6c,0x65,0x6e,
-0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x00,0x00,0x42,0x00,0x03,0x00,
-0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x25,0x39,0x00,0x00,0x00,0x06,0x02,0x01,
-0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,0x03,0x00,0x12,0x00,0x01,0x04,0x02,0x44,
-0x03,0x00,0x00,0x36,0x03,0x01,0x49,0x02,0x03,0x01,0x26,0xff,0xe2,0x3f,0x00,0x00,
-0x00,0x01,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x00,0x00,0xbd,0x00,
-0x05,0x00,0x09,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x76,0x39,0x00,0x10,0x01,0x01,
-0x03,0x02,0x06,0x04,0x01,0x05,0x03,0x28,0x05,0x00,0x29,0x01,0x05,0x04,0x30,0x06,
-0x00,0x4e,0x05,0x28,0x05,0x00,0x1c,0x00,0x01,0x07,0x04,0x2f,0x06,0x01,0x01,0x44,
-0x05,0x04,0x00,0x36,0x05,0x01,0x28,0x05,0x00,0x02,0x3e,0x04,0x49,0x04,0x05,0x01,
-0x26,0xff,0xd8,0x40,0x01,0x05,0x01,0x33,0x05,0x02,0x33,0x05,0x03,0x28,0x05,0x00,
-0x27,0x01,0x05,0x04,0x30,0x06,0x00,0x4e,0x05,0x28,0x05,0x00,0x1a,0x00,0x01,0x06,
-0x04,0x2f,0x05,0x01,0x01,0x24,0x06,0x01,0x4d,0x05,0x28,0x05,0x00,0x02,0x3e,0x04,
-0x49,0x04,0x05,0x01,0x26,0xff,0xda,0x40,0x1d,0x06,0x04,0x2f,0x05,0x05,0x01,0x3d,
-0x05,0x00,0x00,0x00,0x06,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,
-0x5b,0x5d,0x00,0x00,0x06,0x65,0x6d,0x70,0x74,0x79,0x3f,0x00,0x00,0x01,0x21,0x00,
-0x00,0x0d,0x41,0x72,0x67,0x75,0x6d,0x65,0x6e,0x74,0x45,0x72,0x72,0x6f,0x72,0x00,
-0x00,0x05,0x72,0x61,0x69,0x73,0x65,0x00,0x00,0x00,0x00,0x41,0x00,0x05,0x00,0x09,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x39,0x00,0x10,0x03,0x01,0x04,0x03,0x11,
-0x06,0x01,0x07,0x01,0x54,0x06,0x5e,0x07,0x00,0x01,0x08,0x02,0x60,0x07,0x01,0x08,
-0x04,0x31,0x05,0x00,0xff,0x33,0x05,0x01,0x3d,0x05,0x00,0x00,0x00,0x02,0x00,0x04,
-0x61,0x6e,0x79,0x3f,0x00,0x00,0x01,0x21,0x00,0x00,0x00,0x00,0x52,0x00,0x04,0x00,
-0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x29,0x39,0x00,0x00,0x01,0x01,0x02,0x01,
-0x30,0x04,0x00,0x01,0x03,0x04,0x01,0x05,0x02,0x31,0x04,0x01,0x00,0x01,0x04,0x03,
-0x30,0x05,0x00,0x4d,0x04,0x28,0x04,0x00,0x05,0x11,0x04,0x26,0x00,0x02,0x12,0x04,
-0x3d,0x04,0x00,0x00,0x00,0x02,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,
-0x09,0x64,0x65,0x6c,0x65,0x74,0x65,0x5f,0x69,0x66,0x00,0x00,0x00,0x00,0x39,0x00,
-0x03,0x00,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x13,0x39,0x00,0x00,0x01,0x01,
-0x02,0x01,0x30,0x03,0x00,0x01,0x04,0x02,0x34,0x03,0x01,0x00,0x3d,0x03,0x00,0x00,
-0x00,0x02,0x00,0x03,0x64,0x75,0x70,0x00,0x00,0x09,0x64,0x65,0x6c,0x65,0x74,0x65,
-0x5f,0x69,0x66,0x00,0x00,0x00,0x00,0x51,0x00,0x03,0x00,0x07,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x2f,0x39,0x00,0x00,0x00,0x30,0x03,0x00,0x48,0x03,0x01,0x01,0x02,
-0x03,0x01,0x03,0x02,0x06,0x04,0x51,0x03,0x28,0x03,0x00,0x16,0x00,0x01,0x05,0x02,
-0x2f,0x04,0x01,0x01,0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x4a,0x02,0x03,0x01,0x26,
-0xff,0xdf,0x3f,0x00,0x00,0x00,0x02,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,
-0x00,0x02,0x5b,0x5d,0x00,0x00,0x00,0x00,0x6c,0x00,0x05,0x00,0x09,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x45,0x39,0x00,0x00,0x00,0x52,0x02,0x00,0x30,0x05,0x00,0x01,
-0x03,0x05,0x06,0x04,0x01,0x05,0x04,0x01,0x06,0x03,0x4e,0x05,0x28,0x05,0x00,0x28,
-0x00,0x01,0x07,0x04,0x2f,0x06,0x01,0x01,0x44,0x05,0x00,0x00,0x36,0x05,0x01,0x28,
-0x05,0x00,0x0e,0x01,0x05,0x02,0x01,0x07,0x04,0x2f,0x06,0x01,0x01,0x32,0x05,0x02,
-0x01,0x49,0x04,0x05,0x01,0x26,0xff,0xcc,0x3d,0x02,0x00,0x00,0x00,0x03,0x00,0x06,
-0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x02,0x3c,0x3c,
-0x00,0x00,0x00,0x00,0x7f,0x00,0x04,0x00,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x51,0x39,0x00,0x00,0x00,0x30,0x04,0x00,0x01,0x02,0x04,0x06,0x03,0x01,0x04,0x03,
-0x30,0x05,0x00,0x4e,0x04,0x28,0x04,0x00,0x24,0x00,0x01,0x06,0x03,0x2f,0x05,0x01,
-0x01,0x44,0x04,0x00,0x00,0x36,0x04,0x01,0x28,0x04,0x00,0x07,0x49,0x03,0x04,0x01,
-0x26,0x00,0x07,0x01,0x05,0x03,0x2f,0x04,0x02,0x01,0x26,0xff,0xd0,0x30,0x04,0x00,
-0x01,0x05,0x02,0x4d,0x04,0x28,0x04,0x00,0x05,0x11,0x04,0x26,0x00,0x02,0x12,0x04,
-0x3d,0x04,0x00,0x00,0x00,0x03,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,
-0x02,0x5b,0x5d,0x00,0x00,0x09,0x64,0x65,0x6c,0x65,0x74,0x65,0x5f,0x61,0x74,0x00,
-0x00,0x00,0x00,0xc6,0x00,0x08,0x00,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x97,
-0x39,0x00,0x00,0x01,0x01,0x02,0x01,0x30,0x08,0x00,0x48,0x08,0x01,0x01,0x03,0x08,
-0x06,0x04,0x01,0x08,0x04,0x01,0x09,0x03,0x4e,0x08,0x28,0x08,0x00,0x78,0x00,0x01,
-0x05,0x04,0x01,0x08,0x05,0x01,0x09,0x03,0x4e,0x08,0x28,0x08,0x00,0x61,0x00,0x49,
-0x05,0x08,0x01,0x01,0x09,0x04,0x2f,0x08,0x01,0x01,0x01,0x06,0x08,0x01,0x09,0x05,
-0x2f,0x08,0x01,0x01,0x01,0x07,0x08,0x01,0x08,0x02,0x28,0x08,0x00,0x1b,0x01,0x08,
-0x02,0x01,0x09,0x06,0x01,0x0a,0x07,0x32,0x08,0x02,0x02,0x06,0x09,0x4f,0x08,0x28,
-0x08,0x00,0x03,0x2a,0xff,0xbc,0x26,0x00,0x0f,0x01,0x08,0x06,0x01,0x09,0x07,0x4f,
-0x08,0x28,0x08,0x00,0x03,0x2a,0xff,0xaa,0x01,0x09,0x04,0x01,0x0a,0x07,0x2f,0x08,
-0x03,0x02,0x01,0x09,0x05,0x01,0x0a,0x06,0x2f,0x08,0x03,0x02,0x26,0xff,0x93,0x49,
-0x04,0x08,0x01,0x26,0xff,0x7c,0x3f,0x00,0x00,0x00,0x04,0x00,0x06,0x6c,0x65,0x6e,
-0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x04,0x63,0x61,0x6c,0x6c,0x00,
-0x00,0x03,0x5b,0x5d,0x3d,0x00,0x00,0x00,0x00,0x35,0x00,0x03,0x00,0x05,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x13,0x39,0x00,0x00,0x01,0x01,0x02,0x01,0x30,0x03,0x00,
-0x01,0x04,0x02,0x34,0x03,0x01,0x00,0x3d,0x03,0x00,0x00,0x00,0x02,0x00,0x03,0x64,
-0x75,0x70,0x00,0x00,0x05,0x73,0x6f,0x72,0x74,0x21,0x00,0x00,0x00,0x00,0x3f,0x00,
-0x01,0x00,0x04,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x0d,0x1d,0x02,0x00,0x2f,0x01,
-0x01,0x01,0x6b,0x01,0x02,0x00,0x3d,0x01,0x00,0x00,0x00,0x03,0x00,0x0a,0x45,0x6e,
-0x75,0x6d,0x65,0x72,0x61,0x62,0x6c,0x65,0x00,0x00,0x07,0x69,0x6e,0x63,0x6c,0x75,
-0x64,0x65,0x00,0x00,0x04,0x65,0x61,0x63,0x68,0x00,0x00,0x00,0x00,0x79,0x00,0x07,
-0x00,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x49,0x39,0x00,0x00,0x01,0x01,0x02,
-0x01,0x30,0x07,0x00,0x01,0x03,0x07,0x30,0x07,0x01,0x01,0x04,0x07,0x06,0x05,0x01,
-0x07,0x05,0x01,0x08,0x04,0x4e,0x07,0x28,0x07,0x00,0x27,0x00,0x01,0x07,0x03,0x01,
-0x08,0x05,0x23,0x07,0x01,0x06,0x07,0x01,0x07,0x02,0x01,0x08,0x06,0x01,0x0a,0x06,
-0x2f,0x09,0x02,0x01,0x52,0x08,0x02,0x32,0x07,0x03,0x01,0x49,0x05,0x07,0x01,0x26,
-0xff,0xcd,0x3f,0x00,0x00,0x00,0x04,0x00,0x04,0x6b,0x65,0x79,0x73,0x00,0x00,0x06,
-0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x04,0x63,0x61,
-0x6c,0x6c,0x00,0x00,0x00,0x00,0x3a,0x00,0x01,0x00,0x02,0x00,0x03,0x00,0x00,0x00,
-0x00,0x00,0x0e,0x6b,0x01,0x00,0x00,0x6b,0x01,0x01,0x01,0x6b,0x01,0x02,0x02,0x3d,
-0x01,0x00,0x00,0x00,0x03,0x00,0x05,0x74,0x69,0x6d,0x65,0x73,0x00,0x00,0x04,0x75,
-0x70,0x74,0x6f,0x00,0x00,0x06,0x64,0x6f,0x77,0x6e,0x74,0x6f,0x00,0x00,0x00,0x00,
-0x38,0x00,0x03,0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x24,0x39,0x00,0x00,
-0x00,0x06,0x02,0x01,0x03,0x02,0x12,0x04,0x4e,0x03,0x28,0x03,0x00,0x12,0x00,0x01,
-0x04,0x02,0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x49,0x02,0x03,0x01,0x26,0xff,0xe3,
-0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x43,0x00,0x05,0x00,0x08,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x28,0x39,0x04,0x00,0x01,0x01,0x03,0x02,0x12,0x04,0x01,0x05,
-0x04,0x01,0x06,0x01,0x4f,0x05,0x28,0x05,0x00,0x12,0x00,0x01,0x05,0x03,0x01,0x06,
-0x04,0x32,0x05,0x00,0x01,0x49,0x04,0x05,0x01,0x26,0xff,0xe2,0x3f,0x00,0x00,0x00,
-0x01,0x00,0x04,0x63,0x61,0x6c,0x6c,0x00,0x00,0x00,0x00,0x43,0x00,0x05,0x00,0x08,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x28,0x39,0x04,0x00,0x01,0x01,0x03,0x02,0x12,
-0x04,0x01,0x05,0x01,0x01,0x06,0x04,0x4f,0x05,0x28,0x05,0x00,0x12,0x00,0x01,0x05,
-0x03,0x01,0x06,0x04,0x32,0x05,0x00,0x01,0x4a,0x04,0x05,0x01,0x26,0xff,0xe2,0x3f,
-0x00,0x00,0x00,0x01,0x00,0x04,0x63,0x61,0x6c,0x6c,0x00,0x00,0x00,0x00,0x21,0x00,
-0x01,0x00,0x02,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x06,0x6b,0x01,0x00,0x00,0x3d,
-0x01,0x00,0x00,0x00,0x01,0x00,0x04,0x6c,0x6f,0x6f,0x70,0x00,0x00,0x00,0x00,0x24,
-0x00,0x02,0x00,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x39,0x00,0x00,0x00,
-0x00,0x44,0x02,0x00,0x00,0x36,0x02,0x00,0x26,0xff,0xf5,0x40,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x21,0x00,0x01,0x00,0x02,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x06,
-0x6b,0x01,0x00,0x00,0x3d,0x01,0x00,0x00,0x00,0x01,0x00,0x04,0x65,0x61,0x63,0x68,
-0x00,0x00,0x00,0x00,0x6c,0x00,0x04,0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x3a,0x39,0x00,0x00,0x00,0x30,0x04,0x00,0x01,0x02,0x04,0x30,0x04,0x01,0x27,0x04,
-0x00,0x04,0x49,0x02,0x04,0x01,0x30,0x04,0x02,0x01,0x03,0x04,0x01,0x04,0x03,0x01,
-0x05,0x02,0x4e,0x04,0x28,0x04,0x00,0x12,0x00,0x01,0x05,0x03,0x44,0x04,0x00,0x00,
-0x36,0x04,0x01,0x49,0x03,0x04,0x01,0x26,0xff,0xe2,0x3f,0x00,0x00,0x00,0x03,0x00,
-0x04,0x6c,0x61,0x73,0x74,0x00,0x00,0x0c,0x65,0x78,0x63,0x6c,0x75,0x64,0x65,0x5f,
-0x65,0x6e,0x64,0x3f,0x00,0x00,0x05,0x66,0x69,0x72,0x73,0x74,0x00,0x00,0x00,0x00,
-0x7b,0x00,0x01,0x00,0x02,0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x1a,0x6b,0x01,0x00,
-0x00,0x6b,0x01,0x01,0x01,0x6b,0x01,0x02,0x02,0x6b,0x01,0x03,0x03,0x6b,0x01,0x04,
-0x04,0x6b,0x01,0x05,0x05,0x3d,0x01,0x00,0x00,0x00,0x06,0x00,0x09,0x65,0x61,0x63,
-0x68,0x5f,0x62,0x79,0x74,0x65,0x00,0x00,0x09,0x65,0x61,0x63,0x68,0x5f,0x63,0x68,
-0x61,0x72,0x00,0x00,0x05,0x6c,0x6a,0x75,0x73,0x74,0x00,0x00,0x05,0x72,0x6a,0x75,
-0x73,0x74,0x00,0x00,0x09,0x65,0x61,0x63,0x68,0x5f,0x6c,0x69,0x6e,0x65,0x00,0x00,
-0x16,0x5f,0x5f,0x6c,0x6a,0x75,0x73,0x74,0x5f,0x72,0x6a,0x75,0x73,0x74,0x5f,0x61,
-0x72,0x67,0x63,0x68,0x65,0x63,0x6b,0x00,0x00,0x00,0x00,0x52,0x00,0x03,0x00,0x07,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x29,0x39,0x00,0x00,0x00,0x06,0x02,0x01,0x03,
-0x02,0x30,0x04,0x00,0x4e,0x03,0x28,0x03,0x00,0x16,0x00,0x01,0x05,0x02,0x2f,0x04,
-0x01,0x01,0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x49,0x02,0x03,0x01,0x26,0xff,0xde,
-0x3f,0x00,0x00,0x00,0x02,0x00,0x08,0x62,0x79,0x74,0x65,0x73,0x69,0x7a,0x65,0x00,
-0x00,0x07,0x67,0x65,0x74,0x62,0x79,0x74,0x65,0x00,0x00,0x00,0x00,0x4b,0x00,0x03,
-0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x29,0x39,0x00,0x00,0x00,0x06,0x02,
-0x01,0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,0x03,0x00,0x16,0x00,0x01,0x05,0x02,
-0x2f,0x04,0x01,0x01,0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x49,0x02,0x03,0x01,0x26,
-0xff,0xde,0x3f,0x00,0x00,0x00,0x02,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,
-0x00,0x02,0x5b,0x5d,0x00,0x00,0x00,0x00,0x87,0x00,0x05,0x00,0x09,0x00,0x01,0x00,
-0x00,0x00,0x00,0x00,0x3a,0x39,0x04,0x20,0x00,0x26,0x00,0x03,0x26,0x00,0x03,0x5c,
-0x02,0x00,0x01,0x06,0x01,0x01,0x07,0x02,0x2f,0x05,0x00,0x02,0x30,0x05,0x01,0x01,
-0x04,0x05,0x01,0x05,0x01,0x30,0x06,0x02,0x4f,0x05,0x28,0x05,0x00,0x02,0x3d,0x04,
-0x00,0x01,0x05,0x02,0x62,0x06,0x00,0x34,0x05,0x03,0x00,0x26,0xff,0xf2,0x40,0x00,
-0x01,0x00,0x00,0x01,0x20,0x00,0x00,0x04,0x00,0x16,0x5f,0x5f,0x6c,0x6a,0x75,0x73,
+0x01,0x05,0x3d,0x01,0x76,0x00,0x03,0x00,0x00,0x03,0x34,0x2e,0x30,0x00,0x00,0x00,
+0x05,0x34,0x2e,0x30,0x2e,0x30,0x00,0x00,0x00,0x07,0x6d,0x72,0x75,0x62,0x79,0x2f,
+0x63,0x00,0x00,0x0a,0x00,0x0a,0x45,0x6e,0x75,0x6d,0x65,0x72,0x61,0x62,0x6c,0x65,
+0x00,0x00,0x05,0x41,0x72,0x72,0x61,0x79,0x00,0x00,0x0c,0x52,0x55,0x42,0x59,0x5f,
+0x56,0x45,0x52,0x53,0x49,0x4f,0x4e,0x00,0x00,0x0d,0x4d,0x52,0x55,0x42,0x59,0x5f,
+0x56,0x45,0x52,0x53,0x49,0x4f,0x4e,0x00,0x00,0x0e,0x4d,0x52,0x55,0x42,0x59,0x43,
+0x5f,0x56,0x45,0x52,0x53,0x49,0x4f,0x4e,0x00,0x00,0x0b,0x52,0x55,0x42,0x59,0x5f,
+0x45,0x4e,0x47,0x49,0x4e,0x45,0x00,0x00,0x04,0x48,0x61,0x73,0x68,0x00,0x00,0x06,
+0x4f,0x62,0x6a,0x65,0x63,0x74,0x00,0x00,0x06,0x53,0x74,0x72,0x69,0x6e,0x67,0x00,
+0x00,0x04,0x54,0x61,0x73,0x6b,0x00,0x00,0x00,0x00,0x43,0x00,0x01,0x00,0x02,0x00,
+0x02,0x00,0x00,0x00,0x00,0x00,0x0d,0x6b,0x01,0x00,0x00,0x6d,0x01,0x00,0x6b,0x01,
+0x02,0x01,0x3d,0x01,0x00,0x00,0x00,0x03,0x00,0x07,0x63,0x6f,0x6c,0x6c,0x65,0x63,
+0x74,0x00,0x00,0x03,0x6d,0x61,0x70,0x00,0x00,0x0f,0x65,0x61,0x63,0x68,0x5f,0x77,
+0x69,0x74,0x68,0x5f,0x69,0x6e,0x64,0x65,0x78,0x00,0x00,0x00,0x00,0x2b,0x00,0x03,
+0x00,0x05,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x10,0x39,0x00,0x00,0x00,0x52,0x02,
+0x00,0x62,0x04,0x00,0x31,0x03,0x00,0x00,0x3d,0x02,0x00,0x00,0x00,0x01,0x00,0x04,
+0x65,0x61,0x63,0x68,0x00,0x00,0x00,0x00,0x31,0x00,0x03,0x00,0x07,0x00,0x00,0x00,
+0x00,0x00,0x00,0x00,0x18,0x39,0x04,0x00,0x00,0x21,0x03,0x02,0x00,0x01,0x05,0x01,
+0x44,0x04,0x00,0x01,0x36,0x04,0x01,0x32,0x03,0x00,0x01,0x3d,0x03,0x00,0x00,0x00,
+0x01,0x00,0x02,0x3c,0x3c,0x00,0x00,0x00,0x00,0x29,0x00,0x03,0x00,0x05,0x00,0x01,
+0x00,0x00,0x00,0x00,0x00,0x0e,0x39,0x00,0x00,0x00,0x06,0x02,0x62,0x04,0x00,0x31,
+0x03,0x00,0x00,0x3f,0x00,0x00,0x00,0x01,0x00,0x04,0x65,0x61,0x63,0x68,0x00,0x00,
+0x00,0x00,0x33,0x00,0x03,0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1f,0x39,
+0x04,0x00,0x00,0x01,0x04,0x01,0x21,0x05,0x02,0x00,0x44,0x03,0x00,0x01,0x36,0x03,
+0x02,0x21,0x03,0x02,0x00,0x46,0x03,0x01,0x22,0x03,0x02,0x00,0x3d,0x03,0x00,0x00,
+0x00,0x00,0x00,0x00,0x00,0x58,0x00,0x01,0x00,0x04,0x00,0x02,0x00,0x00,0x00,0x00,
+0x00,0x11,0x1d,0x02,0x00,0x2f,0x01,0x01,0x01,0x6b,0x01,0x02,0x00,0x6b,0x01,0x03,
+0x01,0x3d,0x01,0x00,0x00,0x00,0x04,0x00,0x0a,0x45,0x6e,0x75,0x6d,0x65,0x72,0x61,
+0x62,0x6c,0x65,0x00,0x00,0x07,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,0x00,0x00,0x0a,
+0x65,0x61,0x63,0x68,0x5f,0x69,0x6e,0x64,0x65,0x78,0x00,0x00,0x0c,0x72,0x65,0x76,
+0x65,0x72,0x73,0x65,0x5f,0x65,0x61,0x63,0x68,0x00,0x00,0x00,0x00,0x42,0x00,0x03,
+0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x25,0x39,0x00,0x00,0x00,0x06,0x02,
+0x01,0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,0x03,0x00,0x12,0x00,0x01,0x04,0x02,
+0x44,0x03,0x00,0x00,0x36,0x03,0x01,0x49,0x02,0x03,0x01,0x26,0xff,0xe2,0x3f,0x00,
+0x00,0x00,0x01,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x00,0x00,0x51,
+0x00,0x03,0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x2f,0x39,0x00,0x00,0x00,
+0x30,0x03,0x00,0x48,0x03,0x01,0x01,0x02,0x03,0x01,0x03,0x02,0x06,0x04,0x51,0x03,
+0x28,0x03,0x00,0x16,0x00,0x01,0x05,0x02,0x2f,0x04,0x01,0x01,0x44,0x03,0x00,0x00,
+0x36,0x03,0x01,0x4a,0x02,0x03,0x01,0x26,0xff,0xdf,0x3f,0x00,0x00,0x00,0x02,0x00,
+0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x00,0x00,
+0x34,0x00,0x01,0x00,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x09,0x1d,0x02,0x00,
+0x2f,0x01,0x01,0x01,0x3d,0x01,0x00,0x00,0x00,0x02,0x00,0x0a,0x45,0x6e,0x75,0x6d,
+0x65,0x72,0x61,0x62,0x6c,0x65,0x00,0x00,0x07,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,
+0x00,0x00,0x00,0x00,0x21,0x00,0x01,0x00,0x02,0x00,0x01,0x00,0x00,0x00,0x00,0x00,
+0x06,0x6b,0x01,0x00,0x00,0x3d,0x01,0x00,0x00,0x00,0x01,0x00,0x04,0x6c,0x6f,0x6f,
+0x70,0x00,0x00,0x00,0x00,0x24,0x00,0x02,0x00,0x04,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x10,0x39,0x00,0x00,0x00,0x00,0x44,0x02,0x00,0x00,0x36,0x02,0x00,0x26,0xff,
+0xf5,0x40,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6b,0x00,0x01,0x00,0x02,0x00,0x05,
+0x00,0x00,0x00,0x00,0x00,0x16,0x6b,0x01,0x00,0x00,0x6b,0x01,0x01,0x01,0x6b,0x01,
+0x02,0x02,0x6b,0x01,0x03,0x03,0x6b,0x01,0x04,0x04,0x3d,0x01,0x00,0x00,0x00,0x05,
+0x00,0x09,0x65,0x61,0x63,0x68,0x5f,0x62,0x79,0x74,0x65,0x00,0x00,0x05,0x6c,0x6a,
+0x75,0x73,0x74,0x00,0x00,0x05,0x72,0x6a,0x75,0x73,0x74,0x00,0x00,0x09,0x65,0x61,
+0x63,0x68,0x5f,0x6c,0x69,0x6e,0x65,0x00,0x00,0x16,0x5f,0x5f,0x6c,0x6a,0x75,0x73,
 0x74,0x5f,0x72,0x6a,0x75,0x73,0x74,0x5f,0x61,0x72,0x67,0x63,0x68,0x65,0x63,0x6b,
-0x00,0x00,0x03,0x64,0x75,0x70,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,
-0x00,0x09,0x65,0x61,0x63,0x68,0x5f,0x63,0x68,0x61,0x72,0x00,0x00,0x00,0x00,0x4f,
-0x00,0x03,0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x2d,0x39,0x04,0x00,0x00,
-0x21,0x03,0x04,0x00,0x01,0x04,0x01,0x32,0x03,0x00,0x01,0x21,0x03,0x04,0x00,0x33,
-0x03,0x01,0x21,0x04,0x01,0x00,0x4d,0x03,0x28,0x03,0x00,0x09,0x21,0x03,0x04,0x00,
-0x3e,0x03,0x26,0x00,0x02,0x11,0x03,0x3d,0x03,0x00,0x00,0x00,0x02,0x00,0x02,0x3c,
-0x3c,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x00,0x00,0xb7,0x00,
-0x06,0x00,0x0a,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x68,0x39,0x04,0x20,0x00,0x26,
-0x00,0x03,0x26,0x00,0x03,0x5c,0x02,0x00,0x01,0x07,0x01,0x01,0x08,0x02,0x2f,0x06,
-0x00,0x02,0x01,0x06,0x01,0x30,0x07,0x01,0x4f,0x06,0x28,0x06,0x00,0x05,0x30,0x06,
-0x02,0x3d,0x06,0x01,0x06,0x01,0x30,0x07,0x01,0x47,0x06,0x01,0x04,0x06,0x5c,0x05,
-0x01,0x00,0x01,0x06,0x05,0x01,0x07,0x02,0x32,0x06,0x03,0x01,0x01,0x06,0x04,0x01,
-0x07,0x05,0x33,0x07,0x01,0x4f,0x06,0x28,0x06,0x00,0x03,0x2a,0x00,0x03,0x26,0xff,
-0xe0,0x01,0x06,0x05,0x06,0x07,0x01,0x08,0x04,0x32,0x06,0x04,0x02,0x12,0x07,0x45,
-0x06,0x3d,0x06,0x00,0x02,0x00,0x00,0x01,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x05,
-0x00,0x16,0x5f,0x5f,0x6c,0x6a,0x75,0x73,0x74,0x5f,0x72,0x6a,0x75,0x73,0x74,0x5f,
-0x61,0x72,0x67,0x63,0x68,0x65,0x63,0x6b,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,
-0x68,0x00,0x00,0x03,0x64,0x75,0x70,0x00,0x00,0x02,0x3c,0x3c,0x00,0x00,0x02,0x5b,
-0x5d,0x00,0x00,0x00,0x00,0xea,0x00,0x08,0x00,0x0d,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0xb3,0x39,0x00,0x20,0x04,0x26,0x00,0x03,0x26,0x00,0x03,0x5c,0x01,0x00,0x3a,
-0x04,0x00,0x27,0x04,0x00,0x05,0x14,0x04,0x26,0x00,0x03,0x3c,0x04,0x00,0x3b,0x06,
-0x05,0x01,0x08,0x05,0x30,0x09,0x01,0x4e,0x08,0x28,0x08,0x00,0x87,0x00,0x01,0x09,
-0x01,0x01,0x0a,0x05,0x2f,0x08,0x02,0x02,0x01,0x06,0x08,0x01,0x08,0x06,0x28,0x08,
-0x00,0x40,0x01,0x09,0x05,0x01,0x0a,0x06,0x01,0x0b,0x05,0x47,0x0a,0x01,0x0b,0x01,
-0x33,0x0b,0x01,0x45,0x0a,0x2f,0x08,0x03,0x02,0x01,0x07,0x08,0x01,0x09,0x04,0x28,
-0x09,0x00,0x09,0x01,0x09,0x07,0x33,0x09,0x00,0x26,0x00,0x03,0x01,0x09,0x07,0x44,
-0x08,0x08,0x10,0x36,0x08,0x01,0x01,0x08,0x06,0x46,0x08,0x01,0x01,0x05,0x08,0x26,
-0x00,0x2f,0x01,0x09,0x05,0x30,0x0a,0x01,0x01,0x0b,0x05,0x47,0x0a,0x2f,0x08,0x03,
-0x02,0x01,0x07,0x08,0x01,0x09,0x04,0x28,0x09,0x00,0x09,0x01,0x09,0x07,0x33,0x09,
-0x00,0x26,0x00,0x03,0x01,0x09,0x07,0x44,0x08,0x08,0x10,0x36,0x08,0x01,0x2a,0x00,
-0x03,0x26,0xff,0x6d,0x3f,0x00,0x01,0x00,0x00,0x01,0x0a,0x00,0x00,0x04,0x00,0x05,
-0x63,0x68,0x6f,0x6d,0x70,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,
-0x05,0x69,0x6e,0x64,0x65,0x78,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x00,0x00,0xce,
-0x00,0x04,0x00,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3b,0x39,0x08,0x00,0x00,
-0x01,0x04,0x02,0x33,0x04,0x00,0x06,0x05,0x4d,0x04,0x28,0x04,0x00,0x0a,0x1d,0x05,
-0x01,0x5c,0x06,0x00,0x2f,0x04,0x02,0x02,0x01,0x04,0x01,0x1d,0x05,0x03,0x32,0x04,
-0x04,0x01,0x28,0x04,0x00,0x05,0x11,0x04,0x26,0x00,0x0a,0x1d,0x05,0x05,0x5c,0x06,
-0x01,0x2f,0x04,0x02,0x02,0x3d,0x04,0x00,0x02,0x00,0x00,0x12,0x7a,0x65,0x72,0x6f,
-0x20,0x77,0x69,0x64,0x74,0x68,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x00,0x00,
-0x00,0x23,0x6e,0x6f,0x20,0x69,0x6d,0x70,0x6c,0x69,0x63,0x69,0x74,0x20,0x63,0x6f,
-0x6e,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x69,0x6e,0x74,0x6f,0x20,0x49,0x6e,
-0x74,0x65,0x67,0x65,0x72,0x00,0x00,0x06,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,
-0x00,0x00,0x0d,0x41,0x72,0x67,0x75,0x6d,0x65,0x6e,0x74,0x45,0x72,0x72,0x6f,0x72,
-0x00,0x00,0x05,0x72,0x61,0x69,0x73,0x65,0x00,0x00,0x07,0x49,0x6e,0x74,0x65,0x67,
-0x65,0x72,0x00,0x00,0x08,0x6b,0x69,0x6e,0x64,0x5f,0x6f,0x66,0x3f,0x00,0x00,0x09,
-0x54,0x79,0x70,0x65,0x45,0x72,0x72,0x6f,0x72,0x00,0x00,0x00,0x00,0x28,0x00,0x01,
-0x00,0x03,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x0c,0x11,0x01,0x11,0x02,0x67,0x01,
-0x00,0x69,0x01,0x00,0x3d,0x01,0x00,0x00,0x00,0x01,0x00,0x05,0x51,0x75,0x65,0x75,
-0x65,0x00,0x00,0x00,0x00,0x4f,0x00,0x01,0x00,0x02,0x00,0x02,0x00,0x00,0x00,0x00,
-0x00,0x15,0x6b,0x01,0x00,0x00,0x6d,0x01,0x00,0x6d,0x02,0x00,0x6b,0x01,0x03,0x01,
-0x6d,0x04,0x03,0x6d,0x05,0x03,0x40,0x00,0x00,0x00,0x06,0x00,0x04,0x70,0x75,0x73,
-0x68,0x00,0x00,0x03,0x65,0x6e,0x71,0x00,0x00,0x02,0x3c,0x3c,0x00,0x00,0x03,0x70,
-0x6f,0x70,0x00,0x00,0x03,0x64,0x65,0x71,0x00,0x00,0x05,0x73,0x68,0x69,0x66,0x74,
-0x00,0x00,0x00,0x00,0x29,0x00,0x03,0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x0c,0x39,0x04,0x00,0x00,0x01,0x04,0x01,0x2f,0x03,0x00,0x01,0x3f,0x00,0x00,0x00,
-0x01,0x00,0x06,0x5f,0x5f,0x70,0x75,0x73,0x68,0x00,0x00,0x00,0x01,0xa1,0x00,0x07,
-0x00,0x0b,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xa8,0x39,0x00,0x20,0x04,0x26,0x00,
-0x03,0x26,0x00,0x02,0x14,0x01,0x3a,0x04,0x00,0x27,0x04,0x00,0x05,0x11,0x04,0x26,
-0x00,0x03,0x3c,0x04,0x00,0x3b,0x01,0x07,0x04,0x29,0x07,0x00,0x3e,0x01,0x07,0x01,
-0x28,0x07,0x00,0x0a,0x1d,0x08,0x01,0x5c,0x09,0x00,0x2f,0x07,0x02,0x02,0x01,0x07,
-0x04,0x1d,0x08,0x03,0x32,0x07,0x04,0x01,0x27,0x07,0x00,0x0a,0x1d,0x08,0x05,0x5c,
-0x09,0x01,0x2f,0x07,0x02,0x02,0x01,0x07,0x04,0x06,0x08,0x4e,0x07,0x28,0x07,0x00,
-0x0a,0x1d,0x08,0x01,0x5c,0x09,0x02,0x2f,0x07,0x02,0x02,0x01,0x07,0x04,0x29,0x07,
-0x00,0x03,0x26,0x00,0x05,0x11,0x07,0x26,0x00,0x07,0x01,0x08,0x04,0x2f,0x07,0x06,
-0x01,0x01,0x05,0x07,0x00,0x01,0x08,0x01,0x01,0x09,0x05,0x2f,0x07,0x07,0x02,0x01,
-0x06,0x07,0x01,0x08,0x06,0x2f,0x07,0x08,0x01,0x28,0x07,0x00,0x04,0x11,0x07,0x3e,
-0x07,0x01,0x08,0x06,0x2f,0x07,0x09,0x01,0x27,0x07,0x00,0x02,0x3e,0x06,0x26,0xff,
-0xd3,0x40,0x00,0x03,0x00,0x00,0x29,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x20,0x63,
-0x61,0x6e,0x6e,0x6f,0x74,0x20,0x62,0x65,0x20,0x63,0x6f,0x6d,0x62,0x69,0x6e,0x65,
-0x64,0x20,0x77,0x69,0x74,0x68,0x20,0x6e,0x6f,0x6e,0x5f,0x62,0x6c,0x6f,0x63,0x6b,
-0x00,0x00,0x00,0x1d,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x5f,0x6d,0x73,0x20,0x6d,
-0x75,0x73,0x74,0x20,0x62,0x65,0x20,0x61,0x6e,0x20,0x49,0x6e,0x74,0x65,0x67,0x65,
-0x72,0x00,0x00,0x00,0x1f,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x5f,0x6d,0x73,0x20,
-0x6d,0x75,0x73,0x74,0x20,0x62,0x65,0x20,0x6e,0x6f,0x6e,0x2d,0x6e,0x65,0x67,0x61,
-0x74,0x69,0x76,0x65,0x00,0x00,0x0a,0x00,0x0a,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,
-0x5f,0x6d,0x73,0x00,0x00,0x0d,0x41,0x72,0x67,0x75,0x6d,0x65,0x6e,0x74,0x45,0x72,
-0x72,0x6f,0x72,0x00,0x00,0x05,0x72,0x61,0x69,0x73,0x65,0x00,0x00,0x07,0x49,0x6e,
-0x74,0x65,0x67,0x65,0x72,0x00,0x00,0x05,0x69,0x73,0x5f,0x61,0x3f,0x00,0x00,0x09,
-0x54,0x79,0x70,0x65,0x45,0x72,0x72,0x6f,0x72,0x00,0x00,0x0a,0x5f,0x5f,0x64,0x65,
-0x61,0x64,0x6c,0x69,0x6e,0x65,0x00,0x00,0x09,0x5f,0x5f,0x70,0x6f,0x70,0x5f,0x74,
-0x72,0x79,0x00,0x00,0x0a,0x5f,0x5f,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x3f,0x00,
-0x00,0x08,0x5f,0x5f,0x72,0x65,0x74,0x72,0x79,0x3f,0x00,0x45,0x4e,0x44,0x00,0x00,
-0x00,0x00,0x08,
+0x00,0x00,0x00,0x00,0x52,0x00,0x03,0x00,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x29,0x39,0x00,0x00,0x00,0x06,0x02,0x01,0x03,0x02,0x30,0x04,0x00,0x4e,0x03,0x28,
+0x03,0x00,0x16,0x00,0x01,0x05,0x02,0x2f,0x04,0x01,0x01,0x44,0x03,0x00,0x00,0x36,
+0x03,0x01,0x49,0x02,0x03,0x01,0x26,0xff,0xde,0x3f,0x00,0x00,0x00,0x02,0x00,0x08,
+0x62,0x79,0x74,0x65,0x73,0x69,0x7a,0x65,0x00,0x00,0x07,0x67,0x65,0x74,0x62,0x79,
+0x74,0x65,0x00,0x00,0x00,0x00,0x87,0x00,0x05,0x00,0x09,0x00,0x01,0x00,0x00,0x00,
+0x00,0x00,0x3a,0x39,0x04,0x20,0x00,0x26,0x00,0x03,0x26,0x00,0x03,0x5c,0x02,0x00,
+0x01,0x06,0x01,0x01,0x07,0x02,0x2f,0x05,0x00,0x02,0x30,0x05,0x01,0x01,0x04,0x05,
+0x01,0x05,0x01,0x30,0x06,0x02,0x4f,0x05,0x28,0x05,0x00,0x02,0x3d,0x04,0x00,0x01,
+0x05,0x02,0x62,0x06,0x00,0x34,0x05,0x03,0x00,0x26,0xff,0xf2,0x40,0x00,0x01,0x00,
+0x00,0x01,0x20,0x00,0x00,0x04,0x00,0x16,0x5f,0x5f,0x6c,0x6a,0x75,0x73,0x74,0x5f,
+0x72,0x6a,0x75,0x73,0x74,0x5f,0x61,0x72,0x67,0x63,0x68,0x65,0x63,0x6b,0x00,0x00,
+0x03,0x64,0x75,0x70,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x09,
+0x65,0x61,0x63,0x68,0x5f,0x63,0x68,0x61,0x72,0x00,0x00,0x00,0x00,0x4f,0x00,0x03,
+0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x2d,0x39,0x04,0x00,0x00,0x21,0x03,
+0x04,0x00,0x01,0x04,0x01,0x32,0x03,0x00,0x01,0x21,0x03,0x04,0x00,0x33,0x03,0x01,
+0x21,0x04,0x01,0x00,0x4d,0x03,0x28,0x03,0x00,0x09,0x21,0x03,0x04,0x00,0x3e,0x03,
+0x26,0x00,0x02,0x11,0x03,0x3d,0x03,0x00,0x00,0x00,0x02,0x00,0x02,0x3c,0x3c,0x00,
+0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x00,0x00,0xb7,0x00,0x06,0x00,
+0x0a,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x68,0x39,0x04,0x20,0x00,0x26,0x00,0x03,
+0x26,0x00,0x03,0x5c,0x02,0x00,0x01,0x07,0x01,0x01,0x08,0x02,0x2f,0x06,0x00,0x02,
+0x01,0x06,0x01,0x30,0x07,0x01,0x4f,0x06,0x28,0x06,0x00,0x05,0x30,0x06,0x02,0x3d,
+0x06,0x01,0x06,0x01,0x30,0x07,0x01,0x47,0x06,0x01,0x04,0x06,0x5c,0x05,0x01,0x00,
+0x01,0x06,0x05,0x01,0x07,0x02,0x32,0x06,0x03,0x01,0x01,0x06,0x04,0x01,0x07,0x05,
+0x33,0x07,0x01,0x4f,0x06,0x28,0x06,0x00,0x03,0x2a,0x00,0x03,0x26,0xff,0xe0,0x01,
+0x06,0x05,0x06,0x07,0x01,0x08,0x04,0x32,0x06,0x04,0x02,0x12,0x07,0x45,0x06,0x3d,
+0x06,0x00,0x02,0x00,0x00,0x01,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x05,0x00,0x16,
+0x5f,0x5f,0x6c,0x6a,0x75,0x73,0x74,0x5f,0x72,0x6a,0x75,0x73,0x74,0x5f,0x61,0x72,
+0x67,0x63,0x68,0x65,0x63,0x6b,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,
+0x00,0x03,0x64,0x75,0x70,0x00,0x00,0x02,0x3c,0x3c,0x00,0x00,0x02,0x5b,0x5d,0x00,
+0x00,0x00,0x00,0xea,0x00,0x08,0x00,0x0d,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xb3,
+0x39,0x00,0x20,0x04,0x26,0x00,0x03,0x26,0x00,0x03,0x5c,0x01,0x00,0x3a,0x04,0x00,
+0x27,0x04,0x00,0x05,0x14,0x04,0x26,0x00,0x03,0x3c,0x04,0x00,0x3b,0x06,0x05,0x01,
+0x08,0x05,0x30,0x09,0x01,0x4e,0x08,0x28,0x08,0x00,0x87,0x00,0x01,0x09,0x01,0x01,
+0x0a,0x05,0x2f,0x08,0x02,0x02,0x01,0x06,0x08,0x01,0x08,0x06,0x28,0x08,0x00,0x40,
+0x01,0x09,0x05,0x01,0x0a,0x06,0x01,0x0b,0x05,0x47,0x0a,0x01,0x0b,0x01,0x33,0x0b,
+0x01,0x45,0x0a,0x2f,0x08,0x03,0x02,0x01,0x07,0x08,0x01,0x09,0x04,0x28,0x09,0x00,
+0x09,0x01,0x09,0x07,0x33,0x09,0x00,0x26,0x00,0x03,0x01,0x09,0x07,0x44,0x08,0x08,
+0x10,0x36,0x08,0x01,0x01,0x08,0x06,0x46,0x08,0x01,0x01,0x05,0x08,0x26,0x00,0x2f,
+0x01,0x09,0x05,0x30,0x0a,0x01,0x01,0x0b,0x05,0x47,0x0a,0x2f,0x08,0x03,0x02,0x01,
+0x07,0x08,0x01,0x09,0x04,0x28,0x09,0x00,0x09,0x01,0x09,0x07,0x33,0x09,0x00,0x26,
+0x00,0x03,0x01,0x09,0x07,0x44,0x08,0x08,0x10,0x36,0x08,0x01,0x2a,0x00,0x03,0x26,
+0xff,0x6d,0x3f,0x00,0x01,0x00,0x00,0x01,0x0a,0x00,0x00,0x04,0x00,0x05,0x63,0x68,
+0x6f,0x6d,0x70,0x00,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,0x05,0x69,
+0x6e,0x64,0x65,0x78,0x00,0x00,0x02,0x5b,0x5d,0x00,0x00,0x00,0x00,0xce,0x00,0x04,
+0x00,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3b,0x39,0x08,0x00,0x00,0x01,0x04,
+0x02,0x33,0x04,0x00,0x06,0x05,0x4d,0x04,0x28,0x04,0x00,0x0a,0x1d,0x05,0x01,0x5c,
+0x06,0x00,0x2f,0x04,0x02,0x02,0x01,0x04,0x01,0x1d,0x05,0x03,0x32,0x04,0x04,0x01,
+0x28,0x04,0x00,0x05,0x11,0x04,0x26,0x00,0x0a,0x1d,0x05,0x05,0x5c,0x06,0x01,0x2f,
+0x04,0x02,0x02,0x3d,0x04,0x00,0x02,0x00,0x00,0x12,0x7a,0x65,0x72,0x6f,0x20,0x77,
+0x69,0x64,0x74,0x68,0x20,0x70,0x61,0x64,0x64,0x69,0x6e,0x67,0x00,0x00,0x00,0x23,
+0x6e,0x6f,0x20,0x69,0x6d,0x70,0x6c,0x69,0x63,0x69,0x74,0x20,0x63,0x6f,0x6e,0x76,
+0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x69,0x6e,0x74,0x6f,0x20,0x49,0x6e,0x74,0x65,
+0x67,0x65,0x72,0x00,0x00,0x06,0x00,0x06,0x6c,0x65,0x6e,0x67,0x74,0x68,0x00,0x00,
+0x0d,0x41,0x72,0x67,0x75,0x6d,0x65,0x6e,0x74,0x45,0x72,0x72,0x6f,0x72,0x00,0x00,
+0x05,0x72,0x61,0x69,0x73,0x65,0x00,0x00,0x07,0x49,0x6e,0x74,0x65,0x67,0x65,0x72,
+0x00,0x00,0x08,0x6b,0x69,0x6e,0x64,0x5f,0x6f,0x66,0x3f,0x00,0x00,0x09,0x54,0x79,
+0x70,0x65,0x45,0x72,0x72,0x6f,0x72,0x00,0x00,0x00,0x00,0x28,0x00,0x01,0x00,0x03,
+0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x0c,0x11,0x01,0x11,0x02,0x67,0x01,0x00,0x69,
+0x01,0x00,0x3d,0x01,0x00,0x00,0x00,0x01,0x00,0x05,0x51,0x75,0x65,0x75,0x65,0x00,
+0x00,0x00,0x00,0x4f,0x00,0x01,0x00,0x02,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x15,
+0x6b,0x01,0x00,0x00,0x6d,0x01,0x00,0x6d,0x02,0x00,0x6b,0x01,0x03,0x01,0x6d,0x04,
+0x03,0x6d,0x05,0x03,0x40,0x00,0x00,0x00,0x06,0x00,0x04,0x70,0x75,0x73,0x68,0x00,
+0x00,0x03,0x65,0x6e,0x71,0x00,0x00,0x02,0x3c,0x3c,0x00,0x00,0x03,0x70,0x6f,0x70,
+0x00,0x00,0x03,0x64,0x65,0x71,0x00,0x00,0x05,0x73,0x68,0x69,0x66,0x74,0x00,0x00,
+0x00,0x00,0x29,0x00,0x03,0x00,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0c,0x39,
+0x04,0x00,0x00,0x01,0x04,0x01,0x2f,0x03,0x00,0x01,0x3f,0x00,0x00,0x00,0x01,0x00,
+0x06,0x5f,0x5f,0x70,0x75,0x73,0x68,0x00,0x00,0x00,0x01,0xa1,0x00,0x07,0x00,0x0b,
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xa8,0x39,0x00,0x20,0x04,0x26,0x00,0x03,0x26,
+0x00,0x02,0x14,0x01,0x3a,0x04,0x00,0x27,0x04,0x00,0x05,0x11,0x04,0x26,0x00,0x03,
+0x3c,0x04,0x00,0x3b,0x01,0x07,0x04,0x29,0x07,0x00,0x3e,0x01,0x07,0x01,0x28,0x07,
+0x00,0x0a,0x1d,0x08,0x01,0x5c,0x09,0x00,0x2f,0x07,0x02,0x02,0x01,0x07,0x04,0x1d,
+0x08,0x03,0x32,0x07,0x04,0x01,0x27,0x07,0x00,0x0a,0x1d,0x08,0x05,0x5c,0x09,0x01,
+0x2f,0x07,0x02,0x02,0x01,0x07,0x04,0x06,0x08,0x4e,0x07,0x28,0x07,0x00,0x0a,0x1d,
+0x08,0x01,0x5c,0x09,0x02,0x2f,0x07,0x02,0x02,0x01,0x07,0x04,0x29,0x07,0x00,0x03,
+0x26,0x00,0x05,0x11,0x07,0x26,0x00,0x07,0x01,0x08,0x04,0x2f,0x07,0x06,0x01,0x01,
+0x05,0x07,0x00,0x01,0x08,0x01,0x01,0x09,0x05,0x2f,0x07,0x07,0x02,0x01,0x06,0x07,
+0x01,0x08,0x06,0x2f,0x07,0x08,0x01,0x28,0x07,0x00,0x04,0x11,0x07,0x3e,0x07,0x01,
+0x08,0x06,0x2f,0x07,0x09,0x01,0x27,0x07,0x00,0x02,0x3e,0x06,0x26,0xff,0xd3,0x40,
+0x00,0x03,0x00,0x00,0x29,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x20,0x63,0x61,0x6e,
+0x6e,0x6f,0x74,0x20,0x62,0x65,0x20,0x63,0x6f,0x6d,0x62,0x69,0x6e,0x65,0x64,0x20,
+0x77,0x69,0x74,0x68,0x20,0x6e,0x6f,0x6e,0x5f,0x62,0x6c,0x6f,0x63,0x6b,0x00,0x00,
+0x00,0x1d,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x5f,0x6d,0x73,0x20,0x6d,0x75,0x73,
+0x74,0x20,0x62,0x65,0x20,0x61,0x6e,0x20,0x49,0x6e,0x74,0x65,0x67,0x65,0x72,0x00,
+0x00,0x00,0x1f,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x5f,0x6d,0x73,0x20,0x6d,0x75,
+0x73,0x74,0x20,0x62,0x65,0x20,0x6e,0x6f,0x6e,0x2d,0x6e,0x65,0x67,0x61,0x74,0x69,
+0x76,0x65,0x00,0x00,0x0a,0x00,0x0a,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x5f,0x6d,
+0x73,0x00,0x00,0x0d,0x41,0x72,0x67,0x75,0x6d,0x65,0x6e,0x74,0x45,0x72,0x72,0x6f,
+0x72,0x00,0x00,0x05,0x72,0x61,0x69,0x73,0x65,0x00,0x00,0x07,0x49,0x6e,0x74,0x65,
+0x67,0x65,0x72,0x00,0x00,0x05,0x69,0x73,0x5f,0x61,0x3f,0x00,0x00,0x09,0x54,0x79,
+0x70,0x65,0x45,0x72,0x72,0x6f,0x72,0x00,0x00,0x0a,0x5f,0x5f,0x64,0x65,0x61,0x64,
+0x6c,0x69,0x6e,0x65,0x00,0x00,0x09,0x5f,0x5f,0x70,0x6f,0x70,0x5f,0x74,0x72,0x79,
+0x00,0x00,0x0a,0x5f,0x5f,0x74,0x69,0x6d,0x65,0x6f,0x75,0x74,0x3f,0x00,0x00,0x08,
+0x5f,0x5f,0x72,0x65,0x74,0x72,0x79,0x3f,0x00,0x45,0x4e,0x44,0x00,0x00,0x00,0x00,
+0x08,
 };
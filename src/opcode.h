@@ -24,6 +24,53 @@ extern "C" {
 #endif
 
 
+#if MRBC_USE_PREDECODE
+//================================================================
+/*!@brief
+  Pre-decoded instruction. (made by the loader, see load.c)
+
+  All instructions have the same size. The OP_EXTn prefix is folded
+  into the 16bit operands, and the W operand is held as a<<16 | b.
+*/
+typedef struct INST {
+  uint8_t op;		//!< opcode.
+  uint8_t reserved;
+  uint16_t a;		//!< 1st operand.
+  uint16_t b;		//!< 2nd operand.
+  uint16_t c;		//!< 3rd operand.
+} mrbc_inst;
+
+// vm->inst points to the next of opcode, until the operands are fetched.
+#define FETCH_INST_ ((const mrbc_inst *)(vm->inst - 1))
+
+#define FETCH_Z() \
+  (vm->inst += sizeof(mrbc_inst) - 1)
+
+#define FETCH_B() \
+  unsigned int a = FETCH_INST_->a; \
+  FETCH_Z(); \
+  (void)a
+
+#define FETCH_BB() \
+  unsigned int a = FETCH_INST_->a, b = FETCH_INST_->b; \
+  FETCH_Z(); \
+  (void)a, (void)b
+
+#define FETCH_BBB() \
+  unsigned int a = FETCH_INST_->a, b = FETCH_INST_->b, c = FETCH_INST_->c; \
+  FETCH_Z(); \
+  (void)a, (void)b, (void)c
+
+#define FETCH_BS()  FETCH_BB()
+#define FETCH_BSS() FETCH_BBB()
+#define FETCH_S()   FETCH_B()
+
+#define FETCH_W() \
+  uint32_t a = (uint32_t)FETCH_INST_->a << 16 | FETCH_INST_->b; \
+  FETCH_Z(); \
+  (void)a
+
+#else
 #define FETCH_Z() (void)0
 
 #if defined(MRBC_SUPPORT_OP_EXT)
@@ -101,6 +148,7 @@ extern "C" {
   uint32_t a; \
   a = *vm->inst++; a = a << 8 | *vm->inst++; a = a << 8 | *vm->inst++; \
   (void)a
+#endif // MRBC_USE_PREDECODE
 
 
 //================================================================
@@ -240,6 +288,60 @@ enum OPCODE {
   OP_EXT2       = 0x74, //!< Z    make 2nd operand (b) 16bit
   OP_EXT3       = 0x75, //!< Z    make 1st and 2nd operands 16bit
   OP_STOP       = 0x76, //!< Z    stop VM
+
+/*-----------------------------------------------------------------------
+  fused instructions. (internal use only, made by the loader)
+  Each replaces the opcode of the 1st instruction of the pair, and the
+  2nd instruction is left as it is.
+------------------------------------------------------------------------*/
+  OP_LOADI__1_ADD = 0x77, //!< LOADI__1 + ADD
+  OP_LOADI_0_ADD  = 0x78, //!< LOADI_0 + ADD
+  OP_LOADI_1_ADD  = 0x79, //!< LOADI_1 + ADD
+  OP_LOADI_2_ADD  = 0x7A, //!< LOADI_2 + ADD
+  OP_LOADI_3_ADD  = 0x7B, //!< LOADI_3 + ADD
+  OP_LOADI_4_ADD  = 0x7C, //!< LOADI_4 + ADD
+  OP_LOADI_5_ADD  = 0x7D, //!< LOADI_5 + ADD
+  OP_LOADI_6_ADD  = 0x7E, //!< LOADI_6 + ADD
+  OP_LOADI_7_ADD  = 0x7F, //!< LOADI_7 + ADD
+  OP_MOVE_SEND    = 0x80, //!< MOVE + SEND
+  OP_MOVE_SSEND   = 0x81, //!< MOVE + SSEND
+  OP_GETIV_SEND0  = 0x82, //!< GETIV + SEND0
+  OP_EQ_JMPNOT    = 0x83, //!< EQ + JMPNOT
+  OP_LT_JMPNOT    = 0x84, //!< LT + JMPNOT
+  OP_LE_JMPNOT    = 0x85, //!< LE + JMPNOT
+  OP_GT_JMPNOT    = 0x86, //!< GT + JMPNOT
+  OP_GE_JMPNOT    = 0x87, //!< GE + JMPNOT
+  OP_EQ_JMPIF     = 0x88, //!< EQ + JMPIF
+  OP_LT_JMPIF     = 0x89, //!< LT + JMPIF
+  OP_LE_JMPIF     = 0x8A, //!< LE + JMPIF
+  OP_GT_JMPIF     = 0x8B, //!< GT + JMPIF
+  OP_GE_JMPIF     = 0x8C, //!< GE + JMPIF
+  OP_LOADNIL_RETURN = 0x8D, //!< LOADNIL + RETURN
+  OP_FUSED_LAST   = 0x8D,
+
+/*-----------------------------------------------------------------------
+  quickened instructions. (internal use only, rewritten at run time)
+  Specialized for operand types, and revert to the generic one when
+  the types are different.
+------------------------------------------------------------------------*/
+  OP_ADD_II     = 0x8E, //!< B    ADD, Integer + Integer
+  OP_ADD_FF     = 0x8F, //!< B    ADD, Float + Float
+  OP_SUB_II     = 0x90, //!< B    SUB, Integer - Integer
+  OP_SUB_FF     = 0x91, //!< B    SUB, Float - Float
+  OP_MUL_II     = 0x92, //!< B    MUL, Integer * Integer
+  OP_MUL_FF     = 0x93, //!< B    MUL, Float * Float
+  OP_ADDI_I     = 0x94, //!< BB   ADDI, Integer + mrb_int(b)
+  OP_SUBI_I     = 0x95, //!< BB   SUBI, Integer - mrb_int(b)
+  OP_EQ_II      = 0x96, //!< B    EQ, Integer == Integer
+  OP_LT_II      = 0x97, //!< B    LT, Integer < Integer
+  OP_LT_FF      = 0x98, //!< B    LT, Float < Float
+  OP_LE_II      = 0x99, //!< B    LE, Integer <= Integer
+  OP_LE_FF      = 0x9A, //!< B    LE, Float <= Float
+  OP_GT_II      = 0x9B, //!< B    GT, Integer > Integer
+  OP_GT_FF      = 0x9C, //!< B    GT, Float > Float
+  OP_GE_II      = 0x9D, //!< B    GE, Integer >= Integer
+  OP_GE_FF      = 0x9E, //!< B    GE, Float >= Float
+  OP_QUICK_LAST = 0x9E,
 };
 
 
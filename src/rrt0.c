@@ -254,7 +254,7 @@ void mrbc_tick(void)
 //================================================================
 /*! create (allocate) TCB.
 
-  @param  regs_size	num of allocated registers.
+  @param  regs_size	maximum num of registers.
   @param  task_state	task initial state.
   @param  priority	task priority.
   @return pointer to TCB.
@@ -273,7 +273,7 @@ void mrbc_tick(void)
 mrbc_tcb * mrbc_tcb_new( int regs_size, enum MrbcTaskState task_state, int priority )
 {
   mrbc_tcb *tcb;
-  unsigned int size = sizeof(mrbc_tcb) + sizeof(mrbc_value) * regs_size;
+  unsigned int size = sizeof(mrbc_tcb);
 
   tcb = mrbc_raw_alloc(size);
   memset(tcb, 0, size);
@@ -282,7 +282,7 @@ mrbc_tcb * mrbc_tcb_new( int regs_size, enum MrbcTaskState task_state, int prior
 #endif
   tcb->priority = priority;
   tcb->state = task_state;
-  tcb->vm.regs_size = regs_size;
+  tcb->vm.regs_max_size = regs_size;
 
   return tcb;
 }
@@ -294,6 +294,10 @@ mrbc_tcb * mrbc_tcb_new( int regs_size, enum MrbcTaskState task_state, int prior
   @param  byte_code	pointer to VM byte code.
   @param  tcb		Task control block with parameter, or NULL.
   @return Pointer to mrbc_tcb or NULL.
+  @note	  The byte code must be kept while the task exists. And with
+	  MRBC_USE_SHARED_STRING_LITERAL, it must be kept until the end of
+	  the program, because the string literals can be shared with the
+	  other tasks.
 */
 mrbc_tcb * mrbc_create_task(const void *byte_code, mrbc_tcb *tcb)
 {
@@ -312,7 +316,11 @@ mrbc_tcb * mrbc_create_task(const void *byte_code, mrbc_tcb *tcb)
     mrbc_vm_close( &tcb->vm );
     return NULL;
   }
-  mrbc_vm_begin( &tcb->vm );
+  if( mrbc_vm_begin( &tcb->vm ) != 0 ) {
+    mrbc_print_vm_exception( &tcb->vm );
+    mrbc_vm_close( &tcb->vm );
+    return NULL;
+  }
 
   mrbc_hal_disable_irq();
   mrbc_task_q_insert(tcb);
@@ -464,6 +472,7 @@ int mrbc_run(void)
       mrbc_hal_enable_irq();
       if( flag_exit ) return ret;
 #endif
+      mrbc_flush();
       mrbc_hal_idle_cpu();
       continue;
     }
@@ -490,6 +499,7 @@ int mrbc_run(void)
     }
     mrbc_tick();
 #endif
+    mrbc_flush();
 
     /*
       did the task done?
@@ -543,6 +553,7 @@ mrbc_run_step(void)
 
   int ret_vm_run = mrbc_vm_run(&tcb->vm);
   tcb->vm.flag_preemption = 0;
+  mrbc_flush();
 
   /*
     did the task done?
@@ -1470,7 +1481,10 @@ static void c_task_rewind(mrbc_vm *vm, mrbc_value v[], int argc)
   mrbc_tcb *tcb = *MRBC_INSTANCE_DATA_PTR(&v[0], mrbc_tcb *);
   if( tcb->state != TASKSTATE_DORMANT ) return;
 
-  mrbc_vm_begin( &tcb->vm );
+  if( mrbc_vm_begin( &tcb->vm ) != 0 ) {
+    mrbc_print_vm_exception( &tcb->vm );
+    mrbc_decref( &tcb->vm.exception );
+  }
 }
 
 
@@ -155,6 +155,28 @@ int mrbc_compare(const mrbc_value *v1, const mrbc_value *v2)
 }
 
 
+//================================================================
+/*! check that two mrbc_values are equal
+
+  Same as mrbc_compare() == 0, but the strings of different size or
+  hash value are not compared by contents.
+
+  @param  v1	Pointer to mrbc_value
+  @param  v2	Pointer to another mrbc_value
+  @return	1 if v1 == v2.
+*/
+int mrbc_equal(const mrbc_value *v1, const mrbc_value *v2)
+{
+#if MRBC_USE_STRING
+  if( mrbc_type(*v1) == MRBC_TT_STRING && mrbc_type(*v2) == MRBC_TT_STRING ) {
+    return mrbc_string_equal( v1, v2 );
+  }
+#endif
+
+  return mrbc_compare( v1, v2 ) == 0;
+}
+
+
 //================================================================
 /*! convert ASCII string to integer mruby/c version
 
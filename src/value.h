@@ -260,7 +260,7 @@ typedef struct RObject mrb_value;	// not recommended.
 #define GET_ARY_ARG(n)		(v[(n)])
 #define GET_ARG(n)		(v[(n)])
 #define GET_FLOAT_ARG(n)	(v[(n)].d)
-#define GET_STRING_ARG(n)	(v[(n)].string->data)
+#define GET_STRING_ARG(n)	((uint8_t *)mrbc_string_cstr(&v[(n)]))
 
 // for Numeric values.
 /*!
@@ -521,6 +521,7 @@ extern void (* const mrbc_delfunc[])(mrbc_value *);
 /***** Function prototypes **************************************************/
 //@cond
 int mrbc_compare(const mrbc_value *v1, const mrbc_value *v2);
+int mrbc_equal(const mrbc_value *v1, const mrbc_value *v2);
 mrbc_int_t mrbc_atoi(const char *s, int base);
 int mrbc_strcpy(char *dest, int destsize, const char *src);
 void mrbc_format_float(char *buf, int bufsiz, mrbc_float_t flo);
@@ -27,8 +27,15 @@
 #include "opcode.h"
 #include "mrubyc.h"
 
+// threaded dispatch needs the "labels as values" extension of GCC/Clang.
+#if MRBC_USE_THREADED_DISPATCH && !defined(__GNUC__)
+#undef MRBC_USE_THREADED_DISPATCH
+#define MRBC_USE_THREADED_DISPATCH 0
+#endif
+
 /***** Constat values *******************************************************/
 #define CALL_MAXARGS 15		// 15 is CALL_MAXARGS in mruby
+#define REGS_MARGIN 8		// spare registers for mrbc_send() in C functions
 
 
 /***** Macros ***************************************************************/
@@ -37,15 +44,278 @@
 
 
 /***** Typedefs *************************************************************/
+//================================================================
+/*!@brief
+  Inline method cache entry.
+
+  Holds the method found at a method call site.
+  The entry is valid only while the receiver class, the method name and
+  the method definition epoch are the same as when it was cached.
+*/
+typedef struct CALLCACHE {
+  const uint8_t *inst;		//!< call site. (next instruction)
+  struct RClass *cls;		//!< class of the receiver.
+  struct RClass *own_class;	//!< class that owns the method.
+  union {
+    struct IREP *irep;		//!< to IREP for ruby proc.
+    mrbc_func_t func;		//!< to C function.
+  };
+  uint32_t method_epoch;	//!< mrbc_method_epoch when cached.
+  mrbc_sym sym_id;		//!< method name.
+  uint8_t  c_func;		//!< 0:IREP, 1:C Func, 2:C Func (built-in)
+} mrbc_callcache;
+
+
+//================================================================
+/*!@brief
+  Constant cache entry.
+
+  Holds the constant found at OP_GETCONST or OP_GETMCNST site.
+  The entry is valid only while the base class of the search, the
+  constant name and the constant definition epoch are the same as
+  when it was cached.
+*/
+typedef struct CONSTCACHE {
+  const uint8_t *inst;		//!< instruction site. (next instruction)
+  struct RClass *cls;		//!< base class of the search.
+  mrbc_value *value;		//!< found constant.
+  uint32_t const_epoch;		//!< mrbc_const_epoch when cached.
+  mrbc_sym sym_id;		//!< constant name.
+} mrbc_constcache;
+
+
+//================================================================
+/*!@brief
+  Instance variable cache entry.
+
+  Holds the slot index of an instance variable, for the shape of self
+  seen at OP_GETIV or OP_SETIV site. Since shapes are never changed,
+  the entry is valid as long as the shape and the name are the same.
+*/
+typedef struct IVCACHE {
+  struct RShape *shape;		//!< shape of self.
+  struct RShape *next_shape;	//!< shape after the variable is set.
+  mrbc_sym sym_id;		//!< variable name. (with '@')
+  int16_t index;		//!< slot index, or -1 if not exist.
+} mrbc_ivcache;
+
+
 /***** Function prototypes **************************************************/
 /***** Local variables ******************************************************/
 //! for getting the VM ID
 static uint16_t free_vm_bitmap[MAX_VM_COUNT / 16 + 1];
 
+#if MRBC_INLINE_CACHE_SIZE > 0
+//! inline method cache. (direct mapped by call site address)
+static mrbc_callcache call_cache[MRBC_INLINE_CACHE_SIZE];
+#endif
+
+#if MRBC_CONST_CACHE_SIZE > 0
+//! constant cache. (direct mapped by instruction site address)
+static mrbc_constcache const_cache[MRBC_CONST_CACHE_SIZE];
+#endif
+
+#if MRBC_IVAR_CACHE_SIZE > 0
+//! instance variable cache. (direct mapped by instruction site address)
+static mrbc_ivcache ivar_cache[MRBC_IVAR_CACHE_SIZE];
+#endif
+
 
 /***** Global variables *****************************************************/
 /***** Signal catching functions ********************************************/
 /***** Local functions ******************************************************/
+#if MRBC_INLINE_CACHE_SIZE > 0
+//================================================================
+/*! Find the inline method cache entry of the current call site.
+
+  @param  vm	pointer to VM.
+  @return	pointer to the cache entry.
+*/
+static inline mrbc_callcache * find_call_cache( const mrbc_vm *vm )
+{
+  // vm->inst points after the call instruction, that is unique per site.
+  return &call_cache[ ((uintptr_t)vm->inst >> 1) & (MRBC_INLINE_CACHE_SIZE - 1) ];
+}
+#endif
+
+
+#if MRBC_CONST_CACHE_SIZE > 0
+//================================================================
+/*! Find the constant cache entry of the current instruction site.
+
+  @param  vm	pointer to VM.
+  @return	pointer to the cache entry.
+*/
+static inline mrbc_constcache * find_const_cache( const mrbc_vm *vm )
+{
+  return &const_cache[ ((uintptr_t)vm->inst >> 1) & (MRBC_CONST_CACHE_SIZE - 1) ];
+}
+
+
+//================================================================
+/*! Look up the constant cache.
+
+  @param  cc		pointer to the cache entry.
+  @param  vm		pointer to VM.
+  @param  cls		base class of the search.
+  @param  sym_id	constant name.
+  @return		pointer to the constant or NULL.
+*/
+static inline mrbc_value * get_const_cache( const mrbc_constcache *cc, const mrbc_vm *vm, const mrbc_class *cls, mrbc_sym sym_id )
+{
+  if( cc->inst == vm->inst && cc->cls == cls && cc->sym_id == sym_id &&
+      cc->const_epoch == mrbc_const_epoch ) return cc->value;
+
+  return NULL;
+}
+
+
+//================================================================
+/*! Store to the constant cache.
+
+  @param  cc		pointer to the cache entry.
+  @param  vm		pointer to VM.
+  @param  cls		base class of the search.
+  @param  sym_id	constant name.
+  @param  value		found constant.
+*/
+static inline void set_const_cache( mrbc_constcache *cc, const mrbc_vm *vm, mrbc_class *cls, mrbc_sym sym_id, mrbc_value *value )
+{
+  cc->inst = vm->inst;
+  cc->cls = cls;
+  cc->value = value;
+  cc->const_epoch = mrbc_const_epoch;
+  cc->sym_id = sym_id;
+}
+#endif
+
+
+#if MRBC_IVAR_CACHE_SIZE > 0
+//================================================================
+/*! Find the instance variable cache entry of the current instruction site.
+
+  @param  vm	pointer to VM.
+  @return	pointer to the cache entry.
+*/
+static inline mrbc_ivcache * find_ivar_cache( const mrbc_vm *vm )
+{
+  return &ivar_cache[ ((uintptr_t)vm->inst >> 1) & (MRBC_IVAR_CACHE_SIZE - 1) ];
+}
+#endif
+
+
+//================================================================
+/*! Replace the frame of the resumed block or method by the frame that
+  the resume function pushed on it.
+
+  @param  vm		pointer to VM.
+  @param  callinfo	callinfo of the frame to be replaced.
+*/
+static void replace_resume_frame( mrbc_vm *vm, mrbc_callinfo *callinfo )
+{
+  mrbc_callinfo *next = vm->callinfo_tail;
+  assert( next->prev == callinfo );
+
+  // keep the caller's status, and take over the callee's.
+  callinfo->own_class = next->own_class;
+  callinfo->resume = next->resume;
+  callinfo->method_id = next->method_id;
+  callinfo->n_args = next->n_args;
+  callinfo->is_called_block = next->is_called_block;
+  callinfo->n_resume_regs = next->n_resume_regs;
+  callinfo->n_yield_args = next->n_yield_args;
+
+  // drop the pushed callinfo. (the registers are in use)
+  vm->callinfo_tail = callinfo;
+  if( --vm->callinfo_depth % MRBC_CALLINFO_CHUNK_SIZE == 0 &&
+      vm->callinfo_depth != 0 ) {
+    vm->callinfo_chunk = vm->callinfo_chunk->prev;
+  }
+}
+
+
+//================================================================
+/*! Return from the block called by mrbc_yield, and resume the C function.
+
+  @param  vm	pointer to VM.
+  @param  ret	return value of the block. (moved)
+*/
+static void return_to_resume( mrbc_vm *vm, mrbc_value ret )
+{
+  mrbc_callinfo *callinfo = vm->callinfo_tail;
+  mrbc_value *r0 = vm->cur_regs;
+
+  // clear the block frame except the block itself.
+  // (including the arguments that the block does not take)
+  int n = vm->cur_irep->nregs;
+  if( n < callinfo->n_yield_args + 2 ) n = callinfo->n_yield_args + 2;
+  for( int i = 1; i < n; i++ ) {
+    mrbc_decref_empty( r0+i );
+  }
+  if( callinfo->karg_keep ) {
+    mrbc_hash_delete(&mrbc_immediate_value(MRBC_TT_HASH, .hash = callinfo->karg_keep));
+    callinfo->karg_keep = 0;
+  }
+
+  int argc = callinfo->resume( vm, r0 - callinfo->n_resume_regs, &ret );
+  mrbc_decref( &ret );
+
+  // the resume function called the next block or method in the same
+  // registers. (see mrbc_call_method)
+  if( vm->callinfo_tail != callinfo ) {
+    replace_resume_frame( vm, callinfo );
+    return;
+  }
+
+  if( argc >= 0 && !mrbc_israised(vm) ) {
+    // call the block again in the same frame.
+    mrbc_set_nil( &r0[argc+1] );
+    callinfo->n_args = argc;
+    vm->inst = vm->cur_irep->inst;
+    return;
+  }
+
+  mrbc_pop_callinfo( vm );
+}
+
+
+#if MRBC_USE_TAIL_CALL
+//================================================================
+/*! Check if the method call at the current site can be a tail call.
+
+  @param  vm		pointer to VM.
+  @param  sym_id	method name symbol id
+  @param  a		operand a (register of the receiver and result)
+  @return		true if the current frame can be reused.
+*/
+static inline int is_tail_call( const mrbc_vm *vm, mrbc_sym sym_id, int a )
+{
+  const mrbc_callinfo *callinfo = vm->callinfo_tail;
+
+  // the next instruction (or the target of OP_JMP) returns R[a].
+#if MRBC_USE_PREDECODE
+  const mrbc_inst *next = (const mrbc_inst *)vm->inst;
+  if( next->op == OP_JMP ) next += 1 + (int16_t)next->a;
+  if( next->op != OP_RETURN || next->a != a ) return 0;
+#else
+  const uint8_t *next = vm->inst;
+  if( next[0] == OP_JMP ) next += 3 + (int16_t)(next[1] << 8 | next[2]);
+  if( next[0] != OP_RETURN || next[1] != a ) return 0;
+#endif
+
+  return callinfo &&			// not top level
+    vm->cur_irep->clen == 0 &&		// no rescue and ensure
+    vm->cur_irep->rlen == 0 &&		// no blocks capture the frame
+    !callinfo->is_called_super &&
+    !callinfo->is_called_block &&
+    !callinfo->karg_keep &&
+    callinfo->method_id != MRBC_SYM(initialize) &&	// see sub_op_return()
+    sym_id != MRBC_SYM(initialize) &&
+    sym_id != MRBC_SYM(method_missing);
+}
+#endif
+
+
 //================================================================
 /*! Method call by method name's id
 
@@ -60,6 +330,7 @@ static void send_by_name( mrbc_vm *vm, mrbc_sym sym_id, int a, int c )
   int karg = (c >> 4) & 0x0f;
   int have_block = (c >> 8);
   mrbc_value *recv = vm->cur_regs + a;
+  int recv_ofs = recv - vm->regs;
 
   // If it's packed in an array, expand it.
   if( narg == CALL_MAXARGS ) {
@@ -116,7 +387,28 @@ static void send_by_name( mrbc_vm *vm, mrbc_sym sym_id, int a, int c )
   // find a method
   mrbc_class *cls = mrbc_find_class_by_object(recv);
   mrbc_method method;
-  if( mrbc_find_method( &method, cls, sym_id ) != 0 ) goto CALL_METHOD;
+#if MRBC_INLINE_CACHE_SIZE > 0
+  mrbc_callcache *cc = find_call_cache( vm );
+  if( cc->inst == vm->inst && cc->cls == cls && cc->sym_id == sym_id &&
+      cc->method_epoch == mrbc_method_epoch ) {
+    method.c_func = cc->c_func;
+    if( cc->c_func ) method.func = cc->func; else method.irep = cc->irep;
+    method.cls = cc->own_class;
+    goto CALL_METHOD;
+  }
+#endif
+  if( mrbc_find_method( &method, cls, sym_id ) != 0 ) {
+#if MRBC_INLINE_CACHE_SIZE > 0
+    cc->inst = vm->inst;
+    cc->cls = cls;
+    cc->own_class = method.cls;
+    if( method.c_func ) cc->func = method.func; else cc->irep = method.irep;
+    cc->method_epoch = mrbc_method_epoch;
+    cc->sym_id = sym_id;
+    cc->c_func = method.c_func;
+#endif
+    goto CALL_METHOD;
+  }
 
   // method missing?
   if( mrbc_find_method( &method, cls, MRBC_SYM(method_missing) ) == 0 ) {
@@ -142,6 +434,7 @@ static void send_by_name( mrbc_vm *vm, mrbc_sym sym_id, int a, int c )
   if( !method.c_func ) goto CALL_RUBY_METHOD;
 
   vm->callee_sym_id = sym_id;
+  mrbc_callinfo *callinfo_tail = vm->callinfo_tail;
   method.func(vm, recv, narg);
 
   if( mrbc_israised(vm) && vm->exception.exception->method_id == 0 ) {
@@ -149,7 +442,10 @@ static void send_by_name( mrbc_vm *vm, mrbc_sym sym_id, int a, int c )
   }
   if( sym_id == MRBC_SYM(call) ) return;
   if( sym_id == MRBC_SYM(new) ) return;
+  if( vm->callinfo_tail != callinfo_tail ) return;	// called the block. (see mrbc_yield)
 
+  // the registers may be relocated by mrbc_yield, even if it failed.
+  recv = vm->regs + recv_ofs;
   for( int i = 1; i <= narg + !!karg + have_block; i++ ) {
     mrbc_decref_empty( recv + i );
   }
@@ -157,7 +453,37 @@ static void send_by_name( mrbc_vm *vm, mrbc_sym sym_id, int a, int c )
 
 
  CALL_RUBY_METHOD:;
+#if MRBC_USE_TAIL_CALL
+  if( is_tail_call( vm, sym_id, a ) ) {
+    // move the receiver, arguments and block to the top of current frame.
+    mrbc_value *r0 = vm->cur_regs;
+    int n_move = r1 - recv + 1;
+    int i;
+    for( i = 0; i < a; i++ ) {
+      mrbc_decref_empty( r0 + i );
+    }
+    for( i = a + n_move; i < vm->cur_irep->nregs; i++ ) {
+      mrbc_decref_empty( r0 + i );
+    }
+    memmove( r0, recv, sizeof(mrbc_value) * n_move );
+    for( i = n_move; i < a + n_move; i++ ) {
+      mrbc_set_tt( r0 + i, MRBC_TT_EMPTY );
+    }
+
+    // reuse the callinfo.
+    mrbc_callinfo *callinfo = vm->callinfo_tail;
+    callinfo->own_class = method.cls;
+    callinfo->method_id = sym_id;
+    callinfo->n_args = narg;
+
+    vm->cur_irep = method.irep;
+    vm->inst = vm->cur_irep->inst;
+    return;
+  }
+#endif
+
   mrbc_callinfo *callinfo = mrbc_push_callinfo(vm, sym_id, a, narg);
+  if( !callinfo ) return;
   callinfo->own_class = method.cls;
 
   vm->cur_irep = method.irep;
@@ -166,30 +492,47 @@ static void send_by_name( mrbc_vm *vm, mrbc_sym sym_id, int a, int c )
 }
 
 
+//================================================================
+/*! Find catch handler by binary search of the catch ranges.
+
+  @param  irep		pointer to irep. (clen != 0)
+  @param  inst		instruction address. (offset from irep->inst)
+  @param  is_ensure	find only ensure handler.
+  @return		pointer to the innermost handler or NULL.
+*/
+static const mrbc_irep_catch_handler *find_catch_handler( const mrbc_irep *irep, uint32_t inst, int is_ensure )
+{
+  const mrbc_irep_catch_range *range = mrbc_irep_catch_ranges(irep);
+
+  // find the last range that (begin < inst).
+  int left = 0;
+  int right = irep->crlen;
+  while( left < right ) {
+    int mid = (left + right) / 2;
+    if( range[mid].begin < inst ) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  if( left == 0 ) return NULL;
+
+  int idx = is_ensure ? range[left-1].ensure : range[left-1].handler;
+  if( idx < 0 ) return NULL;
+
+  return mrbc_irep_catch_handlers(irep) + idx;
+}
+
+
 //================================================================
 /*! Find ensure catch handler
 */
 static const mrbc_irep_catch_handler *find_catch_handler_ensure( const mrbc_vm *vm )
 {
   const mrbc_irep *irep = vm->cur_irep;
-  int cnt = irep->clen;
-  if( cnt == 0 ) return NULL;
-
-  const mrbc_irep_catch_handler *catch_table =
-    (const mrbc_irep_catch_handler *)(irep->inst + irep->ilen);
-  uint32_t inst = vm->inst - irep->inst;
-
-  for( cnt--; cnt >= 0 ; cnt-- ) {
-    const mrbc_irep_catch_handler *handler = catch_table + cnt;
-    // Catch type and range check
-    if( (handler->type == 1) &&		// 1=CATCH_FILTER_ENSURE
-        (bin_to_uint32(handler->begin) < inst) &&
-        (inst <= bin_to_uint32(handler->end)) ) {
-      return handler;
-    }
-  }
+  if( irep->clen == 0 ) return NULL;
 
-  return NULL;
+  return find_catch_handler( irep, vm->inst - irep->inst, 1 );
 }
 
 
@@ -201,15 +544,120 @@ static const mrbc_irep_catch_handler *find_catch_handler_ensure( const mrbc_vm *
 void mrbc_cleanup_vm(void)
 {
   memset(free_vm_bitmap, 0, sizeof(free_vm_bitmap));
+#if MRBC_INLINE_CACHE_SIZE > 0
+  memset(call_cache, 0, sizeof(call_cache));
+#endif
+#if MRBC_CONST_CACHE_SIZE > 0
+  memset(const_cache, 0, sizeof(const_cache));
+#endif
+#if MRBC_IVAR_CACHE_SIZE > 0
+  memset(ivar_cache, 0, sizeof(ivar_cache));
+#endif
+}
+
+
+//================================================================
+/*! Release all chunks of callinfo stack.
+*/
+static void free_callinfo_chunks( mrbc_vm *vm )
+{
+  mrbc_callinfo_chunk *chunk = vm->callinfo_chunk;
+  if( !chunk ) return;
+
+  while( chunk->prev ) chunk = chunk->prev;
+  while( chunk ) {
+    mrbc_callinfo_chunk *next = chunk->next;
+    mrbc_free(vm, chunk);
+    chunk = next;
+  }
+
+  vm->callinfo_chunk = NULL;
+  vm->callinfo_depth = 0;
+}
+
+
+//================================================================
+/*! Grow the register stack, and relocate the pointers to it.
+
+  @param  vm	pointer to VM.
+  @param  size	required size.
+  @return	zero if no error, or raise SystemStackError or NoMemoryError.
+  @note	  vm->cur_regs and the callinfo stack are updated.
+	  The other pointers to the registers become invalid.
+*/
+static int grow_regs( mrbc_vm *vm, int size )
+{
+  if( size > vm->regs_max_size ) {
+    mrbc_raise( vm, MRBC_CLASS(SystemStackError), "MAX_REGS_SIZE overflow");
+    return -1;
+  }
+  if( vm->regs_size == vm->regs_max_size ) return 0;
+
+  // double the size, as far as the maximum.
+  int new_size = vm->regs_size * 2;
+  if( new_size < size + REGS_MARGIN ) new_size = size + REGS_MARGIN;
+  if( new_size > vm->regs_max_size ) new_size = vm->regs_max_size;
+
+  mrbc_value *regs = mrbc_raw_alloc( sizeof(mrbc_value) * new_size );
+  if( !regs ) {
+    mrbc_raise( vm, MRBC_CLASS(NoMemoryError), 0 );
+    return -1;
+  }
+  memcpy( regs, vm->regs, sizeof(mrbc_value) * vm->regs_size );
+  for( int i = vm->regs_size; i < new_size; i++ ) {
+    mrbc_set_nil( &regs[i] );
+  }
+
+  vm->cur_regs = regs + (vm->cur_regs - vm->regs);
+  for( mrbc_callinfo *ci = vm->callinfo_tail; ci; ci = ci->prev ) {
+    ci->cur_regs = regs + (ci->cur_regs - vm->regs);
+  }
+
+  mrbc_raw_free( vm->regs );
+  vm->regs = regs;
+  vm->regs_size = new_size;
+
+  return 0;
 }
 
 
 //================================================================
 /*! Push current status to callinfo stack
+
+  @return	Pointer to callinfo, or NULL if SystemStackError or
+		NoMemoryError is raised.
+  @note		Callinfo is taken from chunks that are kept in VM,
+		so it is not allocated for each call.
 */
 mrbc_callinfo * mrbc_push_callinfo( mrbc_vm *vm, mrbc_sym method_id, int reg_offset, int n_args )
 {
-  mrbc_callinfo *callinfo = mrbc_alloc(vm, sizeof(mrbc_callinfo));
+  if( vm->callinfo_depth >= MAX_CALLINFO_DEPTH ) {
+    mrbc_raise( vm, MRBC_CLASS(SystemStackError), "stack level too deep");
+    return NULL;
+  }
+
+  // go to the next chunk, if the current chunk is full.
+  int idx = vm->callinfo_depth % MRBC_CALLINFO_CHUNK_SIZE;
+  mrbc_callinfo_chunk *chunk = vm->callinfo_chunk;
+  if( !chunk || (idx == 0 && vm->callinfo_depth != 0) ) {
+    mrbc_callinfo_chunk *next = chunk ? chunk->next : NULL;
+    if( !next ) {
+      next = mrbc_alloc(vm, sizeof(mrbc_callinfo_chunk));
+      if( !next ) {
+        mrbc_raise( vm, MRBC_CLASS(NoMemoryError), 0 );
+        return NULL;
+      }
+      next->prev = chunk;
+      next->next = NULL;
+      if( chunk ) chunk->next = next;
+    }
+    vm->callinfo_chunk = chunk = next;
+  }
+
+  mrbc_callinfo *callinfo = &chunk->callinfo[idx];
+  if( ++vm->callinfo_depth > vm->callinfo_max_depth ) {
+    vm->callinfo_max_depth = vm->callinfo_depth;
+  }
 
   *callinfo = (mrbc_callinfo){
 #if defined(MRBC_DEBUG)
@@ -222,11 +670,14 @@ mrbc_callinfo * mrbc_push_callinfo( mrbc_vm *vm, mrbc_sym method_id, int reg_off
     .prev = vm->callinfo_tail,
     .own_class = 0,
     .karg_keep = 0,
+    .resume = 0,
     .method_id = method_id,
     .reg_offset = reg_offset,
     .n_args = n_args,
     .is_called_super = 0,
     .is_called_block = 0,
+    .n_resume_regs = 0,
+    .n_yield_args = 0,
   };
 
   vm->callinfo_tail = callinfo;
@@ -246,7 +697,13 @@ void mrbc_pop_callinfo( mrbc_vm *vm )
   mrbc_callinfo *callinfo = vm->callinfo_tail;
   mrbc_value *r0 = vm->cur_regs;
 
-  for( int i = 1; i < vm->cur_irep->nregs; i++ ) {
+  // (the registers may not be allocated yet, when it overflows.)
+  int n = vm->cur_irep->nregs;
+  if( callinfo->resume && n < callinfo->n_yield_args + 2 ) {
+    n = callinfo->n_yield_args + 2;
+  }
+  if( n > vm->regs + vm->regs_size - r0 ) n = vm->regs + vm->regs_size - r0;
+  for( int i = 1; i < n; i++ ) {
     mrbc_decref_empty( r0+i );
   }
 
@@ -254,6 +711,13 @@ void mrbc_pop_callinfo( mrbc_vm *vm )
     mrbc_hash_delete(&mrbc_immediate_value(MRBC_TT_HASH, .hash = callinfo->karg_keep));
   }
 
+  // clear the registers of C function, and the block. (see mrbc_yield)
+  if( callinfo->resume ) {
+    for( int i = callinfo->n_resume_regs; i > 0; i-- ) {
+      mrbc_decref_empty( r0 - i + 1 );
+    }
+  }
+
   // copy callinfo to vm
   vm->cur_irep = callinfo->cur_irep;
   vm->inst = callinfo->inst;
@@ -261,14 +725,189 @@ void mrbc_pop_callinfo( mrbc_vm *vm )
   vm->target_class = callinfo->target_class;
   vm->callinfo_tail = callinfo->prev;
 
-  mrbc_free(vm, callinfo);
+  // back to the previous chunk, if the current chunk becomes empty.
+  if( --vm->callinfo_depth % MRBC_CALLINFO_CHUNK_SIZE == 0 &&
+      vm->callinfo_depth != 0 ) {
+    vm->callinfo_chunk = vm->callinfo_chunk->prev;
+  }
+}
+
+
+//================================================================
+/*! Push the frame to call a block or a method from C function.
+
+  The frame is made at v[n_regs] except for the register 0, that is
+  set by the caller.
+
+  @param  vm	pointer to VM.
+  @param  v	pointer to registers of the C function. (updated if relocated)
+  @param  n_regs num of registers used by the C function.
+  @param  method_id method name symbol id.
+  @param  argc	num of arguments.
+  @param  args	arguments. (moved to the frame)
+  @param  resume the C function to resume.
+  @return	pointer to callinfo, or NULL if error.
+*/
+static mrbc_callinfo * push_resume_frame( mrbc_vm *vm, mrbc_value **v, int n_regs, mrbc_sym method_id, int argc, mrbc_value *args, mrbc_resume_func resume )
+{
+  int ofs = *v - vm->regs;
+
+  // grow the register stack if needed.
+  if( ofs + n_regs + argc + 2 + REGS_MARGIN >= vm->regs_size ) {
+    if( grow_regs( vm, ofs + n_regs + argc + 2 ) != 0 ) goto ERROR;
+    *v = vm->regs + ofs;
+  }
+
+  mrbc_callinfo *callinfo = mrbc_push_callinfo(vm, method_id,
+                                *v + n_regs - vm->cur_regs, argc);
+  if( !callinfo ) goto ERROR;
+
+  callinfo->resume = resume;
+  callinfo->n_resume_regs = n_regs;
+  callinfo->n_yield_args = argc;
+
+  // make the frame.
+  mrbc_value *regs = *v + n_regs;
+  for( int i = 0; i <= argc + 1; i++ ) {
+    mrbc_decref( &regs[i] );
+  }
+  memcpy( &regs[1], args, sizeof(mrbc_value) * argc );
+  mrbc_set_nil( &regs[argc+1] );
+  vm->cur_regs = regs;
+
+  return callinfo;
+
+ ERROR:
+  for( int i = 0; i < argc; i++ ) {
+    mrbc_decref( &args[i] );
+  }
+  return NULL;
+}
+
+
+//================================================================
+/*! Call the block from C function (method).
+
+  The block frame is pushed at v[n_regs], and the block runs after the
+  C function returns to VM. Each time the block returns, the function
+  'resume' is called with the return value. It sets the arguments at
+  v[n_regs+1].. (up to argc) to call the block again, or sets the return
+  value of the method to v[0] to finish.
+  The working registers of the C function (v[argc+2]..v[n_regs-1]) keep
+  the state of iteration, and they are cleared when the block frame is
+  popped, even by break or exception.
+
+<b>Code example</b>
+@code
+  static int c_each_resume(mrbc_vm *vm, mrbc_value v[], mrbc_value *ret)
+  {
+    int i = mrbc_integer(v[2]) + 1;	// v[2]: working register.
+    if( i >= mrbc_array_size(&v[0]) ) return -1;	// finish, and returns self.
+
+    mrbc_set_integer( &v[2], i );
+    v[4] = mrbc_array_get( &v[0], i );	// v[4]: 1st argument of the block.
+    mrbc_incref( &v[4] );
+    return 1;
+  }
+
+  static void c_each(mrbc_vm *vm, mrbc_value v[], int argc)
+  {
+    if( mrbc_array_size(&v[0]) == 0 ) return;
+    mrbc_value arg = mrbc_array_get( &v[0], 0 );
+    mrbc_incref( &arg );
+    v = mrbc_yield( vm, v, 3, &v[1], 1, &arg, c_each_resume );
+    if( !v ) return;
+    mrbc_decref( &v[2] );
+    mrbc_set_integer( &v[2], 0 );
+  }
+@endcode
+
+  @param  vm	pointer to VM.
+  @param  v	registers of the C function. (v[0] = self)
+  @param  n_regs num of registers used by the C function.
+  @param  blk	the block (Proc) to call.
+  @param  argc	num of arguments of the block.
+  @param  args	arguments of the block. (moved to the block frame)
+  @param  resume the C function to resume.
+  @return	registers of the C function, or NULL if error.
+  @note	  The registers may be relocated. Use the returned pointer instead
+	  of v, and set the working registers after calling this function.
+*/
+mrbc_value * mrbc_yield( mrbc_vm *vm, mrbc_value v[], int n_regs, const mrbc_value *blk, int argc, mrbc_value *args, mrbc_resume_func resume )
+{
+  mrbc_proc *proc = blk->proc;
+  mrbc_callinfo *callinfo_self = proc->callinfo_self;
+  mrbc_callinfo *callinfo = push_resume_frame( vm, &v, n_regs,
+                                (callinfo_self ? callinfo_self->method_id : 0),
+                                argc, args, resume );
+  if( !callinfo ) return NULL;
+
+  if( callinfo_self ) {
+    callinfo->own_class = callinfo_self->own_class;
+  }
+  callinfo->is_called_block = 1;
+
+  // make the block frame.
+  mrbc_value *regs = v + n_regs;
+  regs[0] = mrbc_immediate_value(MRBC_TT_PROC, .proc = proc);
+  mrbc_incref( &regs[0] );
+
+  vm->cur_irep = proc->irep;
+  vm->inst = vm->cur_irep->inst;
+
+  return v;
+}
+
+
+//================================================================
+/*! Call the method written in Ruby from C function.
+
+  The same as mrbc_yield, but the method frame is pushed at v[n_regs]
+  instead of the block frame. The function 'resume' is called with
+  the return value of the method.
+  Also, the resume function can call mrbc_yield or mrbc_call_method
+  with the same n_regs, to call the next block or method instead.
+  The frame is replaced, and the returned value of 'resume' is ignored.
+
+  @param  vm	pointer to VM.
+  @param  v	registers of the C function. (v[0] = self)
+  @param  n_regs num of registers used by the C function.
+  @param  recv	receiver of the method. (moved to the method frame)
+  @param  method the method to call. (must be written in Ruby)
+  @param  argc	num of arguments of the method.
+  @param  args	arguments of the method. (moved to the method frame)
+  @param  resume the C function to resume.
+  @return	registers of the C function, or NULL if error.
+  @note	  The registers may be relocated. Use the returned pointer instead
+	  of v, and set the working registers after calling this function.
+*/
+mrbc_value * mrbc_call_method( mrbc_vm *vm, mrbc_value v[], int n_regs, mrbc_value *recv, const mrbc_method *method, int argc, mrbc_value *args, mrbc_resume_func resume )
+{
+  assert( !method->c_func );
+  mrbc_value self = *recv;	// (recv may be in the registers to be relocated)
+
+  mrbc_callinfo *callinfo = push_resume_frame( vm, &v, n_regs,
+                                method->sym_id, argc, args, resume );
+  if( !callinfo ) {
+    mrbc_decref( &self );
+    return NULL;
+  }
+  callinfo->own_class = method->cls;
+
+  // make the method frame.
+  v[n_regs] = self;
+
+  vm->cur_irep = method->irep;
+  vm->inst = vm->cur_irep->inst;
+
+  return v;
 }
 
 
 //================================================================
 /*! Create (allocate) VM structure.
 
-  @param  regs_size	num of registor.
+  @param  regs_size	maximum num of registers.
   @return		Pointer to mrbc_vm.
   @retval NULL		error.
 
@@ -286,15 +925,14 @@ void mrbc_pop_callinfo( mrbc_vm *vm )
 */
 mrbc_vm * mrbc_vm_new( int regs_size )
 {
-  unsigned int vm_total_size = sizeof(mrbc_vm) + sizeof(mrbc_value) * regs_size;
-  mrbc_vm *vm = mrbc_raw_alloc(vm_total_size);
+  mrbc_vm *vm = mrbc_raw_alloc(sizeof(mrbc_vm));
 
-  memset(vm, 0, vm_total_size);	// caution: assume NULL is zero.
+  memset(vm, 0, sizeof(mrbc_vm));	// caution: assume NULL is zero.
 #if defined(MRBC_DEBUG)
   memcpy(vm->obj_mark_, "VM", 2);
 #endif
   vm->flag_need_memfree = 1;
-  vm->regs_size = regs_size;
+  vm->regs_max_size = regs_size;
 
   return vm;
 }
@@ -336,18 +974,43 @@ mrbc_vm * mrbc_vm_open( mrbc_vm *vm )
 /*! VM initializer.
 
   @param  vm  Pointer to VM
+  @return	zero if no error, or raise NoMemoryError or SystemStackError.
 */
-void mrbc_vm_begin( mrbc_vm *vm )
+int mrbc_vm_begin( mrbc_vm *vm )
 {
+  vm->exception = mrbc_nil_value();
+
+  // allocate the register stack.
+  if( !vm->regs ) {
+    int regs_size = MRBC_REGS_INIT_SIZE;
+    if( regs_size > vm->regs_max_size ) regs_size = vm->regs_max_size;
+    vm->regs = mrbc_raw_alloc( sizeof(mrbc_value) * regs_size );
+    if( !vm->regs ) {
+      mrbc_raise( vm, MRBC_CLASS(NoMemoryError), 0 );
+      return -1;
+    }
+    vm->regs_size = regs_size;
+    for( int i = 0; i < vm->regs_size; i++ ) {
+      mrbc_set_nil( &vm->regs[i] );
+    }
+  }
+
   vm->cur_irep = vm->top_irep;
   vm->inst = vm->cur_irep->inst;
   vm->cur_regs = vm->regs;
   vm->target_class = MRBC_CLASS(Object);
   vm->callinfo_tail = NULL;
+  vm->callinfo_depth = 0;
+  while( vm->callinfo_chunk && vm->callinfo_chunk->prev ) {
+    vm->callinfo_chunk = vm->callinfo_chunk->prev;
+  }
+  vm->callinfo_max_depth = 0;
   vm->ret_blk = NULL;
-  vm->exception = mrbc_nil_value();
   vm->flag_preemption = 0;
   vm->flag_stop = 0;
+#if defined(MRBC_COUNT_INSTRUCTIONS)
+  vm->inst_count = 0;
+#endif
 
   // set self to reg[0], others nil
   mrbc_decref( &vm->regs[0] );
@@ -355,6 +1018,12 @@ void mrbc_vm_begin( mrbc_vm *vm )
   for( int i = 1; i < vm->regs_size; i++ ) {
     mrbc_set_nil( &vm->regs[i] );
   }
+
+  if( vm->cur_irep->nregs + REGS_MARGIN >= vm->regs_size ) {
+    if( grow_regs( vm, vm->cur_irep->nregs + 1 ) != 0 ) return -1;
+  }
+
+  return 0;
 }
 
 
@@ -373,6 +1042,7 @@ void mrbc_vm_end( mrbc_vm *vm )
     mrbc_decref(&vm->exception);
 #endif
   }
+  mrbc_flush();
   assert( vm->ret_blk == 0 );
 
   int n_used = 0;
@@ -385,7 +1055,11 @@ void mrbc_vm_end( mrbc_vm *vm )
 #if defined(MRBC_DEBUG_REGS)
   mrbc_printf("Finally number of registers used was %d in VM %d.\n",
               n_used, vm->vm_id );
+  mrbc_printf("Maximum depth of callinfo was %d in VM %d.\n",
+              vm->callinfo_max_depth, vm->vm_id );
 #endif
+
+  free_callinfo_chunks( vm );
 }
 
 
@@ -396,7 +1070,12 @@ void mrbc_vm_end( mrbc_vm *vm )
 */
 void mrbc_vm_close( mrbc_vm *vm )
 {
-  mrbc_decref( &vm->regs[0] );
+  if( vm->regs ) {
+    mrbc_decref( &vm->regs[0] );
+    mrbc_raw_free( vm->regs );
+    vm->regs = NULL;
+  }
+  free_callinfo_chunks( vm );
 
   // free vm id.
   if( vm->vm_id != 0 ) {
@@ -414,15 +1093,81 @@ void mrbc_vm_close( mrbc_vm *vm )
 /***** opecode functions ****************************************************/
 #if defined(MRBC_SUPPORT_OP_EXT)
 #define EXT , int ext
+#define EXT_ARG , 0	// to call other opcode function without OP_EXTn.
 #else
 #define EXT
+#define EXT_ARG
 #endif
+
+// operand size, jump offset and symbol operand in the instruction stream.
+#if MRBC_USE_PREDECODE
+#define OPERAND_SIZE(n)	((int)sizeof(mrbc_inst) - 1)
+#define JUMP_OFFSET(n)	((int16_t)(n) * (int)sizeof(mrbc_inst))
+#define SYMBOL_ID(n)	((mrbc_sym)(n))
+#else
+#define OPERAND_SIZE(n)	(n)
+#define JUMP_OFFSET(n)	((int16_t)(n))
+#define SYMBOL_ID(n)	mrbc_irep_symbol_id(vm->cur_irep, (n))
+#endif
+
+#if MRBC_USE_QUICKENING
 //================================================================
-/*! OP_NOP
+/*! Rewrite the executing instruction to the quickened one.
 
-  No operation
+  @param  vm		pointer to VM.
+  @param  operand_size	size of operands.
+  @param  op_generic	opcode of the generic instruction.
+  @param  op_quick	opcode of the quickened instruction.
+  @note	  The fused instruction is not rewritten.
 */
-static inline void op_nop( mrbc_vm *vm, mrbc_value *regs EXT )
+static inline void quicken( mrbc_vm *vm, int operand_size, int op_generic, int op_quick )
+{
+  uint8_t *opcode = (uint8_t *)vm->inst - OPERAND_SIZE(operand_size) - 1;
+  if( *opcode == op_generic ) *opcode = op_quick;
+}
+
+
+//================================================================
+/*! Revert the quickened instruction, and rewind to execute it again.
+
+  @param  vm		pointer to VM.
+  @param  operand_size	size of operands.
+  @param  op_generic	opcode of the generic instruction.
+*/
+static inline void dequicken( mrbc_vm *vm, int operand_size, int op_generic )
+{
+  vm->inst -= OPERAND_SIZE(operand_size);
+  *(uint8_t *)(vm->inst - 1) = op_generic;
+}
+
+#if defined(MRBC_SUPPORT_OP_EXT)
+#define QUICKEN(size, op_generic, op_quick) \
+  if( !ext ) quicken( vm, (size), (op_generic), (op_quick) )
+#else
+#define QUICKEN(size, op_generic, op_quick) \
+  quicken( vm, (size), (op_generic), (op_quick) )
+#endif
+
+// quicken the comparison if both operands are Integer or Float.
+#define QUICKEN_COMPARE(op_generic, op_ii, op_ff) \
+  if( mrbc_type(regs[a]) == MRBC_TT_INTEGER && \
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) { \
+    QUICKEN( 1, (op_generic), (op_ii) ); \
+  } else if( mrbc_type(regs[a]) == MRBC_TT_FLOAT && \
+             mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) { \
+    QUICKEN( 1, (op_generic), (op_ff) ); \
+  }
+#else
+#define QUICKEN(size, op_generic, op_quick) ((void)0)
+#define QUICKEN_COMPARE(op_generic, op_ii, op_ff) ((void)0)
+#endif
+
+//================================================================
+/*! OP_NOP
+
+  No operation
+*/
+static inline void op_nop( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_Z();
 }
@@ -453,6 +1198,11 @@ static inline void op_loadl( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   mrbc_decref(&regs[a]);
+#if MRBC_USE_PREDECODE
+  // numeric literals are resolved by the loader.
+  regs[a] = mrbc_irep_pool_values(vm->cur_irep)[b];
+  if( mrbc_type(regs[a]) != MRBC_TT_EMPTY ) return;
+#endif
   regs[a] = mrbc_irep_pool_value(vm, b);
 }
 
@@ -542,7 +1292,7 @@ static inline void op_loadsym( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   mrbc_decref(&regs[a]);
-  mrbc_set_symbol(&regs[a], mrbc_irep_symbol_id(vm->cur_irep, b));
+  mrbc_set_symbol(&regs[a], SYMBOL_ID(b));
 }
 
 
@@ -613,7 +1363,7 @@ static inline void op_getgv( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   mrbc_decref(&regs[a]);
-  mrbc_value *v = mrbc_get_global( mrbc_irep_symbol_id(vm->cur_irep, b) );
+  mrbc_value *v = mrbc_get_global( SYMBOL_ID(b) );
   if( v == NULL ) {
     mrbc_set_nil(&regs[a]);
   } else {
@@ -633,7 +1383,7 @@ static inline void op_setgv( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   mrbc_incref(&regs[a]);
-  mrbc_set_global( mrbc_irep_symbol_id(vm->cur_irep, b), &regs[a] );
+  mrbc_set_global( SYMBOL_ID(b), &regs[a] );
 }
 
 
@@ -646,16 +1396,43 @@ static inline void op_getiv( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  const char *sym_name = mrbc_irep_symbol_cstr(vm->cur_irep, b);
+  mrbc_value *self = mrbc_get_self( vm, regs );
+
+#if MRBC_IVAR_CACHE_SIZE > 0
+  mrbc_sym at_sym_id = SYMBOL_ID(b);
+  mrbc_ivcache *ic = find_ivar_cache( vm );
+  if( mrbc_type(*self) == MRBC_TT_OBJECT &&
+      ic->shape == self->instance->shape && ic->sym_id == at_sym_id &&
+      ic->next_shape == ic->shape && ic->shape != &mrbc_kv_shape ) {
+    mrbc_decref(&regs[a]);
+    if( ic->index < 0 ) {
+      mrbc_set_nil(&regs[a]);
+    } else {
+      regs[a] = self->instance->ivar[ic->index];
+      mrbc_incref(&regs[a]);
+    }
+    return;
+  }
+#endif
+
+  const char *sym_name = mrbc_symid_to_str(SYMBOL_ID(b));
   mrbc_sym sym_id = mrbc_str_to_symid(sym_name+1);   // skip '@'
   if( sym_id < 0 ) {
     mrbc_raise(vm, MRBC_CLASS(Exception), "Overflow MAX_SYMBOLS_COUNT");
     return;
   }
 
-  mrbc_value *self = mrbc_get_self( vm, regs );
   mrbc_decref(&regs[a]);
   regs[a] = mrbc_instance_getiv(self, sym_id);
+
+#if MRBC_IVAR_CACHE_SIZE > 0
+  if( mrbc_type(*self) == MRBC_TT_OBJECT &&
+      self->instance->shape != &mrbc_kv_shape ) {
+    ic->shape = ic->next_shape = self->instance->shape;
+    ic->sym_id = at_sym_id;
+    ic->index = mrbc_shape_index( ic->shape, sym_id );
+  }
+#endif
 }
 
 
@@ -668,17 +1445,52 @@ static inline void op_setiv( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  const char *sym_name = mrbc_irep_symbol_cstr(vm->cur_irep, b);
+  mrbc_value *self = mrbc_get_self( vm, regs );
+
+#if MRBC_IVAR_CACHE_SIZE > 0
+  mrbc_sym at_sym_id = SYMBOL_ID(b);
+  mrbc_ivcache *ic = find_ivar_cache( vm );
+  mrbc_shape *shape = 0;
+  if( mrbc_type(*self) == MRBC_TT_OBJECT ) {
+    mrbc_instance *instance = self->instance;
+    shape = instance->shape;
+
+    if( ic->shape == shape && ic->sym_id == at_sym_id && ic->index >= 0 ) {
+      mrbc_incref(&regs[a]);
+      if( ic->next_shape == shape ) {
+        mrbc_decref(&instance->ivar[ic->index]);
+      } else if( mrbc_instance_set_shape( instance, ic->next_shape ) != 0 ) {
+        mrbc_decref(&regs[a]);
+        return;
+      }
+      instance->ivar[ic->index] = regs[a];
+      return;
+    }
+  }
+#endif
+
+  const char *sym_name = mrbc_symid_to_str(SYMBOL_ID(b));
   mrbc_sym sym_id = mrbc_str_to_symid(sym_name+1);   // skip '@'
   if( sym_id < 0 ) {
     mrbc_raise(vm, MRBC_CLASS(Exception), "Overflow MAX_SYMBOLS_COUNT");
     return;
   }
 
-  mrbc_value *self = mrbc_get_self( vm, regs );
   if( mrbc_instance_setiv(self, sym_id, &regs[a]) == E_NOTIMP_ERROR ) {
     mrbc_raise(vm, MRBC_CLASS(NotImplementedError), 0);
   }
+
+#if MRBC_IVAR_CACHE_SIZE > 0
+  // (the instances that have run out of shapes are not cached)
+  if( shape && shape != &mrbc_kv_shape &&
+      self->instance->shape != &mrbc_kv_shape ) {
+    // remember also the transition, when the variable was added.
+    ic->shape = shape;
+    ic->next_shape = self->instance->shape;
+    ic->sym_id = at_sym_id;
+    ic->index = mrbc_shape_index( ic->next_shape, sym_id );
+  }
+#endif
 }
 
 
@@ -691,7 +1503,7 @@ static inline void op_getconst( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  mrbc_sym sym_id = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id = SYMBOL_ID(b);
   mrbc_class *crit_cls;
   mrbc_value *ret;
 
@@ -701,6 +1513,12 @@ static inline void op_getconst( mrbc_vm *vm, mrbc_value *regs EXT )
   } else {
     crit_cls = mrbc_find_class_by_object( mrbc_get_self(vm, regs) );
   }
+
+#if MRBC_CONST_CACHE_SIZE > 0
+  mrbc_constcache *cc = find_const_cache( vm );
+  ret = get_const_cache( cc, vm, crit_cls, sym_id );
+  if( ret ) goto CACHED;
+#endif
   if( crit_cls == MRBC_CLASS(Object) ) goto GET_TOP_LEVEL;
 
   // search in my class, then search nested outer class.
@@ -736,6 +1554,10 @@ static inline void op_getconst( mrbc_vm *vm, mrbc_value *regs EXT )
   }
 
  DONE:
+#if MRBC_CONST_CACHE_SIZE > 0
+  set_const_cache( cc, vm, crit_cls, sym_id, ret );
+ CACHED:
+#endif
   mrbc_incref(ret);
   mrbc_decref(&regs[a]);
   regs[a] = *ret;
@@ -751,7 +1573,7 @@ static inline void op_setconst( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  mrbc_sym sym_id = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id = SYMBOL_ID(b);
 
   mrbc_incref(&regs[a]);
   if( IS_CLASS_OR_MODULE(regs[0]) ) {
@@ -771,10 +1593,16 @@ static inline void op_getmcnst( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  mrbc_sym sym_id = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id = SYMBOL_ID(b);
   mrbc_class *cls = regs[a].cls;
   mrbc_value *ret;
 
+#if MRBC_CONST_CACHE_SIZE > 0
+  mrbc_constcache *cc = find_const_cache( vm );
+  ret = get_const_cache( cc, vm, cls, sym_id );
+  if( ret ) goto CACHED;
+#endif
+
   // ::CONST case
   if( cls->sym_id == MRBC_SYM(Object) ) {
     ret = mrbc_get_const(sym_id);
@@ -800,6 +1628,10 @@ static inline void op_getmcnst( mrbc_vm *vm, mrbc_value *regs EXT )
   }
 
  DONE:
+#if MRBC_CONST_CACHE_SIZE > 0
+  set_const_cache( cc, vm, regs[a].cls, sym_id, ret );
+ CACHED:
+#endif
   mrbc_incref(ret);
   mrbc_decref(&regs[a]);
   regs[a] = *ret;
@@ -929,7 +1761,7 @@ static inline void op_jmp( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_S();
 
-  vm->inst += (int16_t)a;
+  vm->inst += JUMP_OFFSET(a);
 }
 
 
@@ -943,7 +1775,7 @@ static inline void op_jmpif( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BS();
 
   if( mrbc_type(regs[a]) > MRBC_TT_FALSE ) {
-    vm->inst += (int16_t)b;
+    vm->inst += JUMP_OFFSET(b);
   }
 }
 
@@ -958,7 +1790,7 @@ static inline void op_jmpnot( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BS();
 
   if( mrbc_type(regs[a]) <= MRBC_TT_FALSE ) {
-    vm->inst += (int16_t)b;
+    vm->inst += JUMP_OFFSET(b);
   }
 }
 
@@ -973,7 +1805,7 @@ static inline void op_jmpnil( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BS();
 
   if( mrbc_type(regs[a]) == MRBC_TT_NIL ) {
-    vm->inst += (int16_t)b;
+    vm->inst += JUMP_OFFSET(b);
   }
 }
 
@@ -987,7 +1819,7 @@ static inline void op_jmpuw( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_S();
 
-  const uint8_t *jump_inst = vm->inst + (int16_t)a;
+  const uint8_t *jump_inst = vm->inst + JUMP_OFFSET(a);
 
   // check catch handler (ensure)
   const mrbc_irep_catch_handler *handler = find_catch_handler_ensure(vm);
@@ -998,8 +1830,8 @@ static inline void op_jmpuw( mrbc_vm *vm, mrbc_value *regs EXT )
 
   // check whether the jump point is inside or outside the catch handler.
   uint32_t jump_point = jump_inst - vm->cur_irep->inst;
-  if( (bin_to_uint32(handler->begin) < jump_point) &&
-      (jump_point <= bin_to_uint32(handler->end)) ) {
+  if( (handler->begin < jump_point) &&
+      (jump_point <= handler->end) ) {
     vm->inst = jump_inst;
     return;
   }
@@ -1008,7 +1840,7 @@ static inline void op_jmpuw( mrbc_vm *vm, mrbc_value *regs EXT )
   assert( mrbc_type(vm->exception) == MRBC_TT_NIL );
   vm->exception.tt = MRBC_TT_JMPUW;
   vm->exception.handle = (void*)jump_inst;
-  vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+  vm->inst = vm->cur_irep->inst + handler->target;
 }
 
 
@@ -1077,7 +1909,15 @@ CASE_OP_RETURN:
   const mrbc_irep_catch_handler *handler = find_catch_handler_ensure(vm);
   if( handler ) {
     vm->exception = ra;
-    vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+    vm->inst = vm->cur_irep->inst + handler->target;
+    return;
+  }
+
+  // return to the C function that called the block.
+  if( vm->callinfo_tail->resume ) {
+    mrbc_value ret = regs[ vm->cur_irep->nregs ];
+    mrbc_set_tt( &regs[ vm->cur_irep->nregs ], MRBC_TT_EMPTY );
+    return_to_resume( vm, ret );
     return;
   }
 
@@ -1101,7 +1941,7 @@ CASE_OP_RETURN_BLK:
     const mrbc_irep_catch_handler *handler = find_catch_handler_ensure(vm);
     if( handler ) {
       vm->exception = ra;
-      vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+      vm->inst = vm->cur_irep->inst + handler->target;
       return;
     }
 
@@ -1145,11 +1985,12 @@ CASE_OP_BREAK:
     const mrbc_irep_catch_handler *handler = find_catch_handler_ensure(vm);
     if( handler ) {
       vm->exception = ra;
-      vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+      vm->inst = vm->cur_irep->inst + handler->target;
       return;
     }
 
-    reg_offset = vm->callinfo_tail->reg_offset;
+    // (the block called by mrbc_yield returns to the C function's register)
+    reg_offset = vm->callinfo_tail->reg_offset - vm->callinfo_tail->n_resume_regs;
     mrbc_pop_callinfo(vm);
   }
 
@@ -1175,8 +2016,8 @@ CASE_OP_JMPUW:
 
   // check whether the jump point is inside or outside the catch handler.
   uint32_t jump_point = (uint8_t *)ra.handle - vm->cur_irep->inst;
-  if( (bin_to_uint32(handler->begin) < jump_point) &&
-      (jump_point <= bin_to_uint32(handler->end)) ) {
+  if( (handler->begin < jump_point) &&
+      (jump_point <= handler->end) ) {
     vm->inst = ra.handle;
     return;
   }
@@ -1184,7 +2025,7 @@ CASE_OP_JMPUW:
   // jump point is outside, thus jump to ensure.
   assert( mrbc_type(vm->exception) == MRBC_TT_NIL );
   vm->exception = ra;
-  vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+  vm->inst = vm->cur_irep->inst + handler->target;
   return;
  }
 
@@ -1226,7 +2067,7 @@ static inline void op_ssend( mrbc_vm *vm, mrbc_value *regs EXT )
   regs[a] = *mrbc_get_self( vm, regs );
   mrbc_incref( &regs[a] );
 
-  send_by_name( vm, mrbc_irep_symbol_id(vm->cur_irep, b), a, c );
+  send_by_name( vm, SYMBOL_ID(b), a, c );
 }
 
 
@@ -1244,7 +2085,7 @@ static inline void op_ssend0( mrbc_vm *vm, mrbc_value *regs EXT )
   regs[a] = *mrbc_get_self( vm, regs );
   mrbc_incref( &regs[a] );
 
-  send_by_name( vm, mrbc_irep_symbol_id(vm->cur_irep, b), a, 0 );
+  send_by_name( vm, SYMBOL_ID(b), a, 0 );
 }
 
 
@@ -1262,7 +2103,7 @@ static inline void op_ssendb( mrbc_vm *vm, mrbc_value *regs EXT )
   regs[a] = *mrbc_get_self( vm, regs );
   mrbc_incref( &regs[a] );
 
-  send_by_name( vm, mrbc_irep_symbol_id(vm->cur_irep, b), a, c | 0x100 );
+  send_by_name( vm, SYMBOL_ID(b), a, c | 0x100 );
 }
 
 
@@ -1276,7 +2117,7 @@ static inline void op_send( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BBB();
 
-  send_by_name( vm, mrbc_irep_symbol_id(vm->cur_irep, b), a, c );
+  send_by_name( vm, SYMBOL_ID(b), a, c );
 }
 
 
@@ -1289,7 +2130,7 @@ static inline void op_send0( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  send_by_name( vm, mrbc_irep_symbol_id(vm->cur_irep, b), a, 0 );
+  send_by_name( vm, SYMBOL_ID(b), a, 0 );
 }
 
 
@@ -1302,7 +2143,7 @@ static inline void op_sendb( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BBB();
 
-  send_by_name( vm, mrbc_irep_symbol_id(vm->cur_irep, b), a, c | 0x100 );
+  send_by_name( vm, SYMBOL_ID(b), a, c | 0x100 );
 }
 
 
@@ -1396,6 +2237,7 @@ static inline void op_super( mrbc_vm *vm, mrbc_value *regs EXT )
   // call C function and return.
   if( method.c_func ) {
     method.func(vm, recv, narg - !!karg);
+    if( vm->callinfo_tail != callinfo ) return;	// called the block. (see mrbc_yield)
     for( int i = 1; i <= narg+1; i++ ) {
       mrbc_decref_empty( recv + i );
     }
@@ -1404,6 +2246,7 @@ static inline void op_super( mrbc_vm *vm, mrbc_value *regs EXT )
 
   // call Ruby method.
   callinfo = mrbc_push_callinfo(vm, callinfo->method_id, a, narg);
+  if( !callinfo ) return;
   callinfo->own_class = method.cls;
   callinfo->is_called_super = 1;
 
@@ -1512,11 +2355,11 @@ static inline void op_enter( mrbc_vm *vm, mrbc_value *regs EXT )
 
   FETCH_W();
 
-  // Check the number of registers to use.
+  // Check the number of registers to use, and grow if needed.
   int reg_use_max = regs - vm->regs + vm->cur_irep->nregs;
-  if( reg_use_max >= vm->regs_size ) {
-    mrbc_raise( vm, MRBC_CLASS(Exception), "MAX_REGS_SIZE overflow");
-    return;
+  if( reg_use_max + REGS_MARGIN >= vm->regs_size ) {
+    if( grow_regs( vm, reg_use_max + 1 ) != 0 ) return;
+    regs = vm->cur_regs;
   }
 
   // Check m2 parameter.
@@ -1630,7 +2473,7 @@ static inline void op_enter( mrbc_vm *vm, mrbc_value *regs EXT )
         return;
       }
     }
-    vm->inst += jmp_ofs * 3;	// 3 = bytecode size of OP_JMP
+    vm->inst += jmp_ofs * (1 + OPERAND_SIZE(2));	// size of OP_JMP
   }
 
 #undef FLAG_REST
@@ -1651,7 +2494,7 @@ static inline void op_key_p( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   mrbc_value *kdict = &regs[vm->callinfo_tail->n_args];
-  mrbc_sym sym_id = mrbc_irep_symbol_id( vm->cur_irep, b );
+  mrbc_sym sym_id = SYMBOL_ID(b);
   mrbc_value *v = mrbc_hash_search_by_id( kdict, sym_id );
 
   mrbc_decref(&regs[a]);
@@ -1690,7 +2533,7 @@ static inline void op_karg( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   mrbc_value *kdict = &regs[vm->callinfo_tail->n_args];
-  mrbc_sym sym_id = mrbc_irep_symbol_id( vm->cur_irep, b );
+  mrbc_sym sym_id = SYMBOL_ID(b);
   mrbc_value v = mrbc_hash_remove_by_id( kdict, sym_id );
 
   if( mrbc_type(v) == MRBC_TT_EMPTY ) {
@@ -1720,7 +2563,7 @@ static inline void sub_op_return( mrbc_vm *vm, mrbc_value *regs, int a )
       mrbc_set_tt( &regs[a], MRBC_TT_EMPTY );
 
       vm->exception.tt = MRBC_TT_RETURN;
-      vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+      vm->inst = vm->cur_irep->inst + handler->target;
       return;
     }
   }
@@ -1739,6 +2582,14 @@ static inline void sub_op_return( mrbc_vm *vm, mrbc_value *regs, int a )
     return;
   }
 
+  // return to the C function that called the block.
+  if( vm->callinfo_tail->resume ) {
+    mrbc_value ret = regs[a];
+    mrbc_set_tt( &regs[a], MRBC_TT_EMPTY );
+    return_to_resume( vm, ret );
+    return;
+  }
+
   /* set the return value
     (conditions)
      iniialize  super   block   then
@@ -1803,7 +2654,7 @@ static inline void op_return_blk( mrbc_vm *vm, mrbc_value *regs EXT )
     if( handler ) {
       assert( mrbc_type(vm->exception) == MRBC_TT_NIL );
       vm->exception.tt = MRBC_TT_RETURN_BLK;
-      vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+      vm->inst = vm->cur_irep->inst + handler->target;
       return;
     }
 
@@ -1924,11 +2775,12 @@ static inline void op_break( mrbc_vm *vm, mrbc_value *regs EXT )
     if( handler ) {
       assert( mrbc_type(vm->exception) == MRBC_TT_NIL );
       vm->exception.tt = MRBC_TT_BREAK;
-      vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+      vm->inst = vm->cur_irep->inst + handler->target;
       return;
     }
 
-    reg_offset = vm->callinfo_tail->reg_offset;
+    // (the block called by mrbc_yield returns to the C function's register)
+    reg_offset = vm->callinfo_tail->reg_offset - vm->callinfo_tail->n_resume_regs;
     mrbc_pop_callinfo(vm);
   }
 
@@ -2008,6 +2860,7 @@ static inline void op_add( mrbc_vm *vm, mrbc_value *regs EXT )
   if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
       mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
     regs[a].i += regs[a+1].i;
+    QUICKEN( 1, OP_ADD, OP_ADD_II );
     return;
   }
 
@@ -2030,6 +2883,7 @@ static inline void op_add( mrbc_vm *vm, mrbc_value *regs EXT )
   if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
       mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
     regs[a].d += regs[a+1].d;
+    QUICKEN( 1, OP_ADD, OP_ADD_FF );
     return;
   }
 #endif
@@ -2050,6 +2904,7 @@ static inline void op_addi( mrbc_vm *vm, mrbc_value *regs EXT )
 
   if( mrbc_type(regs[a]) == MRBC_TT_INTEGER ) {
     regs[a].i += b;
+    QUICKEN( 2, OP_ADDI, OP_ADDI_I );
     return;
   }
 
@@ -2079,6 +2934,7 @@ static inline void op_sub( mrbc_vm *vm, mrbc_value *regs EXT )
   if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
       mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
     regs[a].i -= regs[a+1].i;
+    QUICKEN( 1, OP_SUB, OP_SUB_II );
     return;
   }
 
@@ -2101,6 +2957,7 @@ static inline void op_sub( mrbc_vm *vm, mrbc_value *regs EXT )
   if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
       mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
     regs[a].d -= regs[a+1].d;
+    QUICKEN( 1, OP_SUB, OP_SUB_FF );
     return;
   }
 #endif
@@ -2121,6 +2978,7 @@ static inline void op_subi( mrbc_vm *vm, mrbc_value *regs EXT )
 
   if( mrbc_type(regs[a]) == MRBC_TT_INTEGER ) {
     regs[a].i -= b;
+    QUICKEN( 2, OP_SUBI, OP_SUBI_I );
     return;
   }
 
@@ -2206,6 +3064,7 @@ static inline void op_mul( mrbc_vm *vm, mrbc_value *regs EXT )
   if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
       mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
     regs[a].i *= regs[a+1].i;
+    QUICKEN( 1, OP_MUL, OP_MUL_II );
     return;
   }
 
@@ -2228,6 +3087,7 @@ static inline void op_mul( mrbc_vm *vm, mrbc_value *regs EXT )
   if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
       mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
     regs[a].d *= regs[a+1].d;
+    QUICKEN( 1, OP_MUL, OP_MUL_FF );
     return;
   }
 #endif
@@ -2308,10 +3168,14 @@ static inline void op_eq( mrbc_vm *vm, mrbc_value *regs EXT )
     return;
   }
 
-  int result = mrbc_compare(&regs[a], &regs[a+1]);
+  if( mrbc_type(regs[a]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    QUICKEN( 1, OP_EQ, OP_EQ_II );
+  }
+  int result = mrbc_equal(&regs[a], &regs[a+1]);
 
   mrbc_decref(&regs[a]);
-  mrbc_set_bool( &regs[a], result == 0 );
+  mrbc_set_bool( &regs[a], result );
 }
 
 
@@ -2329,6 +3193,7 @@ static inline void op_lt( mrbc_vm *vm, mrbc_value *regs EXT )
     return;
   }
 
+  QUICKEN_COMPARE( OP_LT, OP_LT_II, OP_LT_FF );
   int result = mrbc_compare(&regs[a], &regs[a+1]);
 
   mrbc_decref(&regs[a]);
@@ -2350,6 +3215,7 @@ static inline void op_le( mrbc_vm *vm, mrbc_value *regs EXT )
     return;
   }
 
+  QUICKEN_COMPARE( OP_LE, OP_LE_II, OP_LE_FF );
   int result = mrbc_compare(&regs[a], &regs[a+1]);
 
   mrbc_decref(&regs[a]);
@@ -2371,6 +3237,7 @@ static inline void op_gt( mrbc_vm *vm, mrbc_value *regs EXT )
     return;
   }
 
+  QUICKEN_COMPARE( OP_GT, OP_GT_II, OP_GT_FF );
   int result = mrbc_compare(&regs[a], &regs[a+1]);
 
   mrbc_decref(&regs[a]);
@@ -2392,6 +3259,7 @@ static inline void op_ge( mrbc_vm *vm, mrbc_value *regs EXT )
     return;
   }
 
+  QUICKEN_COMPARE( OP_GE, OP_GE_II, OP_GE_FF );
   int result = mrbc_compare(&regs[a], &regs[a+1]);
 
   mrbc_decref(&regs[a]);
@@ -2610,7 +3478,7 @@ static inline void op_intern( mrbc_vm *vm, mrbc_value *regs EXT )
 
   assert( mrbc_type(regs[a]) == MRBC_TT_STRING );
 
-  mrbc_value sym_val = mrbc_symbol_new(vm, (const char*)regs[a].string->data);
+  mrbc_value sym_val = mrbc_symbol_new(vm, mrbc_string_cstr(&regs[a]));
 
   mrbc_decref( &regs[a] );
   regs[a] = sym_val;
@@ -2678,6 +3546,26 @@ static inline void op_strcat( mrbc_vm *vm, mrbc_value *regs EXT )
 }
 
 
+//================================================================
+/*! copy the String keys referred from others. (see mrbc_hash_set)
+
+  @param  vm	pointer to VM.
+  @param  kv	pointer to the key-value pairs.
+  @param  n	num of pairs.
+*/
+static void copy_hash_string_keys( mrbc_vm *vm, mrbc_value *kv, int n )
+{
+  for( ; n > 0; n--, kv += 2 ) {
+    if( mrbc_type(kv[0]) != MRBC_TT_STRING || kv[0].string->ref_count <= 1 ) {
+      continue;
+    }
+    mrbc_value k = mrbc_string_dup( vm, &kv[0] );
+    mrbc_decref( &kv[0] );
+    kv[0] = k;
+  }
+}
+
+
 //================================================================
 /*! OP_HASH
 
@@ -2690,6 +3578,7 @@ static inline void op_hash( mrbc_vm *vm, mrbc_value *regs EXT )
   mrbc_value value = mrbc_hash_new(vm, b);
 
   // note: Do not detect duplicate keys.
+  copy_hash_string_keys( vm, &regs[a], b );
   b *= 2;
   memcpy( value.hash->data, &regs[a], sizeof(mrbc_value) * b );
   memset( &regs[a], 0, sizeof(mrbc_value) * b );
@@ -2716,9 +3605,11 @@ static inline void op_hashadd( mrbc_vm *vm, mrbc_value *regs EXT )
 
   // data copy.
   // note: Do not detect duplicate keys.
+  copy_hash_string_keys( vm, &regs[a+1], b );
   memcpy( regs[a].hash->data + sz1, &regs[a+1], sizeof(mrbc_value) * sz2 );
   memset( &regs[a+1], 0, sizeof(mrbc_value) * sz2 );
   regs[a].hash->n_stored = sz1 + sz2;
+  mrbc_hash_reindex(&regs[a]);
 }
 
 
@@ -2735,9 +3626,9 @@ static inline void op_hashcat( mrbc_vm *vm, mrbc_value *regs EXT )
 
   while( mrbc_hash_i_has_next(&ite) ) {
     mrbc_value *kv = mrbc_hash_i_next(&ite);
-    mrbc_hash_set( &regs[a], &kv[0], &kv[1] );
     mrbc_incref( &kv[0] );
     mrbc_incref( &kv[1] );
+    mrbc_hash_set( &regs[a], &kv[0], &kv[1] );
   }
 }
 
@@ -2862,7 +3753,7 @@ static inline void op_class( mrbc_vm *vm, mrbc_value *regs EXT )
     outer = vm->cur_regs[0].cls;
   }
 
-  const char *class_name = mrbc_irep_symbol_cstr(vm->cur_irep, b);
+  const char *class_name = mrbc_symid_to_str(SYMBOL_ID(b));
   mrbc_class *cls;
 
   // define a new class (or get an already defined class)
@@ -2897,7 +3788,7 @@ static inline void op_module( mrbc_vm *vm, mrbc_value *regs EXT )
     outer = vm->cur_regs[0].cls;
   }
 
-  const char *module_name = mrbc_irep_symbol_cstr(vm->cur_irep, b);
+  const char *module_name = mrbc_symid_to_str(SYMBOL_ID(b));
   mrbc_class *cls;
 
   // define a new module (or get an already defined class)
@@ -2924,7 +3815,7 @@ static inline void op_exec( mrbc_vm *vm, mrbc_value *regs EXT )
   FETCH_BB();
 
   // prepare callinfo
-  mrbc_push_callinfo(vm, regs[a].cls->sym_id, a, 0);
+  if( !mrbc_push_callinfo(vm, regs[a].cls->sym_id, a, 0) ) return;
 
   // target irep
   vm->cur_irep = mrbc_irep_child_irep(vm->cur_irep, b);
@@ -2932,6 +3823,12 @@ static inline void op_exec( mrbc_vm *vm, mrbc_value *regs EXT )
   vm->cur_regs += a;
 
   vm->target_class = regs[a].cls;
+
+  // class body has no OP_ENTER, so check the number of registers here.
+  int reg_use_max = vm->cur_regs - vm->regs + vm->cur_irep->nregs;
+  if( reg_use_max + REGS_MARGIN >= vm->regs_size ) {
+    if( grow_regs( vm, reg_use_max + 1 ) != 0 ) return;
+  }
 }
 
 
@@ -2949,6 +3846,7 @@ static void sub_newmethod( mrbc_class *cls, mrbc_method *method, mrbc_sym sym_id
 {
   method->next = cls->method_link;
   cls->method_link = method;
+  mrbc_clear_method_cache();
 
   if( !method->c_func ) sub_irep_inc_dec_ref( method->irep, +1 );
 
@@ -3003,7 +3901,7 @@ static inline void op_def( mrbc_vm *vm, mrbc_value *regs EXT )
 
   mrbc_class *cls = regs[a].cls;
   mrbc_irep *irep = regs[a+1].proc->irep;
-  mrbc_sym sym_id = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id = SYMBOL_ID(b);
 
   sub_op_def( vm, cls, irep, sym_id );
   mrbc_set_symbol(&regs[a], sym_id);
@@ -3021,7 +3919,7 @@ static inline void op_tdef( mrbc_vm *vm, mrbc_value *regs EXT )
 
   mrbc_class *cls = vm->target_class;
   mrbc_irep *irep = mrbc_irep_child_irep(vm->cur_irep, c);
-  mrbc_sym sym_id = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id = SYMBOL_ID(b);
 
   sub_op_def( vm, cls, irep, sym_id );
   mrbc_set_symbol(&regs[a], sym_id);
@@ -3039,7 +3937,7 @@ static inline void op_sdef( mrbc_vm *vm, mrbc_value *regs EXT )
 
   mrbc_class *cls = regs[a].cls;
   mrbc_irep *irep = mrbc_irep_child_irep(vm->cur_irep, c);
-  mrbc_sym sym_id = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id = SYMBOL_ID(b);
 
   sub_op_def( vm, cls, irep, sym_id );
   mrbc_set_symbol(&regs[a], sym_id);
@@ -3055,8 +3953,8 @@ static inline void op_alias( mrbc_vm *vm, mrbc_value *regs EXT )
 {
   FETCH_BB();
 
-  mrbc_sym sym_id_new = mrbc_irep_symbol_id(vm->cur_irep, a);
-  mrbc_sym sym_id_org = mrbc_irep_symbol_id(vm->cur_irep, b);
+  mrbc_sym sym_id_new = SYMBOL_ID(a);
+  mrbc_sym sym_id_org = SYMBOL_ID(b);
   mrbc_class *cls = vm->target_class;
   mrbc_method *method = (vm->vm_id == 0) ?
     mrbc_raw_alloc_no_free( sizeof(mrbc_method) ) :
@@ -3135,6 +4033,435 @@ static inline void op_stop( mrbc_vm *vm, mrbc_value *regs EXT )
 }
 
 
+#if MRBC_USE_INST_FUSION
+/*
+  Fused instructions. (superinstructions)
+
+  Made by the loader (see load.c), and execute a pair of instructions
+  without dispatching between them. The 2nd instruction is left in the
+  instruction stream, so jump offsets and catch handlers are unchanged.
+  If the 1st instruction leaves the current position (method call,
+  jump or exception), the 2nd one is executed later by usual dispatch.
+  Instructions with OP_EXTn prefix are never fused.
+*/
+#define DEFINE_FUSED_OP(name, op1, op1_operand_size, op2) \
+static inline void name( mrbc_vm *vm, mrbc_value *regs EXT ) \
+{ \
+  const uint8_t *inst2 = vm->inst + OPERAND_SIZE(op1_operand_size); \
+  op1( vm, regs EXT_ARG ); \
+  if( vm->inst != inst2 || vm->flag_preemption ) return; \
+  vm->inst++;		/* skip the opcode of 2nd instruction. */ \
+  op2( vm, regs EXT_ARG ); \
+}
+
+DEFINE_FUSED_OP( op_move_send,    op_move,    2, op_send )
+DEFINE_FUSED_OP( op_move_ssend,   op_move,    2, op_ssend )
+DEFINE_FUSED_OP( op_getiv_send0,  op_getiv,   2, op_send0 )
+DEFINE_FUSED_OP( op_eq_jmpnot,    op_eq,      1, op_jmpnot )
+DEFINE_FUSED_OP( op_lt_jmpnot,    op_lt,      1, op_jmpnot )
+DEFINE_FUSED_OP( op_le_jmpnot,    op_le,      1, op_jmpnot )
+DEFINE_FUSED_OP( op_gt_jmpnot,    op_gt,      1, op_jmpnot )
+DEFINE_FUSED_OP( op_ge_jmpnot,    op_ge,      1, op_jmpnot )
+DEFINE_FUSED_OP( op_eq_jmpif,     op_eq,      1, op_jmpif )
+DEFINE_FUSED_OP( op_lt_jmpif,     op_lt,      1, op_jmpif )
+DEFINE_FUSED_OP( op_le_jmpif,     op_le,      1, op_jmpif )
+DEFINE_FUSED_OP( op_gt_jmpif,     op_gt,      1, op_jmpif )
+DEFINE_FUSED_OP( op_ge_jmpif,     op_ge,      1, op_jmpif )
+DEFINE_FUSED_OP( op_loadnil_return, op_loadnil, 1, op_return )
+#undef DEFINE_FUSED_OP
+
+
+//================================================================
+/*! OP_LOADI_n + OP_ADD
+
+  R[a] = mrb_int(n); R[c] = R[c]+R[c+1]
+*/
+static inline void op_loadi_n_add( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  // get n
+  int opcode = vm->inst[-1];
+  int n = opcode - OP_LOADI_0_ADD;
+
+  FETCH_B();
+
+  mrbc_decref(&regs[a]);
+  mrbc_set_integer(&regs[a], n);
+
+  vm->inst++;		// skip OP_ADD
+  op_add( vm, regs EXT_ARG );
+}
+#endif
+
+
+#if MRBC_USE_QUICKENING
+/*
+  Quickened instructions.
+
+  Generic instructions rewrite themselves to these when the operands are
+  Integer or Float. If the operand types are different, these revert
+  to the generic instruction and execute it.
+*/
+//================================================================
+/*! OP_ADD_II
+
+  R[a] = R[a]+R[a+1]  (Integer)
+*/
+static inline void op_add_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    regs[a].i += regs[a+1].i;
+    return;
+  }
+
+  dequicken( vm, 1, OP_ADD );
+  op_add( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_ADD_FF
+
+  R[a] = R[a]+R[a+1]  (Float)
+*/
+static inline void op_add_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    regs[a].d += regs[a+1].d;
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_ADD );
+  op_add( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_SUB_II
+
+  R[a] = R[a]-R[a+1]  (Integer)
+*/
+static inline void op_sub_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    regs[a].i -= regs[a+1].i;
+    return;
+  }
+
+  dequicken( vm, 1, OP_SUB );
+  op_sub( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_SUB_FF
+
+  R[a] = R[a]-R[a+1]  (Float)
+*/
+static inline void op_sub_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    regs[a].d -= regs[a+1].d;
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_SUB );
+  op_sub( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_MUL_II
+
+  R[a] = R[a]*R[a+1]  (Integer)
+*/
+static inline void op_mul_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    regs[a].i *= regs[a+1].i;
+    return;
+  }
+
+  dequicken( vm, 1, OP_MUL );
+  op_mul( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_MUL_FF
+
+  R[a] = R[a]*R[a+1]  (Float)
+*/
+static inline void op_mul_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    regs[a].d *= regs[a+1].d;
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_MUL );
+  op_mul( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_ADDI_I
+
+  R[a] = R[a]+mrb_int(b)  (Integer)
+*/
+static inline void op_addi_i( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_BB();
+
+  if( mrbc_type(regs[a]) == MRBC_TT_INTEGER ) {
+    regs[a].i += b;
+    return;
+  }
+
+  dequicken( vm, 2, OP_ADDI );
+  op_addi( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_SUBI_I
+
+  R[a] = R[a]-mrb_int(b)  (Integer)
+*/
+static inline void op_subi_i( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_BB();
+
+  if( mrbc_type(regs[a]) == MRBC_TT_INTEGER ) {
+    regs[a].i -= b;
+    return;
+  }
+
+  dequicken( vm, 2, OP_SUBI );
+  op_subi( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_EQ_II
+
+  R[a] = R[a]==R[a+1]  (Integer)
+*/
+static inline void op_eq_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    mrbc_set_bool( &regs[a], regs[a].i == regs[a+1].i );
+    return;
+  }
+
+  dequicken( vm, 1, OP_EQ );
+  op_eq( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_LT_II
+
+  R[a] = R[a]<R[a+1]  (Integer)
+*/
+static inline void op_lt_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    mrbc_set_bool( &regs[a], regs[a].i < regs[a+1].i );
+    return;
+  }
+
+  dequicken( vm, 1, OP_LT );
+  op_lt( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_LT_FF
+
+  R[a] = R[a]<R[a+1]  (Float)
+*/
+static inline void op_lt_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    mrbc_float_t d1 = regs[a].d;
+    mrbc_float_t d2 = regs[a+1].d;
+    mrbc_set_bool( &regs[a], !(d1 >= d2) );	// same as mrbc_compare() for NaN.
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_LT );
+  op_lt( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_LE_II
+
+  R[a] = R[a]<=R[a+1]  (Integer)
+*/
+static inline void op_le_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    mrbc_set_bool( &regs[a], regs[a].i <= regs[a+1].i );
+    return;
+  }
+
+  dequicken( vm, 1, OP_LE );
+  op_le( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_LE_FF
+
+  R[a] = R[a]<=R[a+1]  (Float)
+*/
+static inline void op_le_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    mrbc_float_t d1 = regs[a].d;
+    mrbc_float_t d2 = regs[a+1].d;
+    mrbc_set_bool( &regs[a], !(d1 > d2) );	// same as mrbc_compare() for NaN.
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_LE );
+  op_le( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_GT_II
+
+  R[a] = R[a]>R[a+1]  (Integer)
+*/
+static inline void op_gt_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    mrbc_set_bool( &regs[a], regs[a].i > regs[a+1].i );
+    return;
+  }
+
+  dequicken( vm, 1, OP_GT );
+  op_gt( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_GT_FF
+
+  R[a] = R[a]>R[a+1]  (Float)
+*/
+static inline void op_gt_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    mrbc_float_t d1 = regs[a].d;
+    mrbc_float_t d2 = regs[a+1].d;
+    mrbc_set_bool( &regs[a], d1 > d2 );	// same as mrbc_compare() for NaN.
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_GT );
+  op_gt( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_GE_II
+
+  R[a] = R[a]>=R[a+1]  (Integer)
+*/
+static inline void op_ge_ii( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+  if( mrbc_type(regs[a  ]) == MRBC_TT_INTEGER &&
+      mrbc_type(regs[a+1]) == MRBC_TT_INTEGER ) {
+    mrbc_set_bool( &regs[a], regs[a].i >= regs[a+1].i );
+    return;
+  }
+
+  dequicken( vm, 1, OP_GE );
+  op_ge( vm, regs EXT_ARG );
+}
+
+
+//================================================================
+/*! OP_GE_FF
+
+  R[a] = R[a]>=R[a+1]  (Float)
+*/
+static inline void op_ge_ff( mrbc_vm *vm, mrbc_value *regs EXT )
+{
+  FETCH_B();
+
+#if MRBC_USE_FLOAT
+  if( mrbc_type(regs[a  ]) == MRBC_TT_FLOAT &&
+      mrbc_type(regs[a+1]) == MRBC_TT_FLOAT ) {
+    mrbc_float_t d1 = regs[a].d;
+    mrbc_float_t d2 = regs[a+1].d;
+    mrbc_set_bool( &regs[a], d1 >= d2 );	// same as mrbc_compare() for NaN.
+    return;
+  }
+#endif
+
+  dequicken( vm, 1, OP_GE );
+  op_ge( vm, regs EXT_ARG );
+}
+#endif
+
+
 //================================================================
 /* Unsupported opecodes
 */
@@ -3144,6 +4471,12 @@ static inline void op_unsupported( mrbc_vm *vm, mrbc_value *regs EXT )
                "Unimplemented opcode (0x%02x) found", *(vm->inst - 1));
 }
 #undef EXT
+#undef EXT_ARG
+#undef OPERAND_SIZE
+#undef JUMP_OFFSET
+#undef SYMBOL_ID
+#undef QUICKEN
+#undef QUICKEN_COMPARE
 
 
 //================================================================
@@ -3163,9 +4496,362 @@ int mrbc_vm_run( mrbc_vm *vm )
 #define EXT
 #endif
 
+#if MRBC_USE_THREADED_DISPATCH
+  /*
+    Threaded dispatch.
+    Each handler jumps directly to the next one through the label address
+    table, so every opcode gets its own indirect branch and preemption check.
+  */
+  static const void * const dispatch_table[256] = {
+      [OP_NOP]       = &&L_op_nop,
+      [OP_MOVE]      = &&L_op_move,
+      [OP_LOADL]     = &&L_op_loadl,
+      [OP_LOADI8]    = &&L_op_loadi8,
+      [OP_LOADINEG]  = &&L_op_loadineg,
+      [OP_LOADI__1]  = &&L_op_loadi_n,
+      [OP_LOADI_0]   = &&L_op_loadi_n,
+      [OP_LOADI_1]   = &&L_op_loadi_n,
+      [OP_LOADI_2]   = &&L_op_loadi_n,
+      [OP_LOADI_3]   = &&L_op_loadi_n,
+      [OP_LOADI_4]   = &&L_op_loadi_n,
+      [OP_LOADI_5]   = &&L_op_loadi_n,
+      [OP_LOADI_6]   = &&L_op_loadi_n,
+      [OP_LOADI_7]   = &&L_op_loadi_n,
+      [OP_LOADI16]   = &&L_op_loadi16,
+      [OP_LOADI32]   = &&L_op_loadi32,
+      [OP_LOADSYM]   = &&L_op_loadsym,
+      [OP_LOADNIL]   = &&L_op_loadnil,
+      [OP_LOADSELF]  = &&L_op_loadself,
+      [OP_LOADTRUE]  = &&L_op_loadtrue,
+      [OP_LOADFALSE] = &&L_op_loadfalse,
+      [OP_GETGV]     = &&L_op_getgv,
+      [OP_SETGV]     = &&L_op_setgv,
+      [OP_GETSV]     = &&L_op_unsupported,
+      [OP_SETSV]     = &&L_op_unsupported,
+      [OP_GETIV]     = &&L_op_getiv,
+      [OP_SETIV]     = &&L_op_setiv,
+      [OP_GETCV]     = &&L_op_unsupported,
+      [OP_SETCV]     = &&L_op_unsupported,
+      [OP_GETCONST]  = &&L_op_getconst,
+      [OP_SETCONST]  = &&L_op_setconst,
+      [OP_GETMCNST]  = &&L_op_getmcnst,
+      [OP_SETMCNST]  = &&L_op_unsupported,
+      [OP_GETUPVAR]  = &&L_op_getupvar,
+      [OP_SETUPVAR]  = &&L_op_setupvar,
+      [OP_GETIDX]    = &&L_op_getidx,
+      [OP_GETIDX0]   = &&L_op_getidx0,
+      [OP_SETIDX]    = &&L_op_setidx,
+      [OP_JMP]       = &&L_op_jmp,
+      [OP_JMPIF]     = &&L_op_jmpif,
+      [OP_JMPNOT]    = &&L_op_jmpnot,
+      [OP_JMPNIL]    = &&L_op_jmpnil,
+      [OP_JMPUW]     = &&L_op_jmpuw,
+      [OP_EXCEPT]    = &&L_op_except,
+      [OP_RESCUE]    = &&L_op_rescue,
+      [OP_RAISEIF]   = &&L_op_raiseif,
+      [OP_MATCHERR]  = &&L_op_matcherr,
+      [OP_SSEND]     = &&L_op_ssend,
+      [OP_SSEND0]    = &&L_op_ssend0,
+      [OP_SSENDB]    = &&L_op_ssendb,
+      [OP_SEND]      = &&L_op_send,
+      [OP_SEND0]     = &&L_op_send0,
+      [OP_SENDB]     = &&L_op_sendb,
+      [OP_CALL]      = &&L_op_unsupported,
+      [OP_BLKCALL]   = &&L_op_blkcall,
+      [OP_SUPER]     = &&L_op_super,
+      [OP_ARGARY]    = &&L_op_argary,
+      [OP_ENTER]     = &&L_op_enter,
+      [OP_KEY_P]     = &&L_op_key_p,
+      [OP_KEYEND]    = &&L_op_keyend,
+      [OP_KARG]      = &&L_op_karg,
+      [OP_RETURN]    = &&L_op_return,
+      [OP_RETURN_BLK] = &&L_op_return_blk,
+      [OP_RETSELF]   = &&L_op_retself,
+      [OP_RETNIL]    = &&L_op_retnil,
+      [OP_RETTRUE]   = &&L_op_rettrue,
+      [OP_RETFALSE]  = &&L_op_retfalse,
+      [OP_BREAK]     = &&L_op_break,
+      [OP_BLKPUSH]   = &&L_op_blkpush,
+      [OP_ADD]       = &&L_op_add,
+      [OP_ADDI]      = &&L_op_addi,
+      [OP_SUB]       = &&L_op_sub,
+      [OP_SUBI]      = &&L_op_subi,
+      [OP_ADDILV]    = &&L_op_addilv,
+      [OP_SUBILV]    = &&L_op_subilv,
+      [OP_MUL]       = &&L_op_mul,
+      [OP_DIV]       = &&L_op_div,
+      [OP_EQ]        = &&L_op_eq,
+      [OP_LT]        = &&L_op_lt,
+      [OP_LE]        = &&L_op_le,
+      [OP_GT]        = &&L_op_gt,
+      [OP_GE]        = &&L_op_ge,
+      [OP_ARRAY]     = &&L_op_array,
+      [OP_ARRAY2]    = &&L_op_array2,
+      [OP_ARYCAT]    = &&L_op_arycat,
+      [OP_ARYPUSH]   = &&L_op_arypush,
+      [OP_ARYSPLAT]  = &&L_op_arysplat,
+      [OP_AREF]      = &&L_op_aref,
+      [OP_ASET]      = &&L_op_aset,
+      [OP_APOST]     = &&L_op_apost,
+      [OP_INTERN]    = &&L_op_intern,
+      [OP_SYMBOL]    = &&L_op_symbol,
+      [OP_STRING]    = &&L_op_string,
+      [OP_STRCAT]    = &&L_op_strcat,
+      [OP_HASH]      = &&L_op_hash,
+      [OP_HASHADD]   = &&L_op_hashadd,
+      [OP_HASHCAT]   = &&L_op_hashcat,
+      [OP_LAMBDA]    = &&L_op_unsupported,
+      [OP_BLOCK]     = &&L_op_block,
+      [OP_METHOD]    = &&L_op_method,
+      [OP_RANGE_INC] = &&L_op_range_inc,
+      [OP_RANGE_EXC] = &&L_op_range_exc,
+      [OP_OCLASS]    = &&L_op_oclass,
+      [OP_CLASS]     = &&L_op_class,
+      [OP_MODULE]    = &&L_op_module,
+      [OP_EXEC]      = &&L_op_exec,
+      [OP_DEF]       = &&L_op_def,
+      [OP_TDEF]      = &&L_op_tdef,
+      [OP_SDEF]      = &&L_op_sdef,
+      [OP_ALIAS]     = &&L_op_alias,
+      [OP_UNDEF]     = &&L_op_unsupported,
+      [OP_SCLASS]    = &&L_op_sclass,
+      [OP_TCLASS]    = &&L_op_tclass,
+      [OP_DEBUG]     = &&L_op_unsupported,
+      [OP_ERR]       = &&L_op_unsupported,
+      [OP_STOP]      = &&L_op_stop,
+#if defined(MRBC_SUPPORT_OP_EXT)
+      [OP_EXT1]      = &&L_OP_EXT1,
+      [OP_EXT2]      = &&L_OP_EXT2,
+      [OP_EXT3]      = &&L_OP_EXT3,
+#else
+      [OP_EXT1]      = &&L_op_ext,
+      [OP_EXT2]      = &&L_op_ext,
+      [OP_EXT3]      = &&L_op_ext,
+#endif
+#if MRBC_USE_INST_FUSION
+      [OP_LOADI__1_ADD ... OP_LOADI_7_ADD] = &&L_op_loadi_n_add,
+      [OP_MOVE_SEND]   = &&L_op_move_send,
+      [OP_MOVE_SSEND]  = &&L_op_move_ssend,
+      [OP_GETIV_SEND0] = &&L_op_getiv_send0,
+      [OP_EQ_JMPNOT]   = &&L_op_eq_jmpnot,
+      [OP_LT_JMPNOT]   = &&L_op_lt_jmpnot,
+      [OP_LE_JMPNOT]   = &&L_op_le_jmpnot,
+      [OP_GT_JMPNOT]   = &&L_op_gt_jmpnot,
+      [OP_GE_JMPNOT]   = &&L_op_ge_jmpnot,
+      [OP_EQ_JMPIF]    = &&L_op_eq_jmpif,
+      [OP_LT_JMPIF]    = &&L_op_lt_jmpif,
+      [OP_LE_JMPIF]    = &&L_op_le_jmpif,
+      [OP_GT_JMPIF]    = &&L_op_gt_jmpif,
+      [OP_GE_JMPIF]    = &&L_op_ge_jmpif,
+      [OP_LOADNIL_RETURN] = &&L_op_loadnil_return,
+#else
+      [OP_STOP+1 ... OP_FUSED_LAST] = &&L_op_unsupported,
+#endif
+#if MRBC_USE_QUICKENING
+      [OP_ADD_II]   = &&L_op_add_ii,
+      [OP_ADD_FF]   = &&L_op_add_ff,
+      [OP_SUB_II]   = &&L_op_sub_ii,
+      [OP_SUB_FF]   = &&L_op_sub_ff,
+      [OP_MUL_II]   = &&L_op_mul_ii,
+      [OP_MUL_FF]   = &&L_op_mul_ff,
+      [OP_ADDI_I]   = &&L_op_addi_i,
+      [OP_SUBI_I]   = &&L_op_subi_i,
+      [OP_EQ_II]    = &&L_op_eq_ii,
+      [OP_LT_II]    = &&L_op_lt_ii,
+      [OP_LT_FF]    = &&L_op_lt_ff,
+      [OP_LE_II]    = &&L_op_le_ii,
+      [OP_LE_FF]    = &&L_op_le_ff,
+      [OP_GT_II]    = &&L_op_gt_ii,
+      [OP_GT_FF]    = &&L_op_gt_ff,
+      [OP_GE_II]    = &&L_op_ge_ii,
+      [OP_GE_FF]    = &&L_op_ge_ff,
+#else
+      [OP_FUSED_LAST+1 ... OP_QUICK_LAST] = &&L_op_unsupported,
+#endif
+      [OP_QUICK_LAST+1 ... 255] = &&L_op_unsupported,
+  };
+#if defined(MRBC_SUPPORT_OP_EXT)
+#define RESET_EXT ext = 0
+#else
+#define RESET_EXT
+#endif
+#if defined(MRBC_COUNT_INSTRUCTIONS)
+#define COUNT_INST vm->inst_count++
+#else
+#define COUNT_INST
+#endif
+#define DISPATCH() \
+  do { regs = vm->cur_regs; COUNT_INST; \
+       goto *dispatch_table[*vm->inst++]; } while(0)
+#define DISPATCH_OP(func) \
+  L_##func: \
+  func(vm, regs EXT); \
+  RESET_EXT; \
+  if( vm->flag_preemption ) goto PREEMPTED; \
+  DISPATCH()
+#endif
+
   while( 1 ) {
-    mrbc_value *regs = vm->cur_regs;
+    mrbc_value *regs;
+
+#if MRBC_USE_THREADED_DISPATCH
+    DISPATCH();
+
+    DISPATCH_OP( op_nop );
+    DISPATCH_OP( op_move );
+    DISPATCH_OP( op_loadl );
+    DISPATCH_OP( op_loadi8 );
+    DISPATCH_OP( op_loadineg );
+    DISPATCH_OP( op_loadi_n );
+    DISPATCH_OP( op_loadi16 );
+    DISPATCH_OP( op_loadi32 );
+    DISPATCH_OP( op_loadsym );
+    DISPATCH_OP( op_loadnil );
+    DISPATCH_OP( op_loadself );
+    DISPATCH_OP( op_loadtrue );
+    DISPATCH_OP( op_loadfalse );
+    DISPATCH_OP( op_getgv );
+    DISPATCH_OP( op_setgv );
+    DISPATCH_OP( op_unsupported );
+    DISPATCH_OP( op_getiv );
+    DISPATCH_OP( op_setiv );
+    DISPATCH_OP( op_getconst );
+    DISPATCH_OP( op_setconst );
+    DISPATCH_OP( op_getmcnst );
+    DISPATCH_OP( op_getupvar );
+    DISPATCH_OP( op_setupvar );
+    DISPATCH_OP( op_getidx );
+    DISPATCH_OP( op_getidx0 );
+    DISPATCH_OP( op_setidx );
+    DISPATCH_OP( op_jmp );
+    DISPATCH_OP( op_jmpif );
+    DISPATCH_OP( op_jmpnot );
+    DISPATCH_OP( op_jmpnil );
+    DISPATCH_OP( op_jmpuw );
+    DISPATCH_OP( op_except );
+    DISPATCH_OP( op_rescue );
+    DISPATCH_OP( op_raiseif );
+    DISPATCH_OP( op_matcherr );
+    DISPATCH_OP( op_ssend );
+    DISPATCH_OP( op_ssend0 );
+    DISPATCH_OP( op_ssendb );
+    DISPATCH_OP( op_send );
+    DISPATCH_OP( op_send0 );
+    DISPATCH_OP( op_sendb );
+    DISPATCH_OP( op_blkcall );
+    DISPATCH_OP( op_super );
+    DISPATCH_OP( op_argary );
+    DISPATCH_OP( op_enter );
+    DISPATCH_OP( op_key_p );
+    DISPATCH_OP( op_keyend );
+    DISPATCH_OP( op_karg );
+    DISPATCH_OP( op_return );
+    DISPATCH_OP( op_return_blk );
+    DISPATCH_OP( op_retself );
+    DISPATCH_OP( op_retnil );
+    DISPATCH_OP( op_rettrue );
+    DISPATCH_OP( op_retfalse );
+    DISPATCH_OP( op_break );
+    DISPATCH_OP( op_blkpush );
+    DISPATCH_OP( op_add );
+    DISPATCH_OP( op_addi );
+    DISPATCH_OP( op_sub );
+    DISPATCH_OP( op_subi );
+    DISPATCH_OP( op_addilv );
+    DISPATCH_OP( op_subilv );
+    DISPATCH_OP( op_mul );
+    DISPATCH_OP( op_div );
+    DISPATCH_OP( op_eq );
+    DISPATCH_OP( op_lt );
+    DISPATCH_OP( op_le );
+    DISPATCH_OP( op_gt );
+    DISPATCH_OP( op_ge );
+    DISPATCH_OP( op_array );
+    DISPATCH_OP( op_array2 );
+    DISPATCH_OP( op_arycat );
+    DISPATCH_OP( op_arypush );
+    DISPATCH_OP( op_arysplat );
+    DISPATCH_OP( op_aref );
+    DISPATCH_OP( op_aset );
+    DISPATCH_OP( op_apost );
+    DISPATCH_OP( op_intern );
+    DISPATCH_OP( op_symbol );
+    DISPATCH_OP( op_string );
+    DISPATCH_OP( op_strcat );
+    DISPATCH_OP( op_hash );
+    DISPATCH_OP( op_hashadd );
+    DISPATCH_OP( op_hashcat );
+    DISPATCH_OP( op_block );
+    DISPATCH_OP( op_method );
+    DISPATCH_OP( op_range_inc );
+    DISPATCH_OP( op_range_exc );
+    DISPATCH_OP( op_oclass );
+    DISPATCH_OP( op_class );
+    DISPATCH_OP( op_module );
+    DISPATCH_OP( op_exec );
+    DISPATCH_OP( op_def );
+    DISPATCH_OP( op_tdef );
+    DISPATCH_OP( op_sdef );
+    DISPATCH_OP( op_alias );
+    DISPATCH_OP( op_sclass );
+    DISPATCH_OP( op_tclass );
+    DISPATCH_OP( op_stop );
+#if MRBC_USE_INST_FUSION
+    DISPATCH_OP( op_loadi_n_add );
+    DISPATCH_OP( op_move_send );
+    DISPATCH_OP( op_move_ssend );
+    DISPATCH_OP( op_getiv_send0 );
+    DISPATCH_OP( op_eq_jmpnot );
+    DISPATCH_OP( op_lt_jmpnot );
+    DISPATCH_OP( op_le_jmpnot );
+    DISPATCH_OP( op_gt_jmpnot );
+    DISPATCH_OP( op_ge_jmpnot );
+    DISPATCH_OP( op_eq_jmpif );
+    DISPATCH_OP( op_lt_jmpif );
+    DISPATCH_OP( op_le_jmpif );
+    DISPATCH_OP( op_gt_jmpif );
+    DISPATCH_OP( op_ge_jmpif );
+    DISPATCH_OP( op_loadnil_return );
+#endif
+#if MRBC_USE_QUICKENING
+    DISPATCH_OP( op_add_ii );
+    DISPATCH_OP( op_add_ff );
+    DISPATCH_OP( op_sub_ii );
+    DISPATCH_OP( op_sub_ff );
+    DISPATCH_OP( op_mul_ii );
+    DISPATCH_OP( op_mul_ff );
+    DISPATCH_OP( op_addi_i );
+    DISPATCH_OP( op_subi_i );
+    DISPATCH_OP( op_eq_ii );
+    DISPATCH_OP( op_lt_ii );
+    DISPATCH_OP( op_lt_ff );
+    DISPATCH_OP( op_le_ii );
+    DISPATCH_OP( op_le_ff );
+    DISPATCH_OP( op_gt_ii );
+    DISPATCH_OP( op_gt_ff );
+    DISPATCH_OP( op_ge_ii );
+    DISPATCH_OP( op_ge_ff );
+#endif
+#if defined(MRBC_SUPPORT_OP_EXT)
+  L_OP_EXT1: ext = 1; DISPATCH();
+  L_OP_EXT2: ext = 2; DISPATCH();
+  L_OP_EXT3: ext = 3; DISPATCH();
+#else
+    DISPATCH_OP( op_ext );
+#endif
+
+#undef DISPATCH_OP
+#undef DISPATCH
+#undef COUNT_INST
+#undef RESET_EXT
+  PREEMPTED:
+
+#else
+    regs = vm->cur_regs;
     uint8_t op = *vm->inst++;		// Dispatch
+#if defined(MRBC_COUNT_INSTRUCTIONS)
+    vm->inst_count++;
+#endif
 
     switch( op ) {
     case OP_NOP:        op_nop        (vm, regs EXT); break;
@@ -3294,8 +4980,55 @@ int mrbc_vm_run( mrbc_vm *vm )
     case OP_EXT3:       op_ext        (vm, regs EXT); break;
 #endif
     case OP_STOP:       op_stop       (vm, regs EXT); break;
+
+#if MRBC_USE_INST_FUSION
+    case OP_LOADI__1_ADD: // fall through
+    case OP_LOADI_0_ADD:  // fall through
+    case OP_LOADI_1_ADD:  // fall through
+    case OP_LOADI_2_ADD:  // fall through
+    case OP_LOADI_3_ADD:  // fall through
+    case OP_LOADI_4_ADD:  // fall through
+    case OP_LOADI_5_ADD:  // fall through
+    case OP_LOADI_6_ADD:  // fall through
+    case OP_LOADI_7_ADD:  op_loadi_n_add  (vm, regs EXT); break;
+    case OP_MOVE_SEND:    op_move_send    (vm, regs EXT); break;
+    case OP_MOVE_SSEND:   op_move_ssend   (vm, regs EXT); break;
+    case OP_GETIV_SEND0:  op_getiv_send0  (vm, regs EXT); break;
+    case OP_EQ_JMPNOT:    op_eq_jmpnot    (vm, regs EXT); break;
+    case OP_LT_JMPNOT:    op_lt_jmpnot    (vm, regs EXT); break;
+    case OP_LE_JMPNOT:    op_le_jmpnot    (vm, regs EXT); break;
+    case OP_GT_JMPNOT:    op_gt_jmpnot    (vm, regs EXT); break;
+    case OP_GE_JMPNOT:    op_ge_jmpnot    (vm, regs EXT); break;
+    case OP_EQ_JMPIF:     op_eq_jmpif     (vm, regs EXT); break;
+    case OP_LT_JMPIF:     op_lt_jmpif     (vm, regs EXT); break;
+    case OP_LE_JMPIF:     op_le_jmpif     (vm, regs EXT); break;
+    case OP_GT_JMPIF:     op_gt_jmpif     (vm, regs EXT); break;
+    case OP_GE_JMPIF:     op_ge_jmpif     (vm, regs EXT); break;
+    case OP_LOADNIL_RETURN: op_loadnil_return(vm, regs EXT); break;
+#endif
+
+#if MRBC_USE_QUICKENING
+    case OP_ADD_II:        op_add_ii        (vm, regs EXT); break;
+    case OP_ADD_FF:        op_add_ff        (vm, regs EXT); break;
+    case OP_SUB_II:        op_sub_ii        (vm, regs EXT); break;
+    case OP_SUB_FF:        op_sub_ff        (vm, regs EXT); break;
+    case OP_MUL_II:        op_mul_ii        (vm, regs EXT); break;
+    case OP_MUL_FF:        op_mul_ff        (vm, regs EXT); break;
+    case OP_ADDI_I:        op_addi_i        (vm, regs EXT); break;
+    case OP_SUBI_I:        op_subi_i        (vm, regs EXT); break;
+    case OP_EQ_II:         op_eq_ii         (vm, regs EXT); break;
+    case OP_LT_II:         op_lt_ii         (vm, regs EXT); break;
+    case OP_LT_FF:         op_lt_ff         (vm, regs EXT); break;
+    case OP_LE_II:         op_le_ii         (vm, regs EXT); break;
+    case OP_LE_FF:         op_le_ff         (vm, regs EXT); break;
+    case OP_GT_II:         op_gt_ii         (vm, regs EXT); break;
+    case OP_GT_FF:         op_gt_ff         (vm, regs EXT); break;
+    case OP_GE_II:         op_ge_ii         (vm, regs EXT); break;
+    case OP_GE_FF:         op_ge_ff         (vm, regs EXT); break;
+#endif
     default:		op_unsupported(vm, regs EXT); break;
     } // end switch.
+#endif
 
 #undef EXT
 #if defined(MRBC_SUPPORT_OP_EXT)
@@ -3310,16 +5043,11 @@ int mrbc_vm_run( mrbc_vm *vm )
     const mrbc_irep_catch_handler *handler;
 
     while( 1 ) {
+      // (frames without catch handlers are skipped quickly)
       const mrbc_irep *irep = vm->cur_irep;
-      const mrbc_irep_catch_handler *catch_table =
-        (const mrbc_irep_catch_handler *)(irep->inst + irep->ilen);
-      uint32_t inst = vm->inst - irep->inst;
-      int cnt = irep->clen;
-
-      for( cnt--; cnt >= 0 ; cnt-- ) {
-        handler = catch_table + cnt;
-        if( (bin_to_uint32(handler->begin) < inst) &&
-            (inst <= bin_to_uint32(handler->end)) ) goto JUMP_TO_HANDLER;
+      if( irep->clen != 0 ) {
+        handler = find_catch_handler( irep, vm->inst - irep->inst, 0 );
+        if( handler ) goto JUMP_TO_HANDLER;
       }
 
       if( !vm->callinfo_tail ) return 2;	// return due to exception.
@@ -3328,6 +5056,6 @@ int mrbc_vm_run( mrbc_vm *vm )
 
   JUMP_TO_HANDLER:
     // jump to handler (rescue or ensure).
-    vm->inst = vm->cur_irep->inst + bin_to_uint32(handler->target);
+    vm->inst = vm->cur_irep->inst + handler->target;
   }
 }
@@ -52,9 +52,12 @@ typedef struct IREP {
   uint16_t nregs;		//!< num of register variables
   uint16_t rlen;		//!< num of child IREP blocks
   uint16_t clen;		//!< num of catch handlers
-  uint16_t ilen;		//!< num of bytes in OpCode
-#if defined(MRBC_DEBUG)
+  uint16_t crlen;		//!< num of catch ranges
+  uint32_t ilen;		//!< num of bytes in OpCode
+#if defined(MRBC_DEBUG) || MRBC_USE_PREDECODE
   uint16_t plen;		//!< num of pools
+#endif
+#if defined(MRBC_DEBUG)
   uint16_t slen;		//!< num of symbols
 #endif
   uint16_t ofs_pools;		//!< offset of data->tbl_pools.
@@ -92,6 +95,14 @@ typedef struct IREP mrb_irep;
   ( (irep)->pool + mrbc_irep_tbl_pools(irep)[(n)] )
 
 
+#if MRBC_USE_PREDECODE
+//! get a numeric literal table, that is placed before the instructions.
+//! (MRBC_TT_EMPTY if not resolved)
+#define mrbc_irep_pool_values(irep) \
+  ( (const mrbc_value *)(irep)->inst - (irep)->plen )
+#endif
+
+
 //! get a child irep table pointer.
 #define mrbc_irep_tbl_ireps(irep) \
   ( (mrbc_irep **)((irep)->data + (irep)->ofs_ireps) )
@@ -100,20 +111,58 @@ typedef struct IREP mrb_irep;
 #define mrbc_irep_child_irep(irep, n) \
   ( mrbc_irep_tbl_ireps(irep)[(n)] )
 
+//! get a catch handler table pointer. (placed after tbl_ireps)
+#define mrbc_irep_catch_handlers(irep) \
+  ( (mrbc_irep_catch_handler *)(mrbc_irep_tbl_ireps(irep) + (irep)->rlen) )
+
+//! get a catch range table pointer. (placed after catch handlers)
+#define mrbc_irep_catch_ranges(irep) \
+  ( (mrbc_irep_catch_range *)(mrbc_irep_catch_handlers(irep) + (irep)->clen) )
+
 
 
 //================================================================
 /*!@brief
   IREP Catch Handler
+
+  Decoded from RITE binary into native format by the loader.
 */
 typedef struct IREP_CATCH_HANDLER {
-  uint8_t type;		//!< enum mrb_catch_type, 1 byte. 0=rescue, 1=ensure
-  uint8_t begin[4];	//!< The starting address to match the handler. Includes this.
-  uint8_t end[4];	//!< The endpoint address that matches the handler. Not Includes this.
-  uint8_t target[4];	//!< The address to jump to if a match is made.
+  uint32_t begin;	//!< The starting address to match the handler. Includes this.
+  uint32_t end;		//!< The endpoint address that matches the handler. Not Includes this.
+  uint32_t target;	//!< The address to jump to if a match is made.
+  uint8_t type;		//!< enum mrb_catch_type. 0=rescue, 1=ensure
 } mrbc_irep_catch_handler;
 
 
+//================================================================
+/*!@brief
+  IREP Catch Range
+
+  The instruction addresses are split into ranges at the begin and end
+  of each catch handler, and sorted by address for binary search.
+  A range covers from begin (not includes) to the begin of next range.
+*/
+typedef struct IREP_CATCH_RANGE {
+  uint32_t begin;	//!< The starting address of the range.
+  int16_t handler;	//!< index of the innermost catch handler, or -1.
+  int16_t ensure;	//!< index of the innermost ensure handler, or -1.
+} mrbc_irep_catch_range;
+
+
+//================================================================
+/*!@brief
+  C function that is resumed when the block called by mrbc_yield()
+  (or the method called by mrbc_call_method()) returns.
+
+  @param  vm	pointer to VM.
+  @param  v	registers of the C function. (v[0] = self)
+  @param  ret	return value of the block.
+  @return	num of arguments to call the block again, or -1 to finish.
+*/
+typedef int (*mrbc_resume_func)(struct VM *vm, mrbc_value v[], mrbc_value *ret);
+
+
 //================================================================
 /*!@brief
   Call information
@@ -131,13 +180,27 @@ typedef struct CALLINFO {
 
   struct RClass *own_class;	//!< class that owns method.
   struct RHash *karg_keep;	//!< keyword argument backup for OP_ARGARY.
+  mrbc_resume_func resume;	//!< C function to resume. (see mrbc_yield)
   mrbc_sym method_id;		//!< called method ID.
   uint8_t reg_offset;		//!< register offset after call.
   uint8_t n_args;		//!< num of arguments.
   uint8_t is_called_super;	//!< flags when called by OP_SUPER.
   uint8_t is_called_block;	//!< flags when block calls.
+  uint8_t n_resume_regs;	//!< num of registers of the C function to resume.
+  uint8_t n_yield_args;		//!< num of arguments given by mrbc_yield.
 
 } mrbc_callinfo;
+
+
+//================================================================
+/*!@brief
+  Chunk of callinfo stack.
+*/
+typedef struct CALLINFO_CHUNK {
+  struct CALLINFO_CHUNK *prev;	//!< lower chunk.
+  struct CALLINFO_CHUNK *next;	//!< upper chunk, or NULL.
+  mrbc_callinfo callinfo[MRBC_CALLINFO_CHUNK_SIZE];
+} mrbc_callinfo_chunk;
 //@cond
 typedef struct CALLINFO mrb_callinfo;
 //@endcond
@@ -164,12 +227,22 @@ typedef struct VM {
   mrbc_value      *cur_regs;		//!< Current register top.
   struct RClass   *target_class;	//!< Target class.
   mrbc_callinfo	  *callinfo_tail;	//!< Last point of CALLINFO link.
+  mrbc_callinfo_chunk *callinfo_chunk;	//!< Chunk that has callinfo_tail.
 
   struct RProc    *ret_blk;		//!< Return block.
   mrbc_value	  exception;		//!< Raised exception or nil.
   mrbc_sym        callee_sym_id;	//!< Current called method.
-  uint16_t        regs_size;		//!< size of regs[]
-  mrbc_value      regs[];
+  uint16_t        regs_size;		//!< size of regs[]. (it only grows)
+  uint16_t        regs_max_size;	//!< maximum size of regs[]
+  uint16_t        callinfo_depth;	//!< num of CALLINFO in use.
+  uint16_t        callinfo_max_depth;	//!< high-water mark of callinfo_depth.
+#if defined(MRBC_COUNT_INSTRUCTIONS)
+  uint64_t        inst_count;		//!< number of executed instructions.
+#endif
+#if MRBC_USE_PREDECODE
+  uint32_t        predecode_size;	//!< bytes of RAM used by pre-decoded ireps.
+#endif
+  mrbc_value      *regs;		//!< Register stack.
 
 } mrbc_vm;
 //@cond
@@ -183,9 +256,11 @@ typedef struct VM mrb_vm;
 void mrbc_cleanup_vm(void);
 mrbc_callinfo *mrbc_push_callinfo(mrbc_vm *vm, mrbc_sym method_id, int reg_offset, int n_args);
 void mrbc_pop_callinfo(mrbc_vm *vm);
+mrbc_value *mrbc_yield(mrbc_vm *vm, mrbc_value v[], int n_regs, const mrbc_value *blk, int argc, mrbc_value *args, mrbc_resume_func resume);
+mrbc_value *mrbc_call_method(mrbc_vm *vm, mrbc_value v[], int n_regs, mrbc_value *recv, const struct RMethod *method, int argc, mrbc_value *args, mrbc_resume_func resume);
 mrbc_vm *mrbc_vm_new(int regs_size);
 mrbc_vm *mrbc_vm_open(mrbc_vm *vm);
-void mrbc_vm_begin(mrbc_vm *vm);
+int mrbc_vm_begin(mrbc_vm *vm);
 void mrbc_vm_end(mrbc_vm *vm);
 void mrbc_vm_close(mrbc_vm *vm);
 int mrbc_vm_run(mrbc_vm *vm);
@@ -25,6 +25,24 @@
 #define MAX_REGS_SIZE 110
 #endif
 
+// initial size of registers. (grows up to MAX_REGS_SIZE as needed)
+#if !defined(MRBC_REGS_INIT_SIZE)
+#define MRBC_REGS_INIT_SIZE 24
+#endif
+
+// maximum depth of method calls (raise SystemStackError)
+// Each call frame uses some registers, so the depth is also limited by
+// MAX_REGS_SIZE (or regs_size of the task). With the default sizes, the
+// registers run out first at a depth of about 30 to 100.
+#if !defined(MAX_CALLINFO_DEPTH)
+#define MAX_CALLINFO_DEPTH 200
+#endif
+
+// number of callinfo (call frame) in a chunk of callinfo stack
+#if !defined(MRBC_CALLINFO_CHUNK_SIZE)
+#define MRBC_CALLINFO_CHUNK_SIZE 16
+#endif
+
 // maximum number of symbols
 #if !defined(MAX_SYMBOLS_COUNT)
 #define MAX_SYMBOLS_COUNT 255
@@ -65,14 +83,176 @@
 /* USE Unicode case mapping. Enable full BMP Unicode case conversion.
    Requires MRBC_USE_STRING_UTF8 to be enabled.
    When enabled, upcase/downcase work with Greek, Cyrillic, etc.
-   Adds ~5KB to binary size.
    0: NOT USE (ASCII-only case conversion - default)
-   1: USE full Unicode BMP case mapping
+   1: USE full Unicode BMP case mapping, with range tables.
+      Adds ~5KB to binary size.
+   2: USE full Unicode BMP case mapping, with a two-stage lookup table.
+      Faster than 1, and adds ~14KB to binary size.
 */
 #if !defined(MRBC_USE_UNICODE_CASE)
 #define MRBC_USE_UNICODE_CASE 0
 #endif
 
+/* UTF-8 character index. A String with multibyte characters remembers
+   its number of characters and the byte offset of every this number of
+   characters, at the first access by character index (e.g. [], size).
+   A String of one byte characters is indexed by bytes.
+   Requires MRBC_USE_STRING_UTF8.
+   Uses sizeof(MRBC_STRING_SIZE_T) bytes of RAM per entry.
+   (0 to disable the offsets)
+*/
+#if !defined(MRBC_STRING_CHAR_INDEX_INTERVAL)
+#define MRBC_STRING_CHAR_INDEX_INTERVAL 32
+#endif
+
+/* Inline string. A String of this length or less is stored in the same
+   memory block as the String object, and needs one allocation instead
+   of two. (0 to disable)
+*/
+#if !defined(MRBC_STRING_INLINE_SIZE)
+#define MRBC_STRING_INLINE_SIZE 15
+#endif
+
+/* USE shared string literals. A String made by OP_STRING points to the
+   literal in bytecode, and copies it at the first modification.
+   The bytecode must be kept while the strings are alive, even after
+   the VM ends, because they can escape to global variables, constants
+   and task queues. Enable it only when the bytecode is never released.
+   (e.g. it is in ROM)
+   0: NOT USE (copy the literal every time) (default)
+   1: USE shared string literals
+*/
+#if !defined(MRBC_USE_SHARED_STRING_LITERAL)
+#define MRBC_USE_SHARED_STRING_LITERAL 0
+#endif
+
+/* USE shared substrings. A substring longer than MRBC_STRING_INLINE_SIZE
+   (e.g. made by slice, split and strip) refers to the buffer of the
+   original string, and is copied at the first modification.
+   Uses a pointer of RAM per String object.
+   0: NOT USE (copy substrings)
+   1: USE shared substrings (default)
+*/
+#if !defined(MRBC_USE_SHARED_SUBSTRING)
+#define MRBC_USE_SHARED_SUBSTRING 1
+#endif
+
+/* USE threaded dispatch. Dispatch VM instructions through a table of
+   label addresses (computed goto) instead of a switch statement.
+   Requires GCC or Clang. Other compilers always use the switch.
+   0: NOT USE (switch dispatch - default)
+   1: USE threaded dispatch
+*/
+#if !defined(MRBC_USE_THREADED_DISPATCH)
+#define MRBC_USE_THREADED_DISPATCH 0
+#endif
+
+/* Inline method cache. Remember the method found at each method call
+   site (OP_SEND, OP_SSEND, OP_SENDB and their variants), and skip the
+   method lookup while the receiver's class stays the same.
+   The number of entries must be a power of 2. (0 to disable)
+   Uses 4 pointers + 8 bytes of RAM per entry.
+*/
+#if !defined(MRBC_INLINE_CACHE_SIZE)
+#define MRBC_INLINE_CACHE_SIZE 64
+#endif
+
+/* Global method cache. Remember the results of method lookup by
+   (class, method name), including "not found".
+   The number of entries must be a power of 2. (0 to disable)
+   Uses 3 pointers + 8 bytes of RAM per entry.
+*/
+#if !defined(MRBC_METHOD_CACHE_SIZE)
+#define MRBC_METHOD_CACHE_SIZE 64
+#endif
+
+/* Constant cache. Remember the constant found at each constant reference
+   site (OP_GETCONST, OP_GETMCNST), and skip the search of nested and
+   super classes while no constant is defined.
+   The number of entries must be a power of 2. (0 to disable)
+   Uses 3 pointers + 8 bytes of RAM per entry.
+*/
+#if !defined(MRBC_CONST_CACHE_SIZE)
+#define MRBC_CONST_CACHE_SIZE 32
+#endif
+
+/* Instance variable cache. Remember the slot index of the instance
+   variable at each OP_GETIV and OP_SETIV site, for the shape (layout of
+   instance variables) of self.
+   The number of entries must be a power of 2. (0 to disable)
+   Uses 2 pointers + 8 bytes of RAM per entry.
+*/
+#if !defined(MRBC_IVAR_CACHE_SIZE)
+#define MRBC_IVAR_CACHE_SIZE 64
+#endif
+
+/* Maximum number of shapes (layouts of instance variables). Shapes are
+   never released, so this limits the memory used by them. Beyond this,
+   the instances store their variables in a key-value table, which is
+   slower and not cached.
+   Uses 3 pointers + 4 bytes of RAM per shape.
+*/
+#if !defined(MRBC_MAX_SHAPES)
+#define MRBC_MAX_SHAPES 128
+#endif
+
+/* Hash index. A Hash with more keys than this number gets an open
+   addressing index over its key-value pairs, and the lookup by key does
+   not scan all keys. Smaller hashes are searched linearly.
+   Uses 2 bytes of RAM per slot, and the slots are at least twice as many
+   as the keys. (0 to disable)
+*/
+#if !defined(MRBC_HASH_INDEX_THRESHOLD)
+#define MRBC_HASH_INDEX_THRESHOLD 8
+#endif
+
+/* USE tail call. A method call that is immediately followed by the
+   return of its result reuses the current call frame and registers,
+   when the caller has no rescue/ensure and no blocks.
+   The caller is not shown in the backtrace of exceptions.
+   0: NOT USE (default)
+   1: USE tail call
+*/
+#if !defined(MRBC_USE_TAIL_CALL)
+#define MRBC_USE_TAIL_CALL 0
+#endif
+
+/* USE instruction fusion. The loader copies the instructions to RAM,
+   and rewrites common instruction pairs (e.g. OP_LT + OP_JMPIF) into
+   fused instructions that are executed with one dispatch.
+   Uses RAM as much as the size of bytecode. Disable it for the targets
+   that execute bytecode in ROM.
+   0: NOT USE (execute bytecode in place - default)
+   1: USE instruction fusion
+*/
+#if !defined(MRBC_USE_INST_FUSION)
+#define MRBC_USE_INST_FUSION 0
+#endif
+
+/* USE quickening. Arithmetic and comparison instructions that have seen
+   only Integer (or only Float) operands are rewritten at run time into
+   specialized instructions, and reverted when other types come.
+   Like MRBC_USE_INST_FUSION, the instructions are copied to RAM.
+   0: NOT USE (default)
+   1: USE quickening
+*/
+#if !defined(MRBC_USE_QUICKENING)
+#define MRBC_USE_QUICKENING 0
+#endif
+
+/* USE pre-decoded instructions. The loader translates the instructions
+   into a fixed size and aligned format, with resolved symbol operands
+   and jump offsets, and resolves the numeric literals in the pool.
+   Uses RAM about 3 times as much as the size of bytecode, plus 16 bytes
+   per literal. The amount is stored in vm->predecode_size.
+   Instruction fusion and quickening are applied to this format.
+   0: NOT USE (default)
+   1: USE pre-decoded instructions
+*/
+#if !defined(MRBC_USE_PREDECODE)
+#define MRBC_USE_PREDECODE 0
+#endif
+
 
 /* Hardware dependent flags
 
@@ -121,6 +301,13 @@
 
 // #define MRBC_NO_TIMER
 
+// Console output buffer size. The output is written when a newline is
+// written, the buffer is full, at the end of print methods, by flush,
+// or at the task switch. (0 to disable)
+#if !defined(MRBC_CONSOLE_BUFFER_SIZE)
+#define MRBC_CONSOLE_BUFFER_SIZE 128
+#endif
+
 // Console new-line mode.
 // If you need to convert LF to CRLF in console output, enable the following:
 // #define MRBC_CONVERT_CRLF
@@ -131,6 +318,9 @@
 // If you get exception with message "Not support op_ext..." when runtime.
 // #define MRBC_SUPPORT_OP_EXT
 
+// Count the executed VM instructions in vm->inst_count (for benchmarking).
+// #define MRBC_COUNT_INSTRUCTIONS
+
 // If you use LIBC malloc instead of mruby/c malloc
 // #define MRBC_ALLOC_LIBC
 
@@ -13,6 +13,13 @@
 #
 # Total size: ~2.5KB for full BMP (U+0000 to U+FFFF) support
 #
+# and a two-stage lookup table (MRBC_USE_UNICODE_CASE == 2):
+# - Index tables of the block number for each block of code points
+# - Blocks of the differences to the converted code points, shared by
+#   upcase and downcase
+#
+# Total size: ~12KB, and a character is converted by two table reads.
+#
 
 if ARGV.empty?
   puts "Usage: #{$0} <path/to/UnicodeData.txt> [output_path]"
@@ -113,6 +120,40 @@ end
 upper_data = build_compressed_tables(upper_map, "Upcase")
 lower_data = build_compressed_tables(lower_map, "Downcase")
 
+# Build two-stage lookup tables. The code points are divided into blocks
+# of (1 << shift), and the same blocks are shared. The block size that
+# makes the smallest tables is chosen.
+def build_two_stage_tables(mappings)
+  best = nil
+
+  (4..8).each do |shift|
+    size = 1 << shift
+    blocks = [[0] * size]       # block 0: no conversion.
+    block_ids = {}
+    block_ids[blocks[0]] = 0
+
+    indexes = mappings.map do |mapping|
+      (0x10000 >> shift).times.map do |n|
+        block = size.times.map do |i|
+          cp = (n << shift) + i
+          mapping[cp] ? (mapping[cp] - cp) & 0xFFFF : 0
+        end
+        block_ids[block] ||= (blocks << block; blocks.size - 1)
+      end
+    end
+    next if blocks.size > 256   # the block number must fit uint8_t
+
+    bytes = blocks.size * size * 2 + indexes.sum(&:size)
+    best = { shift: shift, blocks: blocks, indexes: indexes, bytes: bytes } if !best || bytes < best[:bytes]
+  end
+
+  puts "\nTwo-stage - block size: #{1 << best[:shift]}, blocks: #{best[:blocks].size}"
+  puts "  Estimated size: #{best[:bytes]} bytes"
+  best
+end
+
+two_stage = build_two_stage_tables([upper_map, lower_map])
+
 # Generate C code
 c_code = <<~C
 /*
@@ -122,12 +163,42 @@ c_code = <<~C
  * Compression strategy:
  * 1. Range table with XOR patterns (for contiguous mappings)
  * 2. Exception table for irregular mappings
+ * or (MRBC_USE_UNICODE_CASE == 2)
+ * 3. Two-stage lookup table of the differences
  *
  * To regenerate: ruby generate_case_tables.rb
  */
 
 #if MRBC_USE_STRING_UTF8 && MRBC_USE_UNICODE_CASE
+C
+
+# Generate two-stage lookup tables
+shift = two_stage[:shift]
+c_code += <<~C
+#if MRBC_USE_UNICODE_CASE == 2
+/* Two-stage lookup table: #{two_stage[:bytes]} bytes
+   converted = (cp + case_blocks[xxx_index[cp >> CASE_BLOCK_SHIFT]][cp & CASE_BLOCK_MASK]) & 0xFFFF
+*/
+#define CASE_BLOCK_SHIFT #{shift}
+#define CASE_BLOCK_MASK 0x#{'%02X' % ((1 << shift) - 1)}
+
+C
+c_code += "/* Blocks of differences: #{two_stage[:blocks].size} entries */\n"
+c_code += "static const uint16_t case_blocks[][#{1 << shift}] = {\n"
+two_stage[:blocks].each do |block|
+  c_code += "  {" + block.each_slice(8).map { |a| a.map { |d| "0x%04X" % d }.join(",") }.join(",\n   ") + "},\n"
+end
+c_code += "};\n\n"
+
+[["upcase", two_stage[:indexes][0]], ["downcase", two_stage[:indexes][1]]].each do |name, index|
+  c_code += "/* #{name.capitalize} index */\n"
+  c_code += "static const uint8_t #{name}_index[#{index.size}] = {\n"
+  index.each_slice(16) { |a| c_code += "  " + a.map { |n| "%3d" % n }.join(",") + ",\n" }
+  c_code += "};\n\n"
+end
 
+c_code += <<~C
+#else
 /* Range entry: XOR value, start codepoint, end codepoint (inclusive) */
 typedef struct {
   uint16_t xor_val;
@@ -178,7 +249,8 @@ c_code += "};\n\n"
 c_code += "#define UPCASE_RANGES_COUNT #{upper_data[:ranges].size}\n"
 c_code += "#define UPCASE_EXCEPTIONS_COUNT #{upper_data[:exceptions].size}\n"
 c_code += "#define DOWNCASE_RANGES_COUNT #{lower_data[:ranges].size}\n"
-c_code += "#define DOWNCASE_EXCEPTIONS_COUNT #{lower_data[:exceptions].size}\n\n"
+c_code += "#define DOWNCASE_EXCEPTIONS_COUNT #{lower_data[:exceptions].size}\n"
+c_code += "#endif /* MRBC_USE_UNICODE_CASE == 2 */\n\n"
 c_code += "#endif /* MRBC_USE_STRING_UTF8 && MRBC_USE_UNICODE_CASE */\n"
 
 File.write(output_path, c_code)
@@ -191,4 +263,5 @@ puts "\n" + "="*60
 puts "Total table size: #{total_bytes} bytes (#{(total_bytes / 1024.0).round(2)} KB)"
 puts "  Ranges: #{total_ranges} × 6 = #{total_ranges * 6} bytes"
 puts "  Exceptions: #{total_exceptions} × 4 = #{total_exceptions * 4} bytes"
+puts "Two-stage table size: #{two_stage[:bytes]} bytes (#{(two_stage[:bytes] / 1024.0).round(2)} KB)"
 puts "Written to #{output_path}"
@@ -25,6 +25,7 @@ require_relative "common_sub"
 
 APPEND_SYMBOL = [
   "+", "-", "*", "/", "==", "<", "<=", ">", ">=", "initialize", "PI", "E", "method_missing",
+  "capacity",
 ]
 
 
@@ -1,3 +1,19 @@
+class ArrayTestValue
+  attr_reader :n
+
+  def initialize(n)
+    @n = n
+  end
+
+  def +(other)
+    ArrayTestValue.new(@n + (other.is_a?(ArrayTestValue) ? other.n : other))
+  end
+
+  def *(other)
+    ArrayTestValue.new(@n * other.n)
+  end
+end
+
 
 class ArrayTest < Picotest::Test
 
@@ -14,6 +30,76 @@ class ArrayTest < Picotest::Test
     assert_equal [:"2000", :"31"], [:"31", :"2000"].sort
   end
 
+  description "sort with block, sort!"
+  def test_sort_block
+    a = [3, 1, 2]
+    assert_equal [3, 2, 1], a.sort { |x, y| y <=> x }
+    assert_equal [3, 1, 2], a
+    assert_equal [], [].sort { |x, y| y <=> x }
+
+    assert_equal [1, 2, 3], a.sort!
+    assert_equal [1, 2, 3], a
+    a.sort! { |x, y| y <=> x }
+    assert_equal [3, 2, 1], a
+
+    # merge sort is stable.
+    a = [[1, :a], [0, :b], [1, :c], [0, :d], [1, :e]]
+    assert_equal [[0, :b], [0, :d], [1, :a], [1, :c], [1, :e]],
+                 a.sort { |x, y| x[0] <=> y[0] }
+
+    a = []
+    50.times { |i| a << (i * 7) % 50 }
+    b = []
+    50.times { |i| b << i }
+    assert_equal b, a.sort
+    assert_equal b, a.sort { |x, y| x <=> y }
+  end
+
+  description "break and raise in the block of sort"
+  def test_sort_block_break_raise
+    a = [3, 1, 2]
+    assert_equal :stop, a.sort { |x, y| break :stop }
+    assert_raise(RuntimeError) { a.sort { |x, y| raise "error" } }
+    assert_equal [3, 1, 2], a
+  end
+
+  description "sort_by, min_by, max_by"
+  def test_sort_by
+    a = %w(pear fig banana)
+    assert_equal %w(fig pear banana), a.sort_by { |s| s.size }
+    assert_equal "fig", a.min_by { |s| s.size }
+    assert_equal "banana", a.max_by { |s| s.size }
+    assert_equal [], [].sort_by { |s| s }
+    assert_nil [].min_by { |s| s }
+    assert_nil [].max_by { |s| s }
+
+    # the first one of the same values.
+    assert_equal 2, [2, -2, 1].max_by { |x| x * x }
+    assert_equal 1, [2, 1, -1].min_by { |x| x * x }
+
+    # (NotImplementedError is not a StandardError.)
+    e = nil
+    begin
+      a.sort_by
+    rescue NotImplementedError => e
+    end
+    assert_equal NotImplementedError, e.class
+  end
+
+  description "bsearch"
+  def test_bsearch
+    a = [0, 4, 7, 10, 12]
+    # find-minimum mode.
+    assert_equal 4, a.bsearch { |x| x >= 4 }
+    assert_equal 7, a.bsearch { |x| x >= 6 }
+    assert_equal 0, a.bsearch { |x| x >= -1 }
+    assert_nil a.bsearch { |x| x >= 100 }
+    # find-any mode.
+    assert_equal 7, a.bsearch { |x| 7 <=> x }
+    assert_nil a.bsearch { |x| 5 <=> x }
+    assert_nil [].bsearch { |x| true }
+  end
+
   description "operator +"
   def test_operator
     assert_equal [1,2,3,4], [1,2] + [3,4]
@@ -395,6 +481,64 @@ class ArrayTest < Picotest::Test
     assert_equal( false, [nil,false,true].none? )
   end
 
+  description "reject, delete_if, reject!"
+  def test_reject
+    a = [1, 2, 3, 4]
+    assert_equal [1, 3], a.reject {|v| v % 2 == 0 }
+    assert_equal [1, 2, 3, 4], a
+
+    assert_equal [1, 3], a.delete_if {|v| v % 2 == 0 }
+    assert_equal [1, 3], a
+    assert_equal nil, a.reject! {|v| v > 5 }
+    assert_equal [3], a.reject! {|v| v == 1 }
+    assert_equal [3], a
+  end
+
+  description "flat_map, index, find, count"
+  def test_find
+    a = [3, 5, 8, 5]
+    assert_equal [3, 3, 5, 5, 8, 8, 5, 5], a.flat_map {|v| [v, v] }
+    assert_equal [3, 5, 8, 5], a.flat_map {|v| v }
+    assert_equal 1, a.index(5)
+    assert_equal 2, a.index {|v| v > 5 }
+    assert_equal 2, a.find_index {|v| v % 2 == 0 }
+    assert_equal nil, a.index {|v| v > 10 }
+    assert_equal 8, a.find {|v| v > 5 }
+    assert_equal nil, a.detect {|v| v > 10 }
+    assert_equal 4, a.count
+    assert_equal 2, a.count(5)
+    assert_equal 3, a.count {|v| v % 2 == 1 }
+  end
+
+  description "each_slice, each_cons, zip"
+  def test_each_slice
+    r = []
+    [1, 2, 3, 4, 5].each_slice(2) {|s| r << s }
+    assert_equal [[1, 2], [3, 4], [5]], r
+
+    r = []
+    [1, 2, 3, 4].each_cons(3) {|s| r << s }
+    assert_equal [[1, 2, 3], [2, 3, 4]], r
+
+    r = []
+    [1, 2].each_cons(3) {|s| r << s }
+    assert_equal [], r
+
+    assert_equal [[1, :a], [2, :b], [3, nil]], [1, 2, 3].zip([:a, :b])
+    assert_equal [[1, 4, 7], [2, 5, 8]], [1, 2].zip([4, 5], [7, 8, 9])
+  end
+
+  description "break and raise in the block of the iterator methods"
+  def test_iterator_break_raise
+    a = [1, 2, 3]
+    assert_equal :b, a.map {|v| break :b if v == 2; v }
+    assert_equal :b, a.select {|v| break :b }
+    assert_equal :b, a.inject {|s, v| break :b }
+    assert_raise(RuntimeError) { a.each_with_index {|v, i| raise "error" if i == 1 } }
+    assert_raise(RuntimeError) { a.map! {|v| raise "error" } }
+    assert_equal [1, 2, 3], a
+  end
+
   description "reverse test"
   def test_reverse
     assert_equal [3,2,1], [1,2,3].reverse
@@ -531,4 +675,75 @@ class ArrayTest < Picotest::Test
     # Symbol as range end should raise TypeError
     assert_raise(TypeError) { a[1..:end] }
   end
+
+  description "Nested inspect and join inside method frames"
+  def nested_array(n)
+    a = [1]
+    n.times { a = [a] }
+    a
+  end
+
+  def inspect_in_frames(depth, a)
+    return a.inspect if depth == 0
+    inspect_in_frames(depth - 1, a)
+  end
+
+  def join_in_frames(depth, a)
+    return a.join(",") if depth == 0
+    join_in_frames(depth - 1, a)
+  end
+
+  def test_nested_inspect_join_in_frames
+    a = nested_array(3)
+    assert_equal "[[[[1]]]]", inspect_in_frames(3, a)
+    assert_equal "1,2,3", join_in_frames(3, [[1, [2]], a.inspect.size - 6])
+
+    # deeper nesting runs out of registers, and raises SystemStackError.
+    # (SystemStackError is not a StandardError.)
+    [16, 200].each do |n|
+      a = nested_array(n)
+      ret = e = nil
+      begin
+        ret = inspect_in_frames(3, a)
+      rescue SystemStackError => e
+      end
+      assert_true ret == "[" * (n+1) + "1" + "]" * (n+1) || e.class == SystemStackError
+      assert_equal "1", join_in_frames(3, a)
+    end
+  end
+
+  description "inject and sum"
+  def test_inject_sum
+    assert_equal 6, [1, 2, 3].inject(:+)
+    assert_equal 16, [1, 2, 3].inject(10, :+)
+    assert_equal 6, [1, 2, 3].inject { |s, x| s * x }
+    assert_nil [].inject(:+)
+    assert_equal 6, [1, 2, 3].sum
+    assert_equal 3.5, [1.5, 2].sum
+    assert_equal 12, [1, 2, 3].sum { |x| x * 2 }
+    assert_equal 6, [[1, 2], [3]].sum { |a| a.sum }
+    assert_equal "abc", ["b", "c"].sum("a")
+    assert_raise(TypeError) { [1].inject(1, 2) }
+  end
+
+  description "inject and sum with the operator written in Ruby"
+  def sum_and_return(a)
+    a.sum(ArrayTestValue.new(0)) { |x| return x.n }
+  end
+
+  def test_inject_sum_with_ruby_operator
+    a = [ArrayTestValue.new(1), ArrayTestValue.new(2), ArrayTestValue.new(3)]
+
+    assert_equal 6, a.inject(:+).n
+    assert_equal 16, a.inject(ArrayTestValue.new(10), :+).n
+    assert_equal 6, a.inject(:*).n
+    assert_equal 6, a.sum(ArrayTestValue.new(0)).n
+    assert_equal 112, a.sum(ArrayTestValue.new(100)) { |x| ArrayTestValue.new(x.n * 2) }.n
+    assert_equal 11, [1, 2, 3].sum(ArrayTestValue.new(5)).n
+
+    assert_raise(NoMethodError) { a.inject(:-) }
+    assert_raise(RuntimeError) { a.sum(ArrayTestValue.new(0)) { |x| raise "error" } }
+    assert_equal 6, [1].each { |x| break a.sum(ArrayTestValue.new(0)).n }
+    assert_equal 1, sum_and_return(a)
+  end
 end
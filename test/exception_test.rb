@@ -78,4 +78,38 @@ class ExceptionTest < Picotest::Test
     end
   end
 
+  description "deep recursion raises SystemStackError"
+  def recurse(n)
+    recurse(n + 1) + 1		# (not a tail call)
+  end
+
+  def recurse_in_block(n)
+    1.times { recurse_in_block(n + 1) }
+  end
+
+  def test_system_stack_error
+    # (SystemStackError is not a StandardError.)
+    e = nil
+    begin
+      recurse(0)
+    rescue SystemStackError => e
+    end
+    assert_equal(SystemStackError, e.class)
+
+    e = nil
+    begin
+      recurse_in_block(0)
+    rescue SystemStackError => e
+    end
+    assert_equal(SystemStackError, e.class)
+
+    # the stack is usable after that.
+    e = nil
+    begin
+      recurse(0)
+    rescue SystemStackError => e
+    end
+    assert_equal(SystemStackError, e.class)
+  end
+
 end
@@ -229,4 +229,99 @@ class HashTest < Picotest::Test
     assert_raise(ArgumentError) { h.deconstruct_keys(nil, nil) }
   end
 
+  description "Hash over MRBC_HASH_INDEX_THRESHOLD keys (indexed)"
+  def test_indexed_hash
+    h = {}
+    30.times {|i| h[i] = i * 10 }
+    assert_equal 30, h.size
+    assert_equal 0, h[0]
+    assert_equal 150, h[15]
+    assert_equal 290, h[29]
+    assert_equal nil, h[30]
+    assert_equal 70, h[7.0]		# 7 and 7.0 are the same key.
+    assert_equal 0, h.keys[0]
+    assert_equal 29, h.keys[29]
+
+    # keys of the mixed types.
+    h = {}
+    12.times {|i| h["s#{i}"] = i; h["y#{i}".to_sym] = -i }
+    assert_equal 24, h.size
+    assert_equal 11, h["s11"]
+    assert_equal(-11, h[:y11])
+    assert_equal nil, h["y11"]
+
+    # overwrite keeps the order and the size.
+    h["s3"] = :x
+    assert_equal :x, h["s3"]
+    assert_equal 24, h.size
+    assert_equal "s0", h.keys[0]
+  end
+
+  description "delete across MRBC_HASH_INDEX_THRESHOLD"
+  def test_indexed_hash_delete
+    h = {}
+    20.times {|i| h[i] = i }
+
+    # delete the keys until under the threshold.
+    20.times {|i|
+      next if i % 3 == 0
+      assert_equal i, h.delete(i)
+    }
+    assert_equal 7, h.size
+    assert_equal [0, 3, 6, 9, 12, 15, 18], h.keys
+    assert_equal nil, h[1]
+    assert_equal 18, h[18]
+    assert_equal nil, h.delete(1)
+
+    # and over the threshold again.
+    20.times {|i| h[i] = -i }
+    assert_equal 20, h.size
+    assert_equal(-1, h[1])
+    assert_equal(-18, h[18])
+    assert_equal [0, 3, 6, 9, 12, 15, 18, 1, 2, 4], h.keys[0, 10]
+  end
+
+  description "modifying the String after it is used as a key"
+  def test_string_key_modified
+    [4, 20].each do |n|		# under and over the threshold.
+      keys = []
+      h = {}
+      n.times {|i| keys << "k#{i}"; h[keys[i]] = i }
+
+      k = keys[3]
+      k << "z"
+      assert_equal "k3z", k
+      assert_equal 3, h["k3"]
+      assert_equal nil, h["k3z"]
+      assert_equal "k3", h.keys[3]
+
+      # replacing the value keeps the key.
+      h["k2"] = :x
+      assert_equal :x, h["k2"]
+      assert_equal n, h.size
+    end
+
+    # hash literal.
+    k = "a"
+    h = {k => 1, "b" => 2, "c" => 3, "d" => 4, "e" => 5,
+         "f" => 6, "g" => 7, "h" => 8, "i" => 9, "j" => 10}
+    k << "z"
+    assert_equal 1, h["a"]
+    assert_equal nil, h["az"]
+  end
+
+  description "clear an indexed Hash"
+  def test_indexed_hash_clear
+    h = {}
+    16.times {|i| h["k#{i}"] = i }
+    h.clear
+    assert_equal 0, h.size
+    assert_equal nil, h["k1"]
+
+    16.times {|i| h["k#{i}"] = i * 2 }
+    assert_equal 16, h.size
+    assert_equal 2, h["k1"]
+    assert_equal 30, h["k15"]
+  end
+
 end
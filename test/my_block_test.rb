@@ -20,6 +20,26 @@ class MyBlock
   def result
     @result
   end
+
+  def return_in_times
+    10.times { |i| return i if i == 3 }
+    :not_reached
+  end
+
+  def return_in_upto
+    1.upto(10) { |i| return i if i == 4 }
+    :not_reached
+  end
+
+  def return_in_each(array)
+    array.each { |v| return v if v > 1 }
+    :not_reached
+  end
+
+  def return_in_each_char(str)
+    str.each_char { |c| return c if c == "c" }
+    :not_reached
+  end
 end
 
 class MyBlockTest < Picotest::Test
@@ -40,6 +60,58 @@ class MyBlockTest < Picotest::Test
     @obj.each_double([1, 2, 3])
     assert_equal [2, 4, 6], @obj.result
   end
+
+  description "break in the block of iterators"
+  def test_break
+    assert_equal 3, 10.times { |i| break i if i == 3 }
+    assert_equal 4, 1.upto(10) { |i| break i if i == 4 }
+    assert_equal 7, 10.downto(1) { |i| break i if i == 7 }
+    assert_equal 2, (1..5).each { |i| break i if i == 2 }
+    assert_equal 20, [10, 20, 30].each { |v| break v if v > 10 }
+    assert_equal :b, {a: 1, b: 2}.each { |k, v| break k if v == 2 }
+    assert_equal "c", "abcd".each_char { |c| break c if c == "c" }
+
+    # returns the receiver, if not broken.
+    assert_equal 3, 3.times { |i| }
+    assert_equal [1, 2], [1, 2].each { |v| }
+    assert_equal "ab", "ab".each_char { |c| }
+  end
+
+  description "next in the block of iterators"
+  def test_next
+    a = []
+    5.times { |i| next if i % 2 == 1; a << i }
+    1.upto(3) { |i| next if i == 2; a << i }
+    [7, 8, 9].each { |v| next if v == 8; a << v }
+    "xyz".each_char { |c| next if c == "y"; a << c }
+    assert_equal [0, 2, 4, 1, 3, 7, 9, "x", "z"], a
+  end
+
+  description "return from the method in the block of iterators"
+  def test_return
+    assert_equal 3, @obj.return_in_times
+    assert_equal 4, @obj.return_in_upto
+    assert_equal 2, @obj.return_in_each([1, 2, 3])
+    assert_equal "c", @obj.return_in_each_char("abcd")
+  end
+
+  description "raise in the block of iterators"
+  def test_raise
+    assert_raise(RuntimeError) { 3.times { |i| raise "error" if i == 1 } }
+    assert_raise(RuntimeError) { 1.upto(3) { |i| raise "error" } }
+    assert_raise(RuntimeError) { [1, 2].each { |v| raise "error" } }
+    assert_raise(RuntimeError) { "ab".each_char { |c| raise "error" } }
+
+    # the iterator can be used again after the exception.
+    n = 0
+    begin
+      2.times { |i| 2.times { |j| raise "error" if j == 1 } }
+    rescue => e
+      n += 1
+    end
+    3.times { |i| n += i }
+    assert_equal 4, n
+  end
 end
 
 
@@ -8,6 +8,45 @@ class MyInstanceVariable
   end
 end
 
+class MyManyLayouts
+  def set(k, v)
+    case k
+    when 0 then @v0 = v
+    when 1 then @v1 = v
+    when 2 then @v2 = v
+    when 3 then @v3 = v
+    when 4 then @v4 = v
+    when 5 then @v5 = v
+    when 6 then @v6 = v
+    when 7 then @v7 = v
+    end
+  end
+
+  def get(k)
+    [@v0, @v1, @v2, @v3, @v4, @v5, @v6, @v7][k]
+  end
+end
+
+class MyKvInstance
+  def set_x(v)
+    @kv_only_x = v
+  end
+
+  # many sites that read the variable. (they cover all the cache entries)
+  def get_all
+    [@kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x,
+     @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x, @kv_only_x]
+  end
+end
+
 class MyInstanceVariableTest < Picotest::Test
 
   description 'instance variable'
@@ -35,4 +74,47 @@ class MyInstanceVariableTest < Picotest::Test
     assert_equal [111,222,333,444], [obj1.r1, obj1.r2, obj1.rw1, obj1.rw2]
     assert_equal [nil,nil,2211,2222], [obj2.r1, obj2.r2, obj2.rw1, obj2.rw2]
   end
+
+  description 'instance variables read through other sites after running out of shapes'
+  def test_kv_instance_other_sites
+    # run out of shapes.
+    [1, 3, 5, 7].each do |m|
+      8.times do |c|
+        obj = MyManyLayouts.new
+        8.times {|i| obj.set((i * m + c) % 8, i) }
+      end
+    end
+
+    obj = MyKvInstance.new
+    10.times do |i|
+      obj.set_x(i)
+      assert_equal 70, obj.get_all.count(i)
+    end
+  end
+
+  description 'instance variables set in many different orders'
+  def test_many_layouts
+    # (makes more layouts than MRBC_MAX_SHAPES)
+    objs = []
+    [1, 3, 5, 7].each do |m|
+      8.times do |c|
+        obj = MyManyLayouts.new
+        8.times do |i|
+          k = (i * m + c) % 8
+          obj.set(k, k * 10 + m)
+        end
+        obj.set(c, c)		# replace a value.
+        objs << obj
+        objs << obj.dup
+      end
+    end
+
+    objs.each_with_index do |obj, n|
+      m = [1, 3, 5, 7][n / 16]
+      c = n / 2 % 8
+      8.times do |k|
+        assert_equal (k == c ? c : k * 10 + m), obj.get(k)
+      end
+    end
+  end
 end
@@ -14,6 +14,28 @@ class StringTest < Picotest::Test
     assert_equal "", str
   end
 
+  description "String.new with capacity:"
+  def test_string_new_with_capacity
+    str = String.new(capacity: 100)
+    assert_equal "", str
+    assert_equal 0, str.size
+    50.times { str << "ab" }
+    assert_equal 100, str.size
+    assert_equal "abab", str[0, 4]
+
+    str = String.new("abc", capacity: 2)
+    assert_equal "abc", str
+    str << "def"
+    assert_equal "abcdef", str
+
+    str = String.new("xyz", capacity: 64)
+    assert_equal "xyz", str
+    assert_equal "xyz!", str + "!"
+    assert_equal "xyz", str.dup
+
+    assert_raise(TypeError) { String.new(capacity: "10") }
+  end
+
   description "==, !="
   def test_op_eq
     assert_equal true, "abc" == "abc"
@@ -820,4 +842,121 @@ class StringTest < Picotest::Test
     assert_equal ["line1", "line2", "line3\rline4"], lines
   end
 
+  description "character index of a long string"
+  def chars_of(s)
+    a = []
+    s.each_char {|c| a << c }
+    a
+  end
+
+  # compare str[i] with each_char. (UTF-8 characters, or bytes)
+  def assert_char_index(s)
+    a = chars_of(s)
+    assert_equal a.size, s.size
+    ok = 0
+    a.size.times {|i| ok += 1 if s[i] == a[i] }
+    assert_equal a.size, ok
+    assert_equal a[-1], s[-1]
+    assert_equal a[20, 5].join, s[20, 5]
+  end
+
+  def test_char_index
+    # over MRBC_STRING_CHAR_INDEX_INTERVAL characters.
+    s = ""
+    100.times {|i| s << (i % 2 == 0 ? "あ" : "b") }
+    assert_char_index(s)
+    utf8 = ("あ".size == 1)
+    if utf8
+      assert_equal 100, s.size
+      assert_equal "あ", s[64]
+      assert_equal "b", s[65]
+    end
+
+    s[70] = "いい"
+    assert_char_index(s)
+    if utf8
+      assert_equal 101, s.size
+      assert_equal "いいb", s[70, 3]
+    end
+
+    s << "うえお"
+    assert_char_index(s)
+    if utf8
+      assert_equal 104, s.size
+      assert_equal "お", s[103]
+    end
+
+    t = s.slice!(10, 30)
+    assert_char_index(s)
+    assert_char_index(t)
+    if utf8
+      assert_equal 74, s.size
+      assert_equal 30, t.size
+      assert_equal "いい", s[40, 2]
+    end
+  end
+
+
+  description "substrings share the buffer of the original string"
+  # every substring is longer than 15 bytes.
+  def long_substring(s, i)
+    case i
+    when 0 then s[2, 20]
+    when 1 then s.byteslice(2, 20)
+    when 2 then s.split(",")[1]
+    when 3 then s.strip
+    when 4 then s.chomp
+    end
+  end
+
+  def modify_string(s, i)
+    case i
+    when 0 then s << "xyz"
+    when 1 then s[3] = "123"
+    when 2 then s.upcase!
+    when 3 then s.tr!("a-z", "*")
+    when 4 then s.slice!(0, 10)
+    end
+  end
+
+  def new_parent
+    " abcdefghijklmnopqrst,uvwxyzABCDEFGHIJKLMNOP \n"
+  end
+
+  def test_substring_modify_parent
+    5.times {|i|
+      5.times {|j|
+        parent = new_parent
+        child = long_substring(parent, i)
+        expected = child.dup
+        modify_string(parent, j)
+        assert_equal expected, child
+      }
+    }
+  end
+
+  def test_substring_modify_child
+    5.times {|i|
+      5.times {|j|
+        parent = new_parent
+        child = long_substring(parent, i)
+        modify_string(child, j)
+        assert_equal new_parent, parent
+      }
+    }
+  end
+
+  description "a substring is not NUL terminated"
+  def test_substring_not_terminated
+    parent = "                12345678"
+    s = parent[0, 20]
+    assert_equal 1234, s.to_i
+
+    parent = "abcdefghijklmnopqrstuvwxyz"
+    s = parent[0, 16]
+    assert_equal :abcdefghijklmnop, s.to_sym
+    assert_equal "abcdefghijklmnop|", sprintf("%s|", s)
+    assert_equal "abcdefghijklmnop    |", sprintf("%-20s|", s)
+  end
+
 end
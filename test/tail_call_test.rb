@@ -0,0 +1,62 @@
+class TailCallTest < Picotest::Test
+
+  def count_down(n, acc)
+    return acc if n == 0
+    count_down(n - 1, acc + 1)
+  end
+
+  def my_even?(n)
+    return true if n == 0
+    my_odd?(n - 1)
+  end
+
+  def my_odd?(n)
+    return false if n == 0
+    my_even?(n - 1)
+  end
+
+  def sum_to(n)
+    return 0 if n == 0
+    n + sum_to(n - 1)		# not a tail call.
+  end
+
+  description "self-recursive tail call"
+  def test_self_recursive
+    assert_equal 10, count_down(10, 0)
+
+    # MRBC_USE_TAIL_CALL=1 runs it in one frame, otherwise it overflows.
+    # (SystemStackError is not a StandardError.)
+    ret = e = nil
+    begin
+      ret = count_down(10000, 0)
+    rescue SystemStackError => e
+    end
+    assert_true ret == 10000 || e.class == SystemStackError
+  end
+
+  description "mutually recursive tail call"
+  def test_mutual_recursion
+    assert_equal true, my_even?(10)
+    assert_equal false, my_odd?(10)
+
+    ret = e = nil
+    begin
+      ret = [my_even?(10001), my_odd?(10001)]
+    rescue SystemStackError => e
+    end
+    assert_true ret == [false, true] || e.class == SystemStackError
+  end
+
+  description "not a tail call"
+  def test_not_tail_call
+    assert_equal 55, sum_to(10)
+
+    e = nil
+    begin
+      sum_to(10000)
+    rescue SystemStackError => e
+    end
+    assert_equal SystemStackError, e.class
+  end
+
+end